@@ -9,6 +9,7 @@
 #include <learnopengl/shader.h>
 
 #include <string>
+#include <utility>
 #include <vector>
 using namespace std;
 
@@ -37,54 +38,88 @@ struct Texture {
     string path;
 };
 
+// The texture unit of every model sampler (the Nth texture of a type feeds "<type>N").
+// Units are fixed, so a program points its samplers at them once (Mesh::BindSamplerUnits)
+// and drawing a mesh only binds textures. Unit 1 is left to the caller (shadow map).
+struct MaterialSampler {
+    const char *name;
+    const char *type;
+    unsigned int number;
+    unsigned int unit;
+};
+
+inline constexpr MaterialSampler MATERIAL_SAMPLERS[] = {
+    { "texture_diffuse1",  "texture_diffuse",  1, 0 },
+    { "texture_specular1", "texture_specular", 1, 2 },
+    { "texture_normal1",   "texture_normal",   1, 3 },
+    { "texture_height1",   "texture_height",   1, 4 },
+    { "texture_diffuse2",  "texture_diffuse",  2, 5 },
+    { "texture_specular2", "texture_specular", 2, 6 },
+    { "texture_normal2",   "texture_normal",   2, 7 },
+    { "texture_height2",   "texture_height",   2, 8 },
+};
+
+// one texture a mesh binds when drawn.
+struct TextureBinding {
+    unsigned int unit;
+    unsigned int id;
+};
+
 class Mesh {
 public:
     // mesh Data
     vector<Vertex>       vertices;
     vector<unsigned int> indices;
     vector<Texture>      textures;
-    unsigned int VAO;
-
-    // constructor
-    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures)
+    // textures resolved to their sampler units; built with the GL buffers.
+    vector<TextureBinding> material;
+    // local-space bounding box of the vertices, for culling.
+    glm::vec3 boundsMin = glm::vec3(0.0f);
+    glm::vec3 boundsMax = glm::vec3(0.0f);
+    unsigned int VAO = 0;
+
+    // constructor. Pass upload = false to build the mesh off the GL thread and call Upload() there later.
+    Mesh(vector<Vertex> vertices, vector<unsigned int> indices, vector<Texture> textures, bool upload = true)
     {
-        this->vertices = vertices;
-        this->indices = indices;
-        this->textures = textures;
+        this->vertices = std::move(vertices);
+        this->indices = std::move(indices);
+        this->textures = std::move(textures);
+        computeBounds();
 
         // now that we have all the required data, set the vertex buffers and its attribute pointers.
-        setupMesh();
+        if (upload)
+            setupMesh();
+    }
+
+    // creates the GL buffers of a mesh constructed with upload = false
+    void Upload()
+    {
+        if (VAO == 0)
+            setupMesh();
+    }
+
+    // points every model sampler the program declares at its fixed unit. Call once per
+    // program after linking; it leaves the program in use.
+    static void BindSamplerUnits(const Shader &shader)
+    {
+        glUseProgram(shader.ID);
+        for(const MaterialSampler &sampler : MATERIAL_SAMPLERS)
+        {
+            const GLint location = glGetUniformLocation(shader.ID, sampler.name);
+            if(location >= 0)
+                glUniform1i(location, static_cast<GLint>(sampler.unit));
+        }
     }
 
-    // render the mesh
-    void Draw(Shader &shader) 
+    // render the mesh. Samplers come from BindSamplerUnits, so this only binds textures.
+    void Draw(Shader &/*shader*/) const
     {
-        // bind appropriate textures
-        unsigned int diffuseNr  = 1;
-        unsigned int specularNr = 1;
-        unsigned int normalNr   = 1;
-        unsigned int heightNr   = 1;
-        for(unsigned int i = 0; i < textures.size(); i++)
+        for(const TextureBinding &binding : material)
         {
-            glActiveTexture(GL_TEXTURE0 + i); // active proper texture unit before binding
-            // retrieve texture number (the N in diffuse_textureN)
-            string number;
-            string name = textures[i].type;
-            if(name == "texture_diffuse")
-                number = std::to_string(diffuseNr++);
-            else if(name == "texture_specular")
-                number = std::to_string(specularNr++); // transfer unsigned int to string
-            else if(name == "texture_normal")
-                number = std::to_string(normalNr++); // transfer unsigned int to string
-             else if(name == "texture_height")
-                number = std::to_string(heightNr++); // transfer unsigned int to string
-
-            // now set the sampler to the correct texture unit
-            glUniform1i(glGetUniformLocation(shader.ID, (name + number).c_str()), i);
-            // and finally bind the texture
-            glBindTexture(GL_TEXTURE_2D, textures[i].id);
+            glActiveTexture(GL_TEXTURE0 + binding.unit);
+            glBindTexture(GL_TEXTURE_2D, binding.id);
         }
-        
+
         // draw mesh
         glBindVertexArray(VAO);
         glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
@@ -96,11 +131,46 @@ public:
 
 private:
     // render data 
-    unsigned int VBO, EBO;
+    unsigned int VBO = 0, EBO = 0;
+
+    void computeBounds()
+    {
+        if(vertices.empty())
+            return;
+        boundsMin = boundsMax = vertices[0].Position;
+        for(const Vertex &vertex : vertices)
+        {
+            boundsMin = glm::min(boundsMin, vertex.Position);
+            boundsMax = glm::max(boundsMax, vertex.Position);
+        }
+    }
+
+    // maps each texture to its sampler's unit; textures past the samplers in
+    // MATERIAL_SAMPLERS are not bound, as no shader here reads them.
+    void resolveMaterial()
+    {
+        material.clear();
+        for(size_t i = 0; i < textures.size(); i++)
+        {
+            unsigned int number = 1;
+            for(size_t j = 0; j < i; j++)
+            {
+                if(textures[j].type == textures[i].type)
+                    number++;
+            }
+            for(const MaterialSampler &sampler : MATERIAL_SAMPLERS)
+            {
+                if(number == sampler.number && textures[i].type == sampler.type)
+                    material.push_back({ sampler.unit, textures[i].id });
+            }
+        }
+    }
 
     // initializes all the buffer objects/arrays
     void setupMesh()
     {
+        resolveMaterial();
+
         // create buffers/arrays
         glGenVertexArrays(1, &VAO);
         glGenBuffers(1, &VBO);
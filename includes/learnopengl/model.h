@@ -15,14 +15,22 @@
 
 #include <string>
 #include <fstream>
+#include <functional>
 #include <sstream>
 #include <iostream>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 using namespace std;
 
 inline unsigned int TextureFromFile(const char *path, const string &directory, bool gamma = false);
 
+// GL texture name shared between models; whoever hands it out decides when it is deleted.
+using TextureRef = std::shared_ptr<const unsigned int>;
+// Resolves a material texture (directory-qualified path) to a possibly shared texture.
+using TextureProvider = std::function<TextureRef(const string &path, bool gamma)>;
+
 class Model 
 {
 public:
@@ -32,12 +40,59 @@ public:
     string directory;
     bool gammaCorrection;
 
-    // constructor, expects a filepath to a 3D model.
-    Model(string const &path, bool gamma = false) : gammaCorrection(gamma)
+    // constructor, expects a filepath to a 3D model. Without a texture provider every
+    // material texture is uploaded by this model alone. With uploadNow = false only the
+    // file is parsed (safe off the GL thread) and Upload() must be called before Draw.
+    Model(string const &path, bool gamma = false, TextureProvider textureProvider = nullptr, bool uploadNow = true)
+        : gammaCorrection(gamma), textureProvider(std::move(textureProvider)), uploaded(uploadNow)
     {
         loadModel(path);
     }
 
+    // adopts meshes built elsewhere (e.g. read from a baked file) whose textures carry only
+    // type and path; those are resolved like a parsed file's. Meshes must not be uploaded yet.
+    Model(string const &directory, vector<Mesh> meshes, bool gamma, TextureProvider textureProvider, bool uploadNow)
+        : meshes(std::move(meshes)), directory(directory), gammaCorrection(gamma), textureProvider(std::move(textureProvider)), uploaded(false)
+    {
+        for(const auto &mesh : this->meshes)
+        {
+            for(const auto &texture : mesh.textures)
+            {
+                if(textureIndex.emplace(texture.path, textures_loaded.size()).second)
+                    textures_loaded.push_back(texture);
+            }
+        }
+        if(uploadNow)
+            Upload();
+    }
+
+    // second half of a deferred load, on the GL thread: resolves material textures and creates mesh buffers.
+    void Upload()
+    {
+        if(uploaded)
+            return;
+        for(auto &texture : textures_loaded)
+            texture.id = resolveTexture(texture.path);
+        for(auto &mesh : meshes)
+        {
+            for(auto &texture : mesh.textures)
+                texture.id = textures_loaded[textureIndex[texture.path]].id;
+            mesh.Upload();
+        }
+        uploaded = true;
+    }
+
+    bool IsUploaded() const { return uploaded; }
+
+    // directory-qualified path of every material texture, so a loader can decode them ahead of Upload().
+    vector<string> GetTexturePaths() const
+    {
+        vector<string> paths;
+        for(const auto &texture : textures_loaded)
+            paths.push_back(this->directory + '/' + texture.path);
+        return paths;
+    }
+
     // draws the model, and thus all its meshes
     void Draw(Shader &shader)
     {
@@ -46,6 +101,13 @@ public:
     }
     
 private:
+    TextureProvider textureProvider;
+    // keeps provider textures alive while this model exists.
+    vector<TextureRef> textureRefs;
+    // textures_loaded index by material path.
+    unordered_map<string, size_t> textureIndex;
+    bool uploaded;
+
     // loads a model with supported ASSIMP extensions from file and stores the resulting meshes in the meshes vector.
     void loadModel(string const &path)
     {
@@ -165,7 +227,7 @@ private:
         textures.insert(textures.end(), heightMaps.begin(), heightMaps.end());
         
         // return a mesh object created from the extracted mesh data
-        return Mesh(vertices, indices, textures);
+        return Mesh(vertices, indices, textures, uploaded);
     }
 
     // checks all material textures of a given type and loads the textures if they're not loaded yet.
@@ -178,28 +240,37 @@ private:
             aiString str;
             mat->GetTexture(type, i, &str);
             // check if texture was loaded before and if so, continue to next iteration: skip loading a new texture
-            bool skip = false;
-            for(unsigned int j = 0; j < textures_loaded.size(); j++)
+            auto loaded = textureIndex.find(str.C_Str());
+            if(loaded != textureIndex.end())
             {
-                if(std::strcmp(textures_loaded[j].path.data(), str.C_Str()) == 0)
-                {
-                    textures.push_back(textures_loaded[j]);
-                    skip = true; // a texture with the same filepath has already been loaded, continue to next one. (optimization)
-                    break;
-                }
+                textures.push_back(textures_loaded[loaded->second]);
             }
-            if(!skip)
-            {   // if texture hasn't been loaded already, load it
+            else
+            {   // if texture hasn't been loaded already, load it (or borrow it from the provider)
                 Texture texture;
-                texture.id = TextureFromFile(str.C_Str(), this->directory);
+                texture.id = uploaded ? resolveTexture(str.C_Str()) : 0;
                 texture.type = typeName;
                 texture.path = str.C_Str();
                 textures.push_back(texture);
+                textureIndex.emplace(texture.path, textures_loaded.size());
                 textures_loaded.push_back(texture);  // store it as texture loaded for entire model, to ensure we won't unnecessary load duplicate textures.
             }
         }
         return textures;
     }
+
+    // uploads (or borrows from the provider) the texture at a material path.
+    unsigned int resolveTexture(const string &path)
+    {
+        if(textureProvider)
+        {
+            TextureRef shared = textureProvider(this->directory + '/' + path, gammaCorrection);
+            const unsigned int id = shared ? *shared : 0;
+            textureRefs.push_back(std::move(shared));
+            return id;
+        }
+        return TextureFromFile(path.c_str(), this->directory);
+    }
 };
 
 
@@ -0,0 +1,28 @@
+#ifndef SHADER_CACHE_H
+#define SHADER_CACHE_H
+
+#include <string>
+
+// Optional hook shared by every Shader variant: it can hand back an already linked
+// program for a set of sources (e.g. from driver binaries saved by an earlier run)
+// and is told about fresh links. geometryCode is empty for programs without one.
+class ShaderProgramCache
+{
+public:
+    virtual ~ShaderProgramCache() = default;
+    // linked program for these sources, or 0 to compile them.
+    virtual unsigned int Load(const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode) = 0;
+    // called on a new program before glLinkProgram, e.g. to request a retrievable binary.
+    virtual void PrepareLink(unsigned int program) = 0;
+    // called after a successful link.
+    virtual void Store(unsigned int program, const std::string &vertexCode, const std::string &fragmentCode, const std::string &geometryCode) = 0;
+
+    // the cache every Shader built from now on goes through; nullptr compiles from source.
+    static ShaderProgramCache *&Active()
+    {
+        static ShaderProgramCache *active = nullptr;
+        return active;
+    }
+};
+
+#endif
@@ -3,6 +3,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <learnopengl/filesystem.h>
 
+#include <iostream>
+
 namespace plane::app
 {
     Plane::Plane()
@@ -16,23 +18,21 @@ namespace plane::app
         InitializePartPositions();
     }
 
-    bool Plane::LoadModels()
+    void Plane::LoadModels(render::AssetCache& assets, render::AssetStreamer& streamer)
     {
-        bool ok = true;
         for (int i = 0; i < static_cast<int>(Part::Count); ++i)
         {
             const auto path = PartPath(static_cast<Part>(i));
-            try
-            {
-                models_[i] = std::make_unique<Model>(FileSystem::getPath(path));
-            }
-            catch (...)
+            assets.LoadModelAsync(streamer, FileSystem::getPath(path), render::StreamPriority::High, [this, i, path](std::shared_ptr<Model> model)
             {
-                ok = false;
-                models_[i].reset();
-            }
+                if (model->meshes.empty())
+                {
+                    std::cout << "Failed to load plane part " << path << std::endl;
+                    return;
+                }
+                models_[i] = std::move(model);
+            });
         }
-        return ok;
     }
 
     void Plane::InitializePartPositions()
@@ -55,8 +55,30 @@ namespace plane::app
 
         // Body stays at origin (0, 0, 0)
         SetPartTransform(Part::Body, glm::mat4(1.0f));
+
+        for (int i = 0; i < static_cast<int>(Part::Count); ++i)
+        {
+            restTransforms_[i] = partTransforms_[i];
+        }
     }
-    void Plane::Draw(Shader& shader, const glm::mat4& baseTransform)
+
+    void Plane::ApplyControlSurfaces(const core::PlaneState& planeState)
+    {
+        // Rebuilt from the rest pose every draw so the parts follow whatever state is being rendered.
+        const glm::vec3 xAxis(1.0f, 0.0f, 0.0f);
+        const glm::vec3 zAxis(0.0f, 0.0f, 1.0f);
+        auto pose = [this](Part part, const glm::vec3& axis, float radians)
+        {
+            const int idx = static_cast<int>(part);
+            partTransforms_[idx] = glm::rotate(restTransforms_[idx], radians, axis);
+        };
+
+        pose(Part::Tail, xAxis, planeState.tailAngle);
+        pose(Part::FlapR, xAxis, planeState.flapRAngle);
+        pose(Part::FlapL, xAxis, planeState.flapLAngle);
+        pose(Part::Blade, zAxis, planeState.bladeAngle);
+    }
+    void Plane::Submit(render::RenderQueue& queue, GLuint program, const render::Frustum& frustum, const glm::mat4& baseTransform, float depth) const
     {
         for (int i = 0; i < static_cast<int>(Part::Count); ++i)
         {
@@ -69,8 +91,20 @@ namespace plane::app
 
             // Apply pivot so rotations happen around the part's local origin.
             glm::mat4 model = baseTransform * pivotTranslate * partTransforms_[i] * pivotTranslateInv;
-            shader.setMat4("model", model);
-            models_[i]->Draw(shader);
+            for (const Mesh& mesh : models_[i]->meshes)
+            {
+                if (!frustum.IntersectsBox(render::Aabb { mesh.boundsMin, mesh.boundsMax }.Transformed(model)))
+                    continue;
+
+                render::DrawItem item;
+                item.program = program;
+                item.vao = mesh.VAO;
+                item.count = static_cast<GLsizei>(mesh.indices.size());
+                item.textures = mesh.material.data();
+                item.textureCount = static_cast<std::uint32_t>(mesh.material.size());
+                item.model = model;
+                queue.Submit(render::RenderPass::Opaque, item, depth);
+            }
         }
     }
 
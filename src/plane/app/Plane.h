@@ -7,6 +7,11 @@
 #include <learnopengl/model.h>
 #include <learnopengl/shader_m.h>
 
+#include "core/PlaneState.h"
+#include "render/AssetCache.h"
+#include "render/Frustum.h"
+#include "render/RenderQueue.h"
+
 namespace plane::app
 {
     // Composite plane made of multiple sub-models (body, blade, flaps, tail).
@@ -25,11 +30,18 @@ namespace plane::app
 
         Plane();
 
-        bool LoadModels();
+        // Streams the parts in through the shared cache, so every Plane after the first
+        // reuses them. Parts appear as they finish uploading; Submit skips missing ones.
+        void LoadModels(render::AssetCache& assets, render::AssetStreamer& streamer);
         void InitializePartPositions();  // Set initial positions based on model structure
 
-        // Draw all parts using a shared base transform; each part adds its own local transform.
-        void Draw(Shader& shader, const glm::mat4& baseTransform);
+        // Pose tail, flaps and propeller from the simulated control-surface angles.
+        void ApplyControlSurfaces(const core::PlaneState& planeState);
+
+        // Queue all parts using a shared base transform; each part adds its own local transform.
+        // Meshes whose transformed bounds miss the frustum are skipped. depth orders the
+        // whole plane in the queue.
+        void Submit(render::RenderQueue& queue, GLuint program, const render::Frustum& frustum, const glm::mat4& baseTransform, float depth) const;
 
         void SetPartTransform(Part part, const glm::mat4& transform);
         glm::mat4 GetPartTransform(Part part) const;
@@ -44,8 +56,9 @@ namespace plane::app
     private:
         std::string PartPath(Part part) const;
 
-        std::unique_ptr<Model> models_[static_cast<int>(Part::Count)];
+        std::shared_ptr<Model> models_[static_cast<int>(Part::Count)];
         glm::mat4 partTransforms_[static_cast<int>(Part::Count)];
+        glm::mat4 restTransforms_[static_cast<int>(Part::Count)];
         glm::vec3 partPivots_[static_cast<int>(Part::Count)];
     };
 }
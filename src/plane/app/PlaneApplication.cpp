@@ -1,4 +1,6 @@
 #include "PlaneApplication.h"
+#include "core/Profiler.h"
+#include "render/TextureLoader.h"
 
 #include <glad/glad.h>
 
@@ -66,21 +68,27 @@ namespace plane::app
 
     void PlaneApplication::Run()
     {
+        timingState_.deltaTime = 1.0f / core::AppConfig::SimulationHz;
+        core::Profiler::SetThreadName("Main");
 
         while (!glfwWindowShouldClose(window_))
         {
-            float currentFrame = static_cast<float>(glfwGetTime());
-            timingState_.deltaTime = currentFrame - timingState_.lastFrame;
-            timingState_.lastFrame = currentFrame;
+            PLANE_PROFILE_SCOPE("Frame");
+            StreamAssets();
+            ApplyTerrainEdits();
+
+            if (glfwGetKey(window_, GLFW_KEY_ESCAPE) == GLFW_PRESS)
+                glfwSetWindowShouldClose(window_, true);
 
             // Handle input based on game state
             if (gameState_ == core::GameState::StartMenu)
             {
-                // Check for spacebar press to start game
+                // Check for spacebar press to start game (once everything has streamed in)
                 int spaceState = glfwGetKey(window_, GLFW_KEY_SPACE);
-                if (spaceState == GLFW_PRESS && !spacePressed_)
+                if (spaceState == GLFW_PRESS && !spacePressed_ && assetsReady_)
                 {
                     gameState_ = core::GameState::Playing;
+                    simulationThread_.Resume();
                     spacePressed_ = true;
                 }
                 else if (spaceState == GLFW_RELEASE)
@@ -108,88 +116,127 @@ namespace plane::app
                 }
             }
 
+            // Dump the profiler ring buffers on the rising edge of F9.
+            int dumpState = glfwGetKey(window_, GLFW_KEY_F9);
+            if (dumpState == GLFW_PRESS && !profileDumpPressed_)
+            {
+                WriteProfileTrace();
+                profileDumpPressed_ = true;
+            }
+            else if (dumpState == GLFW_RELEASE)
+            {
+                profileDumpPressed_ = false;
+            }
+
             Render();
 
-            glfwSwapBuffers(window_);
+            {
+                PLANE_PROFILE_SCOPE("SwapBuffers");
+                glfwSwapBuffers(window_);
+            }
             glfwPollEvents();
         }
     }
 
-    void PlaneApplication::Update()
+    void PlaneApplication::WriteProfileTrace() const
     {
-        struct inputReportPayload payload;
-        struct inputReportPayload* sendIn;
-        bool isRumbleSet[2] = {false,false};
+#ifdef PLANE_ENABLE_PROFILER
+        if (core::Profiler::WriteChromeTrace(core::AppConfig::ProfileTracePath))
+            std::cout << "Wrote profile trace to " << core::AppConfig::ProfileTracePath << std::endl;
+        else
+            std::cout << "Failed to write profile trace to " << core::AppConfig::ProfileTracePath << std::endl;
+#endif
+    }
+
+    void PlaneApplication::PollControllers()
+    {
+        PLANE_PROFILE_SCOPE("PlaneApplication::PollControllers");
         for (std::size_t i = 0; i < players_.size(); ++i)
         {
-            auto& player = players_[i];
-            if (this->controller[i] != NULL) {
-                payload = this->controller[i]->getInputReport(1);
-                sendIn = &payload;
-            }
-            else {
-                sendIn = NULL;
+            if (this->controller[i] == NULL)
+            {
+                continue;
             }
 
-            inputHandler_.ProcessInput(window_, player.state, timingState_, inputBindings_[i], planes_[i].get(), sendIn, i);
-            boosterSystem_.Update(player.state, timingState_.deltaTime);
+            controllerPayloads_[i] = this->controller[i]->getInputReport(1);
 
-            if (player.state.isBoosting && player.state.boostHeld) {
-                if(this->controller[i] != NULL)
-                    this->controller[i]->setRumblePower(255, 255).send();
-            }
-            else {
-                if (this->controller[i] != NULL)
-                    this->controller[i]->setRumblePower(0, 0).send();
-            }
+            const auto& state = latestSnapshot_->players[i].state;
+            if (state.isBoosting && state.boostHeld)
+                this->controller[i]->setRumblePower(255, 255).send();
+            else
+                this->controller[i]->setRumblePower(0, 0).send();
+        }
+    }
 
+    void PlaneApplication::PrepareRenderStates()
+    {
+        // Always draw the newest complete tick; the sim thread keeps ticking meanwhile.
+        const app::WorldSnapshot& snapshot = simulationThread_.AcquireLatestSnapshot();
+        latestSnapshot_ = &snapshot;
 
-             //Fire bullets at a rate-limited cadence while the fire key is held.
-            player.state.fireCooldown = (std::max)(0.0f, player.state.fireCooldown - timingState_.deltaTime);
+        // Blend from the previous tick by how far we are into the current one.
+        const double sinceTick = simulationThread_.Now() - snapshot.publishTime;
+        timingState_.interpolationAlpha = (std::clamp)(static_cast<float>(sinceTick / timingState_.deltaTime), 0.0f, 1.0f);
+        const float alpha = (gameState_ == core::GameState::Playing) ? timingState_.interpolationAlpha : 1.0f;
 
-            bool firePressed = false;
-            if (this->controller[i] != NULL) {
-                if (payload.triggerRight >= 127)
-                    firePressed = true;
-            }
-            else {
-                int fireKeyState = glfwGetKey(window_, inputBindings_[i].fire);
-                firePressed = (fireKeyState == GLFW_PRESS);
-            }
+        for (std::size_t i = 0; i < players_.size(); ++i)
+        {
+            auto& player = players_[i];
+            const auto& simPlayer = snapshot.players[i];
+            player.renderState = core::InterpolatePlaneState(simPlayer.previousState, simPlayer.state, alpha);
+            player.renderCameraRig = core::InterpolateCameraRig(simPlayer.previousCameraRig, simPlayer.cameraRig, alpha);
+            // Zoom comes from the mouse wheel on this thread rather than from the sim.
+            player.renderCameraRig.camera.Zoom = player.cameraRig.camera.Zoom;
+        }
 
-            if (firePressed && player.state.fireCooldown <= 0.0f)
-            {
-                shootingSystem_.FireBullet(player.state);
-                player.state.fireCooldown = (player.state.fireRatePerSec > 0.0f) ? (1.0f / player.state.fireRatePerSec) : 0.0f;
-            }
-            else {
-                isRumbleSet[i] = false;
-            }
+        aiRenderStates_.resize(snapshot.aiPlanes.size());
+        for (std::size_t i = 0; i < snapshot.aiPlanes.size(); ++i)
+        {
+            aiRenderStates_[i] = core::InterpolatePlaneState(snapshot.aiPlanes[i].previousState, snapshot.aiPlanes[i].state, alpha);
+        }
+    }
+
+    void PlaneApplication::Update()
+    {
+        PLANE_PROFILE_SCOPE("PlaneApplication::Update");
+        // Sample this frame's input and hand it to the sim thread, which applies it to
+        // every tick until the next frame's sample arrives.
+        latestSnapshot_ = &simulationThread_.AcquireLatestSnapshot();
+        PollControllers();
 
-            planeController_.UpdateFlightDynamics(player.state, timingState_.deltaTime);
-            collisionSystem_.CheckAndResolveCollisions(player.state, timingState_.deltaTime);
-            boostTrailRenderer_.UpdateForPlane(player.state, timingState_.deltaTime, i);
-            player.cameraController.Update(player.state, player.cameraRig, timingState_.deltaTime);
+        sim::Simulation::PlayerInputs inputs;
+        for (std::size_t i = 0; i < players_.size(); ++i)
+        {
+            const struct inputReportPayload* payload = (this->controller[i] != NULL) ? &controllerPayloads_[i] : NULL;
+            inputs[i] = inputHandler_.Sample(window_, inputBindings_[i], payload);
         }
 
-        // Update game systems
-        shootingSystem_.Update(timingState_.deltaTime, players_[0].state);
-        shootingSystem_.Update(timingState_.deltaTime, players_[1].state);
-        skeletalAnimationSystem_.Update(timingState_.deltaTime);
-        movementSystem_.Update(timingState_.deltaTime);
-        multiplayerManager_.Update(timingState_.deltaTime);
+        simulationThread_.SubmitInputs(inputs);
     }
 
     void PlaneApplication::Shutdown()
     {
+        assetStreamer_.Stop();
+        simulationThread_.Stop();
+        WriteProfileTrace();
+        if (simulationThread_.SaveRecording(core::AppConfig::ReplayPath))
+            std::cout << "Wrote input recording to " << core::AppConfig::ReplayPath << std::endl;
+
         groundPlane_.Shutdown();
         terrainPlane_.Shutdown();
+        terrainTiles_.Shutdown();
         healthBarRenderer_.Shutdown();
         boostTrailRenderer_.Shutdown();
+        bulletRenderer_.Shutdown();
         startMenuRenderer_.Shutdown();
         shadowMap_.Shutdown();
+        frameUniforms_.Shutdown();
         skybox_.Shutdown();
-
+        // Shared models delete their textures on release, which needs the context alive.
+        for (auto& plane : planes_)
+            plane.reset();
+        assetCache_.Clear();
+        Shader::SetProgramCache(nullptr);
 
         if(this->controller[0] != NULL)
             this->controller[0]->closeDualSense();
@@ -239,59 +286,135 @@ namespace plane::app
             std::cout << "Failed to initialize GLAD" << std::endl;
             return false;
         }
+        render::DetectTextureSupport();
+        shaderCache_.Initialize(core::AppConfig::ShaderCacheDirectory, (GLADloadproc)glfwGetProcAddress);
+        Shader::SetProgramCache(&shaderCache_);
         return true;
     }
 
     void PlaneApplication::InitializeScene()
     {
+        // Only what the start menu needs is loaded here; the rest streams in behind it.
+        startMenuRenderer_.Initialize(FileSystem::getPath("resources/startmenu.jpg"));
+
+        sim::SimulationConfig simulationConfig;
+        simulationConfig.worldSeed = core::AppConfig::WorldSeed;
+        simulationConfig.terrainCacheDirectory = core::AppConfig::TerrainCacheDirectory;
+        simulationConfig.terrainDemPath = core::AppConfig::TerrainDemPath;
+        simulation_.Initialize(simulationConfig, &jobSystem_);
         InitializePlayers();
         shader_ = std::make_unique<Shader>("plane.vs", "plane.fs");
         shadowShader_ = std::make_unique<Shader>("shadow_depth.vs", "shadow_depth.fs");
         skyboxShader_ = std::make_unique<Shader>("skybox.vs", "skybox.fs");
+        frameUniforms_.Initialize(players_.size());
+        render::FrameUniforms::BindBlocks(shader_->ID);
+        render::FrameUniforms::BindBlocks(shadowShader_->ID);
+        render::FrameUniforms::BindBlocks(skyboxShader_->ID);
+        // Model samplers get their fixed units; the depth texture takes unit 1, which they leave free.
+        Mesh::BindSamplerUnits(*shader_);
+        shader_->setInt("shadowMap", 1);
 
-        planes_[0] = std::make_unique<Plane>();
-        planes_[1] = std::make_unique<Plane>();
-        if (!planes_[0]->LoadModels())
-        {
-            std::cout << "Failed to load one or more plane parts for player 1 from plane2/ folder" << std::endl;
-        }
-        if (!planes_[1]->LoadModels())
-        {
-            std::cout << "Failed to load one or more plane parts for player 2 from plane2/ folder" << std::endl;
-        }
-
-        islandManager_.GenerateIslands();
-        groundPlane_.Initialize(FileSystem::getPath("resources/textures/wave3.jpg"));
-        terrainPlane_.Initialize(FileSystem::getPath("resources/objects/island4/island_baseColor.jpeg"), 3000.0f, 250);  // 5x size, 2.5x grid resolution
         if (!shadowMap_.Initialize(2048, 2048))
         {
             std::cout << "Failed to initialize shadow map resources." << std::endl;
         }
-        if (!skybox_.Initialize(FileSystem::getPath("resources/textures/skybox")))
-        {
-            std::cout << "Failed to initialize skybox resources." << std::endl;
-        }
         if (skyboxShader_)
         {
             skyboxShader_->use();
             skyboxShader_->setInt("skybox", 0);
         }
 
-        shootingSystem_.Initialize();
-        skeletalAnimationSystem_.Initialize();
-        movementSystem_.Initialize();
-        multiplayerManager_.Initialize();
         healthBarRenderer_.Initialize();
         boostTrailRenderer_.Initialize();
-        startMenuRenderer_.Initialize(FileSystem::getPath("resources/startmenu.jpg"));
-        collisionSystem_.Initialize(islandManager_, &terrainPlane_);
+
+        RequestAssets();
+
+        // From here on the simulation belongs to its thread; it idles until the game starts.
+        simulationThread_.Start(simulation_, &jobSystem_, 1.0f / core::AppConfig::SimulationHz);
     }
 
-    void PlaneApplication::InitializePlayers()
+    void PlaneApplication::RequestAssets()
     {
-        players_[0].state.position = glm::vec3(100.0f, 26.0f, 0.0f);
-        players_[1].state.position = glm::vec3(-100.0f, 96.0f, 0.0f);
+        assetRequestTime_ = glfwGetTime();
+        assetStreamer_.Start();
 
+        for (std::size_t i = 0; i < planes_.size(); ++i)
+        {
+            planes_[i] = std::make_unique<Plane>();
+            planes_[i]->LoadModels(assetCache_, assetStreamer_);
+        }
+        bulletRenderer_.Initialize(assetCache_, assetStreamer_);
+
+        // The sim thread only edits the height field once the match starts, after every
+        // load here has finished; craters reach the GPU through ApplyTerrainEdits.
+        const world::HeightField* heightField = &simulation_.GetHeightField();
+        terrainTiles_.Initialize(*heightField, core::AppConfig::TerrainTileRings, core::AppConfig::TerrainTilePoolSize);
+        const std::string terrainTexturePath = FileSystem::getPath("resources/objects/island4/island_baseColor.jpeg");
+        // Empty when the seed was randomized, so one-off worlds are not cached.
+        const std::string terrainCacheDirectory = simulation_.GetConfig().terrainCacheDirectory;
+        assetStreamer_.Enqueue("Load Terrain", render::StreamPriority::High, [this, heightField, terrainTexturePath, terrainCacheDirectory]
+        {
+            auto texture = render::DecodeImage(terrainTexturePath);
+            auto mesh = std::make_shared<render::TerrainPlane::MeshData>(render::TerrainPlane::BuildMesh(*heightField, terrainCacheDirectory));
+            return [this, texture, mesh] { terrainPlane_.Initialize(texture, *mesh); };
+        });
+
+        const std::string groundTexturePath = FileSystem::getPath("resources/textures/wave3.jpg");
+        assetStreamer_.Enqueue("Load Ground", render::StreamPriority::Normal, [this, groundTexturePath]
+        {
+            auto texture = render::DecodeImage(groundTexturePath);
+            return [this, texture] { groundPlane_.Initialize(texture); };
+        });
+
+        const std::string skyboxPath = FileSystem::getPath("resources/textures/skybox");
+        assetStreamer_.Enqueue("Load Skybox", render::StreamPriority::Low, [this, skyboxPath]
+        {
+            auto faces = render::Skybox::DecodeFaces(skyboxPath);
+            return [this, faces]
+            {
+                if (!skybox_.Initialize(faces))
+                {
+                    std::cout << "Failed to initialize skybox resources." << std::endl;
+                }
+            };
+        });
+    }
+
+    void PlaneApplication::StreamAssets()
+    {
+        PLANE_PROFILE_SCOPE("PlaneApplication::StreamAssets");
+        // Terrain tiles follow last frame's render positions; they are never far behind.
+        std::vector<glm::vec3> focusPoints;
+        for (const auto& player : players_)
+        {
+            focusPoints.push_back(player.renderState.position);
+        }
+        terrainTiles_.Update(focusPoints, assetStreamer_);
+
+        assetStreamer_.PumpUploads(core::AppConfig::AssetUploadBudgetSeconds);
+        if (assetsReady_ || !assetStreamer_.IsIdle())
+        {
+            return;
+        }
+
+        assetsReady_ = true;
+        const auto& assetStats = assetCache_.GetStats();
+        std::cout << "Assets streamed in " << static_cast<int>((glfwGetTime() - assetRequestTime_) * 1000.0) << " ms: "
+                  << assetStats.modelLoads << " models loaded (" << assetStats.modelReuses << " reused), "
+                  << assetStats.textureLoads << " textures loaded (" << assetStats.textureReuses << " reused)" << std::endl;
+    }
+
+    void PlaneApplication::ApplyTerrainEdits()
+    {
+        simulationThread_.TakeTerrainPatches(terrainPatches_);
+        for (const auto& patch : terrainPatches_)
+        {
+            terrainPlane_.ApplyPatch(patch);
+        }
+    }
+
+    void PlaneApplication::InitializePlayers()
+    {
         inputBindings_[0] = input::InputBindings{};
         inputBindings_[1] = input::InputBindings{
             GLFW_KEY_UP,
@@ -308,16 +431,13 @@ namespace plane::app
             GLFW_KEY_RIGHT   // flapLeftDown
         };
 
-        for (auto& player : players_)
-        {
-            player.cameraRig.camera.Position = player.state.position + glm::vec3(0.0f, 1.0f, -12.0f);
-            player.cameraRig.camera.Front = glm::normalize(player.state.position - player.cameraRig.camera.Position);
-            player.cameraRig.firstMouse = true;
-        }
     }
 
     void PlaneApplication::Render()
     {
+        PLANE_PROFILE_SCOPE("PlaneApplication::Render");
+        PrepareRenderStates();
+
         if (gameState_ == core::GameState::StartMenu)
         {
             RenderStartMenu();
@@ -351,114 +471,76 @@ namespace plane::app
 
     void PlaneApplication::CheckGameOver()
     {
-        // Check if any player has died
-        for (const auto& player : players_)
+        // Check if any player has died; the sim thread stops ticking on its own.
+        const app::WorldSnapshot& snapshot = simulationThread_.AcquireLatestSnapshot();
+        if (snapshot.round == currentRound_ && snapshot.anyPlayerDown)
         {
-            if (!player.state.isAlive)
-            {
-                gameState_ = core::GameState::GameOver;
-                break;
-            }
+            gameState_ = core::GameState::GameOver;
         }
     }
 
     void PlaneApplication::RestartGame()
     {
-        // Reset player 1
-        players_[0].state.position = glm::vec3(100.0f, 26.0f, 0.0f);
-        players_[0].state.pitch = 0.0f;
-        players_[0].state.yaw = 0.0f;
-        players_[0].state.roll = 0.0f;
-        players_[0].state.baseSpeed = 25.0f;
-        players_[0].state.speed = players_[0].state.baseSpeed;
-        players_[0].state.boosterFuelSeconds = players_[0].state.boosterMaxFuelSeconds;
-        players_[0].state.boostHeld = false;
-        players_[0].state.isBoosting = false;
-        players_[0].state.boosterExhausted = false;
-        players_[0].state.health = 100.0f;
-        players_[0].state.isAlive = true;
-        players_[0].state.pitchInputTime = 0.0f;
-        players_[0].state.rollInputTime = 0.0f;
-        players_[0].state.fireCooldown = 0.0f;
-        
-        // Reset player 2
-        players_[1].state.position = glm::vec3(-100.0f, 96.0f, 0.0f);
-        players_[1].state.pitch = 0.0f;
-        players_[1].state.yaw = 0.0f;
-        players_[1].state.roll = 0.0f;
-        players_[1].state.baseSpeed = 25.0f;
-        players_[1].state.speed = players_[1].state.baseSpeed;
-        players_[1].state.boosterFuelSeconds = players_[1].state.boosterMaxFuelSeconds;
-        players_[1].state.boostHeld = false;
-        players_[1].state.isBoosting = false;
-        players_[1].state.boosterExhausted = false;
-        players_[1].state.health = 100.0f;
-        players_[1].state.isAlive = true;
-        players_[1].state.pitchInputTime = 0.0f;
-        players_[1].state.rollInputTime = 0.0f;
-        players_[1].state.fireCooldown = 0.0f;
-        
-        // Reset camera positions
-        for (auto& player : players_)
-        {
-            player.cameraRig.camera.Position = player.state.position + glm::vec3(0.0f, 1.0f, -12.0f);
-            player.cameraRig.camera.Front = glm::normalize(player.state.position - player.cameraRig.camera.Position);
-            player.cameraRig.firstMouse = true;
-        }
-        
-        // Reset plane part transforms
-        if (planes_[0]) planes_[0]->ResetAllTransforms();
-        if (planes_[1]) planes_[1]->ResetAllTransforms();
-
-        // Clear bullets by reinitializing shooting system
-        shootingSystem_ = features::shooting::ShootingSystem();
-        shootingSystem_.Initialize();
-        
-        // Reset game state
+        PLANE_PROFILE_SCOPE("PlaneApplication::RestartGame");
+        // The sim thread respawns both planes and clears bullets and trails.
+        ++currentRound_;
+        simulationThread_.Restart();
         gameState_ = core::GameState::Playing;
     }
 
     void PlaneApplication::RenderGameplay()
     {
+        PLANE_PROFILE_SCOPE("PlaneApplication::RenderGameplay");
         // First render depth from the sun's perspective so the main pass can shadow.
-        glm::mat4 lightSpaceMatrix = CalculateLightSpaceMatrix();
-        RenderDepthPass(lightSpaceMatrix);
-
-        glViewport(0, 0, core::AppConfig::ScreenWidth, core::AppConfig::ScreenHeight);
-        glClearColor(0.5f, 0.7f, 0.9f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        const glm::mat4 lightSpaceMatrix = CalculateLightSpaceMatrix();
+        frameUniforms_.SetFrame(lightSpaceMatrix, lightDirection_);
+        // Bullets are gathered once; each viewport then draws its visible ones in one instanced call.
+        bulletRenderer_.Update(latestSnapshot_->bullets);
 
         float halfWidth = core::AppConfig::ScreenWidth * 0.5f;
         float height = static_cast<float>(core::AppConfig::ScreenHeight);
         float aspect = halfWidth / height;
 
+        // The shadow pass takes the finer of the two cameras' terrain detail, so casters
+        // stay close to the surfaces the color passes draw.
+        std::array<float, sim::Simulation::PlayerCount> terrainLodScales;
+        for (std::size_t i = 0; i < players_.size(); ++i)
+        {
+            terrainLodScales[i] = render::TerrainPlane::LodScale(
+                height, glm::radians(players_[i].renderCameraRig.camera.Zoom), core::AppConfig::TerrainMaxPixelError);
+        }
+        RenderDepthPass(render::Frustum::FromMatrix(lightSpaceMatrix), *std::max_element(terrainLodScales.begin(), terrainLodScales.end()));
+
+        glViewport(0, 0, core::AppConfig::ScreenWidth, core::AppConfig::ScreenHeight);
+        glClearColor(0.5f, 0.7f, 0.9f, 1.0f);
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
         for (std::size_t i = 0; i < players_.size(); ++i)
         {
             glViewport(static_cast<GLint>(i * halfWidth), 0, static_cast<GLsizei>(halfWidth), static_cast<GLsizei>(height));
 
             glm::mat4 projection = glm::perspective(
-                glm::radians(players_[i].cameraRig.camera.Zoom),
+                glm::radians(players_[i].renderCameraRig.camera.Zoom),
                 aspect,
                 0.1f,
                 1000.0f
             );
-            glm::mat4 view = players_[i].cameraRig.camera.GetViewMatrix();
+            glm::mat4 view = players_[i].renderCameraRig.camera.GetViewMatrix();
 
-            RenderColorPass(projection, view, lightSpaceMatrix, players_[i].cameraRig);
+            frameUniforms_.SetView(i, projection, view, players_[i].renderCameraRig.camera.Position);
+            RenderColorPass(render::Frustum::FromMatrix(projection * view), players_[i].renderCameraRig.camera.Position, terrainLodScales[i]);
             
             // Render player's own health bar as a camera-anchored billboard
-            const auto& cam = players_[i].cameraRig.camera;
+            const auto& cam = players_[i].renderCameraRig.camera;
             healthBarRenderer_.RenderPlayerHealthBillboard(
-                players_[i].state,
-                projection,
+                players_[i].renderState,
                 view,
                 cam.Position,
                 cam.Front,
                 cam.Up);
 
             healthBarRenderer_.RenderPlayerBoosterBillboard(
-                players_[i].state,
-                projection,
+                players_[i].renderState,
                 view,
                 cam.Position,
                 cam.Front,
@@ -466,14 +548,13 @@ namespace plane::app
 
             // Render aiming reticle in front of the plane
             healthBarRenderer_.RenderAimingReticle(
-                players_[i].state,
-                projection,
+                players_[i].renderState,
                 view);
             
             // Render enemy health bar above enemy plane
-            size_t enemyIdx = (i == 0) ? 1 : 0;
-            healthBarRenderer_.RenderEnemyHealthBar(players_[enemyIdx].state, projection, view, players_[i].cameraRig.camera.Position);
-            healthBarRenderer_.RenderEnemyTargetGuide(players_[enemyIdx].state, projection, view);
+            size_t enemyIdx = (i + 1) % players_.size();
+            healthBarRenderer_.RenderEnemyHealthBar(players_[enemyIdx].renderState, view, players_[i].renderCameraRig.camera.Position);
+            healthBarRenderer_.RenderEnemyTargetGuide(players_[enemyIdx].renderState, projection, view);
         }
 
         // Draw a simple vertical divider between the two viewports.
@@ -509,20 +590,26 @@ namespace plane::app
         }
     }
 
-    void PlaneApplication::RenderDepthPass(const glm::mat4& lightSpaceMatrix)
+    void PlaneApplication::RenderDepthPass(const render::Frustum& lightFrustum, float terrainLodScale)
     {
+        PLANE_PROFILE_SCOPE("PlaneApplication::RenderDepthPass");
         shadowMap_.BindForWriting();
         glViewport(0, 0, shadowMap_.GetWidth(), shadowMap_.GetHeight());
         glClear(GL_DEPTH_BUFFER_BIT);
 
-        shadowShader_->use();
-        shadowShader_->setMat4("lightSpaceMatrix", lightSpaceMatrix);
+        // Depth only sorts the queue; the players' midpoint is close enough to the light frustum.
+        SubmitSceneGeometry(*shadowShader_, true, lightFrustum, 0.5f * (players_[0].renderState.position + players_[1].renderState.position), terrainLodScale);
+        renderQueue_.Sort();
 
 #ifndef NDEBUG
         // Flip culling while writing the shadow map to avoid peter-panning.
         glCullFace(GL_FRONT);
 #endif
-        RenderSceneGeometry(*shadowShader_, false);
+        glState_.Invalidate();
+        terrainPlane_.BindHeightTextures(glState_);
+        terrainTiles_.BindHeightTextures(glState_);
+        renderQueue_.Execute(glState_, false);
+        glState_.RestoreDefaults();
 #ifndef NDEBUG
         glCullFace(GL_BACK);
 #endif
@@ -530,47 +617,52 @@ namespace plane::app
         shadowMap_.Unbind();
     }
 
-    void PlaneApplication::RenderColorPass(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& lightSpaceMatrix, const core::CameraRig& cameraRig)
+    void PlaneApplication::RenderColorPass(const render::Frustum& frustum, const glm::vec3& viewPos, float terrainLodScale)
     {
+        PLANE_PROFILE_SCOPE("PlaneApplication::RenderColorPass");
         if (skyboxShader_)
         {
-            skybox_.Draw(projection, view, *skyboxShader_);
+            skybox_.Draw(*skyboxShader_);
         }
 
-        shader_->use();
-        shader_->setMat4("projection", projection);
-        shader_->setMat4("view", view);
-        shader_->setMat4("lightSpaceMatrix", lightSpaceMatrix);
-        shader_->setVec3("lightDir", glm::normalize(lightDirection_));
-        shader_->setVec3("viewPos", cameraRig.camera.Position);
-        shader_->setInt("shadowMap", 1);
-
-        // Depth texture lives on unit 1 so diffuse maps can stay on unit 0.
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, shadowMap_.GetDepthMap());
-
-        RenderSceneGeometry(*shader_, true);
+        SubmitSceneGeometry(*shader_, false, frustum, viewPos, terrainLodScale);
+        bulletRenderer_.Submit(renderQueue_, frustum, viewPos);
+        renderQueue_.Sort();
 
-        // Draw bullets after the main geometry so they appear on top.
-        shootingSystem_.Render(*shader_);
+        // The skybox and everything before it bypass the cache.
+        glState_.Invalidate();
+        glState_.BindTexture2D(1, shadowMap_.GetDepthMap());
+        terrainPlane_.BindHeightTextures(glState_);
+        terrainTiles_.BindHeightTextures(glState_);
+        renderQueue_.Execute(glState_, true);
 
         // Boost particles (trail) in world space.
-        boostTrailRenderer_.Render(projection, view);
+        boostTrailRenderer_.Render(latestSnapshot_->particles, frustum, glState_);
 
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, 0);
+        glState_.BindTexture2D(1, 0);
+        glState_.RestoreDefaults();
     }
 
-    void PlaneApplication::RenderSceneGeometry(Shader& shader, bool bindTextures)
+    void PlaneApplication::SubmitSceneGeometry(const Shader& shader, bool shadowPass, const render::Frustum& frustum, const glm::vec3& viewPos, float terrainLodScale)
     {
-        // Draw order keeps the large ground first so depth testing is stable.
-        groundPlane_.Draw(shader, bindTextures);
-        terrainPlane_.Draw(shader, bindTextures);  // Use heightmap terrain instead of island models
+        PLANE_PROFILE_SCOPE("PlaneApplication::SubmitSceneGeometry");
+        renderQueue_.Clear();
+        groundPlane_.Submit(renderQueue_, shader.ID, frustum, viewPos);
+        terrainPlane_.Submit(renderQueue_, shadowPass, frustum, viewPos, terrainLodScale);  // Use heightmap terrain instead of island models
+        terrainTiles_.Submit(renderQueue_, shadowPass, frustum, viewPos, terrainLodScale, terrainPlane_);
         for (std::size_t i = 0; i < players_.size(); ++i)
         {
             const auto& player = players_[i];
-            if (player.state.isAlive && planes_[i])
-                planeRenderer_.Draw(*planes_[i], shader, player.state);
+            if (player.renderState.isAlive && planes_[i])
+                planeRenderer_.Submit(*planes_[i], renderQueue_, shader.ID, frustum, player.renderState, viewPos);
+        }
+
+        // AI planes share one set of part models; Submit re-poses it for each.
+        Plane* aiModel = planes_.back().get();
+        for (const auto& aiState : aiRenderStates_)
+        {
+            if (aiState.isAlive && aiModel)
+                planeRenderer_.Submit(*aiModel, renderQueue_, shader.ID, frustum, aiState, viewPos);
         }
     }
 
@@ -578,10 +670,10 @@ namespace plane::app
     {
         // Build an orthographic frustum that follows both planes, emulating sun light.
         glm::vec3 lightDir = glm::normalize(lightDirection_);
-        glm::vec3 center = 0.5f * (players_[0].state.position + players_[1].state.position);
+        glm::vec3 center = 0.5f * (players_[0].renderState.position + players_[1].renderState.position);
         float radius = (std::max)(
-            glm::length(players_[0].state.position - center),
-            glm::length(players_[1].state.position - center)
+            glm::length(players_[0].renderState.position - center),
+            glm::length(players_[1].renderState.position - center)
         );
         float orthoExtent = 800.0f + radius;
         glm::vec3 lightPos = center - lightDir * 300.0f + glm::vec3(0.0f, 150.0f, 0.0f);
@@ -10,33 +10,37 @@
 
 #include <memory>
 #include <array>
+#include <vector>
 
 #include "core/AppConfig.h"
-#include "core/CameraController.h"
 #include "core/CameraRig.h"
 #include "core/GameState.h"
+#include "core/Interpolation.h"
+#include "core/JobSystem.h"
 #include "core/PlaneState.h"
 #include "core/Timing.h"
-#include "entities/PlaneController.h"
-#include "features/animation/SkeletalAnimationSystem.h"
-#include "features/movement/AdvancedMovementSystem.h"
-#include "features/movement/BoosterSystem.h"
-#include "features/multiplayer/MultiplayerManager.h"
-#include "features/shooting/ShootingSystem.h"
 #include "input/InputHandler.h"
-#include "physics/CollisionSystem.h"
+#include "render/AssetCache.h"
+#include "render/AssetStreamer.h"
 #include "render/GroundPlane.h"
 #include "render/BoostTrailRenderer.h"
+#include "render/BulletRenderer.h"
+#include "render/FrameUniforms.h"
+#include "render/Frustum.h"
 #include "render/HealthBarRenderer.h"
 #include "render/PlaneRenderer.h"
+#include "render/RenderQueue.h"
+#include "render/ShaderBinaryCache.h"
 #include "render/ShadowMap.h"
 #include "render/StartMenuRenderer.h"
 #include "render/Skybox.h"
 #include "render/TerrainPlane.h"
-#include "world/IslandManager.h"
+#include "render/TerrainTileStreamer.h"
+#include "sim/Simulation.h"
 #include <hidapi/hidapi.h>
 #include "core/controller/Controller.hpp"
 #include "Plane.h"
+#include "SimulationThread.h"
 
 namespace plane::app
 {
@@ -55,17 +59,29 @@ namespace plane::app
         bool InitializeWindow();
         bool InitializeGlad();
         void InitializeScene();
+        void RequestAssets();
+        void StreamAssets();
+        // Uploads the terrain the sim thread has cratered since last frame.
+        void ApplyTerrainEdits();
         void InitializePlayers();
         void Update();
+        void PollControllers();
+        void PrepareRenderStates();
         void Render();
         void RenderStartMenu();
         void RenderGameplay();
         void RenderGameOver();
         void RestartGame();
+        void WriteProfileTrace() const;
         void CheckGameOver();
-        void RenderDepthPass(const glm::mat4& lightSpaceMatrix);
-        void RenderColorPass(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& lightSpaceMatrix, const core::CameraRig& cameraRig);
-        void RenderSceneGeometry(Shader& shader, bool bindTextures);
+        // Both passes read the camera and light from frameUniforms_; frustum culls what they
+        // submit and viewPos only orders the queue.
+        // terrainLodScale picks terrain detail (see TerrainPlane::LodScale).
+        void RenderDepthPass(const render::Frustum& lightFrustum, float terrainLodScale);
+        void RenderColorPass(const render::Frustum& frustum, const glm::vec3& viewPos, float terrainLodScale);
+        // Refills renderQueue_ with the parts of the world inside frustum, drawn with shader
+        // (the terrain brings its own programs and only needs to know the pass).
+        void SubmitSceneGeometry(const Shader& shader, bool shadowPass, const render::Frustum& frustum, const glm::vec3& viewPos, float terrainLodScale);
         glm::mat4 CalculateLightSpaceMatrix() const;
 
         static void FramebufferCallback(GLFWwindow* window, int width, int height);
@@ -74,45 +90,65 @@ namespace plane::app
 
         struct PlayerContext
         {
-            core::PlaneState state;
+            // Receives mouse and scroll input; the pose itself comes from the sim thread.
             core::CameraRig cameraRig;
-            core::CameraController cameraController;
+
+            // What the renderer draws this frame (blend of the snapshot's previous and current tick).
+            core::PlaneState renderState;
+            core::CameraRig renderCameraRig;
         };
 
         GLFWwindow* window_ { nullptr };
+        // Every Shader built after InitializeGlad goes through this.
+        render::ShaderBinaryCache shaderCache_;
         std::unique_ptr<Shader> shader_;
-        std::array<std::unique_ptr<Plane>, 2> planes_;
+        std::array<std::unique_ptr<Plane>, sim::Simulation::PlayerCount> planes_;
         std::unique_ptr<Model> islandModel_;
         std::unique_ptr<Shader> shadowShader_;
         std::unique_ptr<Shader> skyboxShader_;
 
+        // Declared before its users so shared models outlive nothing that holds them.
+        render::AssetCache assetCache_;
+        // After the cache: loader threads reach into it until they are joined.
+        render::AssetStreamer assetStreamer_;
+        render::FrameUniforms frameUniforms_;
+        render::RenderQueue renderQueue_;
+        render::GlStateCache glState_;
         render::GroundPlane groundPlane_;
         render::TerrainPlane terrainPlane_;
+        render::TerrainTileStreamer terrainTiles_;
         render::PlaneRenderer planeRenderer_;
         render::BoostTrailRenderer boostTrailRenderer_;
+        render::BulletRenderer bulletRenderer_;
         render::HealthBarRenderer healthBarRenderer_;
         render::StartMenuRenderer startMenuRenderer_;
         render::ShadowMap shadowMap_;
         render::Skybox skybox_;
-        world::IslandManager islandManager_;
 
-        std::array<PlayerContext, 2> players_;
-        std::array<input::InputBindings, 2> inputBindings_;
+        std::array<PlayerContext, sim::Simulation::PlayerCount> players_;
+        // AI planes blended from the snapshot; drawn with the last player's model.
+        std::vector<core::PlaneState> aiRenderStates_;
+        std::array<input::InputBindings, sim::Simulation::PlayerCount> inputBindings_;
         core::TimingState timingState_;
-        entities::PlaneController planeController_;
         input::InputHandler inputHandler_;
-        physics::CollisionSystem collisionSystem_;
-
-        features::shooting::ShootingSystem shootingSystem_;
-        features::animation::SkeletalAnimationSystem skeletalAnimationSystem_;
-        features::movement::AdvancedMovementSystem movementSystem_;
-        features::movement::BoosterSystem boosterSystem_;
-        features::multiplayer::MultiplayerManager multiplayerManager_;
+        core::JobSystem jobSystem_;
+        sim::Simulation simulation_;
+        SimulationThread simulationThread_;
+        std::vector<world::HeightField::Patch> terrainPatches_;   // Reused by ApplyTerrainEdits.
+        // Valid until the next AcquireLatestSnapshot call on this thread.
+        const WorldSnapshot* latestSnapshot_ { nullptr };
+        std::uint32_t currentRound_ { 0 };
 
         glm::vec3 lightDirection_ { -0.3f, -1.0f, -0.3f };
         
         core::GameState gameState_ { core::GameState::StartMenu };
+        // The match cannot start until every streamed asset has been uploaded; terrain
+        // tiles keep streaming afterwards.
+        bool assetsReady_ { false };
+        double assetRequestTime_ { 0.0 };
         bool spacePressed_ { false };
-        DualSense* controller[2];
+        bool profileDumpPressed_ { false };
+        DualSense* controller[sim::Simulation::PlayerCount];
+        std::array<struct inputReportPayload, sim::Simulation::PlayerCount> controllerPayloads_ {};
     };
 }
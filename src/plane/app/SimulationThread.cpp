@@ -0,0 +1,297 @@
+#include "SimulationThread.h"
+
+#include "core/AppConfig.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace plane::app
+{
+    SimulationThread::~SimulationThread()
+    {
+        Stop();
+    }
+
+    void SimulationThread::Start(sim::Simulation& simulation, core::JobSystem* jobSystem, float tickSeconds)
+    {
+        simulation_ = &simulation;
+        jobSystem_ = jobSystem;
+        timingState_ = core::TimingState{};
+        timingState_.deltaTime = tickSeconds;
+
+        boostTrailSystem_.Resize(sim::Simulation::PlayerCount);
+        recorder_.Begin(simulation, 1.0f / tickSeconds);
+        BuildPresentationGraph();
+        ResetPresentation();
+        PublishSnapshot();
+
+        stopRequested_ = false;
+        thread_ = std::thread(&SimulationThread::ThreadMain, this);
+    }
+
+    void SimulationThread::Stop()
+    {
+        if (!thread_.joinable())
+        {
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            stopRequested_ = true;
+        }
+        controlCondition_.notify_all();
+        thread_.join();
+    }
+
+    void SimulationThread::Resume()
+    {
+        {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            running_ = true;
+        }
+        controlCondition_.notify_all();
+    }
+
+    void SimulationThread::Restart()
+    {
+        {
+            std::lock_guard<std::mutex> lock(controlMutex_);
+            restartRequested_ = true;
+            running_ = true;
+        }
+        controlCondition_.notify_all();
+    }
+
+    void SimulationThread::SubmitInputs(const sim::Simulation::PlayerInputs& inputs)
+    {
+        inputs_.Back() = inputs;
+        inputs_.Publish();
+    }
+
+    const WorldSnapshot& SimulationThread::AcquireLatestSnapshot()
+    {
+        snapshots_.Update();
+        return snapshots_.Front();
+    }
+
+    double SimulationThread::Now() const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - epoch_).count();
+    }
+
+    bool SimulationThread::SaveRecording(const std::string& path) const
+    {
+        if (simulation_ == nullptr || thread_.joinable())
+        {
+            return false;
+        }
+        return recorder_.Save(path, simulation_->ComputeStateHash());
+    }
+
+    void SimulationThread::ThreadMain()
+    {
+        core::Profiler::SetThreadName("Simulation");
+
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(controlMutex_);
+                if (!running_ && !stopRequested_)
+                {
+                    controlCondition_.wait(lock, [this] { return running_ || stopRequested_; });
+                    // Idle time is not owed to the simulation.
+                    lastStepTime_ = Now();
+                    timingState_.accumulator = 0.0f;
+                }
+                if (stopRequested_)
+                {
+                    return;
+                }
+                if (restartRequested_)
+                {
+                    restartRequested_ = false;
+                    ++round_;
+                    simulation_->Reset();
+                    recorder_.MarkReset();
+                    ResetPresentation();
+                    PublishSnapshot();
+                    lastStepTime_ = Now();
+                    timingState_.accumulator = 0.0f;
+                }
+            }
+
+            const double now = Now();
+            // Clamp long stalls (breakpoint, suspended process) so the sim does not try to replay them.
+            timingState_.frameTime = (std::min)(static_cast<float>(now - lastStepTime_), core::AppConfig::MaxFrameTime);
+            lastStepTime_ = now;
+            timingState_.accumulator += timingState_.frameTime;
+
+            int ticks = 0;
+            while (timingState_.accumulator >= timingState_.deltaTime && ticks < core::AppConfig::MaxTicksPerFrame)
+            {
+                RunTick();
+                timingState_.accumulator -= timingState_.deltaTime;
+                ++ticks;
+
+                if (simulation_->IsAnyPlayerDown())
+                {
+                    // Hold the final state until the main thread asks for a restart.
+                    std::lock_guard<std::mutex> lock(controlMutex_);
+                    running_ = false;
+                    break;
+                }
+            }
+
+            // Out of catch-up budget: drop the backlog instead of falling further behind.
+            if (ticks == core::AppConfig::MaxTicksPerFrame)
+            {
+                timingState_.accumulator = (std::min)(timingState_.accumulator, timingState_.deltaTime);
+            }
+
+            // Sleep until the next tick is due.
+            const float untilNextTick = timingState_.deltaTime - timingState_.accumulator;
+            if (untilNextTick > 0.0f)
+            {
+                std::unique_lock<std::mutex> lock(controlMutex_);
+                controlCondition_.wait_for(lock, std::chrono::duration<float>(untilNextTick),
+                    [this] { return stopRequested_ || restartRequested_; });
+            }
+        }
+    }
+
+    void SimulationThread::RunTick()
+    {
+        PLANE_PROFILE_SCOPE("SimulationThread::RunTick");
+        for (std::size_t i = 0; i < previousStates_.size(); ++i)
+        {
+            previousStates_[i] = simulation_->GetPlayerState(i);
+            previousCameraRigs_[i] = cameraRigs_[i];
+        }
+        std::swap(previousAiStates_, aiStates_);
+
+        inputs_.Update();
+        recorder_.Record(inputs_.Front());
+        simulation_->Step(inputs_.Front(), timingState_.deltaTime);
+        QueueTerrainPatches();
+        GatherAiStates(aiStates_);
+
+        if (jobSystem_)
+            jobSystem_->Run(presentationGraph_);
+        else
+            presentationGraph_.RunInline();
+
+        PublishSnapshot();
+    }
+
+    void SimulationThread::BuildPresentationGraph()
+    {
+        // Trails and cameras only read their own plane's state, so every job is independent.
+        presentationGraph_.Clear();
+        for (std::size_t i = 0; i < cameraRigs_.size(); ++i)
+        {
+            presentationGraph_.Add("Boost Trail", [this, i]
+            {
+                boostTrailSystem_.UpdateForPlane(simulation_->GetPlayerState(i), timingState_.deltaTime, i);
+            });
+            presentationGraph_.Add("Camera", [this, i]
+            {
+                cameraControllers_[i].Update(simulation_->GetPlayerState(i), cameraRigs_[i], timingState_.deltaTime);
+            });
+        }
+    }
+
+    void SimulationThread::ResetPresentation()
+    {
+        boostTrailSystem_.Clear();
+        for (std::size_t i = 0; i < cameraRigs_.size(); ++i)
+        {
+            const auto& state = simulation_->GetPlayerState(i);
+            auto& rig = cameraRigs_[i];
+            rig.camera.Position = state.position + glm::vec3(0.0f, 1.0f, -12.0f);
+            rig.camera.Front = glm::normalize(state.position - rig.camera.Position);
+            rig.firstMouse = true;
+
+            // The fresh spawn has no previous tick to blend from.
+            previousStates_[i] = state;
+            previousCameraRigs_[i] = rig;
+        }
+
+        GatherAiStates(aiStates_);
+        previousAiStates_ = aiStates_;
+    }
+
+    void SimulationThread::GatherAiStates(std::vector<core::PlaneState>& out) const
+    {
+        const core::EntityRegistry& registry = simulation_->GetRegistry();
+        out.clear();
+        for (std::size_t i = 0; i < registry.Size(); ++i)
+        {
+            const core::EntityHandle handle = registry.HandleAt(i);
+            bool isPlayer = false;
+            for (std::size_t p = 0; p < sim::Simulation::PlayerCount; ++p)
+            {
+                isPlayer = isPlayer || (handle == simulation_->GetPlayerHandle(p));
+            }
+            if (!isPlayer)
+            {
+                out.push_back(registry.Gather(i));
+            }
+        }
+    }
+
+    void SimulationThread::QueueTerrainPatches()
+    {
+        simulation_->TakeTerrainEdits(terrainEdits_);
+        if (terrainEdits_.empty())
+        {
+            return;
+        }
+
+        PLANE_PROFILE_SCOPE("SimulationThread::QueueTerrainPatches");
+        // Read the grid here, between ticks; the main thread never touches it.
+        const world::HeightField& heightField = simulation_->GetHeightField();
+        std::lock_guard<std::mutex> lock(terrainMutex_);
+        for (const auto& rect : terrainEdits_)
+        {
+            terrainPatches_.push_back(heightField.ReadPatch(rect));
+        }
+    }
+
+    void SimulationThread::TakeTerrainPatches(std::vector<world::HeightField::Patch>& patches)
+    {
+        patches.clear();
+        std::lock_guard<std::mutex> lock(terrainMutex_);
+        std::swap(patches, terrainPatches_);
+    }
+
+    void SimulationThread::PublishSnapshot()
+    {
+        PLANE_PROFILE_SCOPE("SimulationThread::PublishSnapshot");
+        WorldSnapshot& snapshot = snapshots_.Back();
+        for (std::size_t i = 0; i < snapshot.players.size(); ++i)
+        {
+            auto& player = snapshot.players[i];
+            player.previousState = previousStates_[i];
+            player.state = simulation_->GetPlayerState(i);
+            player.previousCameraRig = previousCameraRigs_[i];
+            player.cameraRig = cameraRigs_[i];
+        }
+        // Spawns and despawns between ticks leave nothing to blend from.
+        const bool aiBlendable = previousAiStates_.size() == aiStates_.size();
+        snapshot.aiPlanes.resize(aiStates_.size());
+        for (std::size_t i = 0; i < aiStates_.size(); ++i)
+        {
+            snapshot.aiPlanes[i].previousState = aiBlendable ? previousAiStates_[i] : aiStates_[i];
+            snapshot.aiPlanes[i].state = aiStates_[i];
+        }
+        snapshot.bullets = simulation_->GetShootingSystem().GetBullets();
+        boostTrailSystem_.CollectParticles(snapshot.particles);
+        snapshot.tick = simulation_->GetTickCount();
+        snapshot.round = round_;
+        snapshot.publishTime = Now();
+        snapshot.anyPlayerDown = simulation_->IsAnyPlayerDown();
+        snapshots_.Publish();
+    }
+}
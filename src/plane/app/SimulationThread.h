@@ -0,0 +1,137 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "core/CameraController.h"
+#include "core/CameraRig.h"
+#include "core/JobSystem.h"
+#include "core/PlaneState.h"
+#include "core/Timing.h"
+#include "core/TripleBuffer.h"
+#include "features/movement/BoostTrailSystem.h"
+#include "features/shooting/ShootingSystem.h"
+#include "sim/InputRecording.h"
+#include "sim/Simulation.h"
+
+namespace plane::app
+{
+    // Everything the render thread needs from one tick. Immutable once published.
+    struct WorldSnapshot
+    {
+        struct Player
+        {
+            // The tick before this one, so rendering can blend toward 'state'.
+            core::PlaneState previousState;
+            core::PlaneState state;
+            core::CameraRig previousCameraRig;
+            core::CameraRig cameraRig;
+        };
+
+        // Unpiloted planes: no camera, same blend as players.
+        struct AiPlane
+        {
+            core::PlaneState previousState;
+            core::PlaneState state;
+        };
+
+        std::array<Player, sim::Simulation::PlayerCount> players;
+        std::vector<AiPlane> aiPlanes;
+        std::vector<features::shooting::Bullet> bullets;
+        std::vector<features::movement::BoostParticle> particles;
+
+        std::uint64_t tick { 0 };
+        // Bumped by every Restart, so the main thread can tell stale snapshots apart.
+        std::uint32_t round { 0 };
+        // SimulationThread::Now() when the tick was published.
+        double publishTime { 0.0 };
+        bool anyPlayerDown { false };
+    };
+
+    // Runs sim::Simulation plus the chase cameras and boost trails at a fixed rate on
+    // its own thread. The main thread hands over inputs and reads back snapshots,
+    // both through triple buffers, so a slow frame never stalls a tick or vice versa.
+    class SimulationThread
+    {
+    public:
+        SimulationThread() = default;
+        ~SimulationThread();
+
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+
+        // simulation must already be initialized; it is owned by the thread until Stop.
+        void Start(sim::Simulation& simulation, core::JobSystem* jobSystem, float tickSeconds);
+        void Stop();
+
+        // Begin ticking; the thread idles until then and again after a plane goes down.
+        void Resume();
+        // Respawn everything and resume, applied by the sim thread between ticks.
+        // Snapshots published afterwards carry the next round number.
+        void Restart();
+
+        // Main thread only.
+        void SubmitInputs(const sim::Simulation::PlayerInputs& inputs);
+        const WorldSnapshot& AcquireLatestSnapshot();
+        // Every terrain block cratered since the last call, oldest first. Unlike
+        // snapshots these queue up rather than replace each other, so none is missed.
+        void TakeTerrainPatches(std::vector<world::HeightField::Patch>& patches);
+
+        // Seconds on the clock used for WorldSnapshot::publishTime.
+        double Now() const;
+
+        // Writes every tick's inputs since Start, for plane_headless --replay. Only
+        // valid after Stop, while the simulation is no longer being stepped.
+        bool SaveRecording(const std::string& path) const;
+
+    private:
+        void ThreadMain();
+        void RunTick();
+        // Gathers every non-player plane in registry order.
+        void GatherAiStates(std::vector<core::PlaneState>& out) const;
+        void ResetPresentation();
+        void PublishSnapshot();
+        // Copies the blocks the last tick cratered out for the main thread.
+        void QueueTerrainPatches();
+        void BuildPresentationGraph();
+
+        sim::Simulation* simulation_ { nullptr };
+        core::JobSystem* jobSystem_ { nullptr };
+        core::TimingState timingState_;
+        double lastStepTime_ { 0.0 };
+        std::uint32_t round_ { 0 };
+
+        // Sim-thread state that is not part of sim::Simulation.
+        std::array<core::CameraController, sim::Simulation::PlayerCount> cameraControllers_;
+        std::array<core::CameraRig, sim::Simulation::PlayerCount> cameraRigs_;
+        std::array<core::PlaneState, sim::Simulation::PlayerCount> previousStates_;
+        std::array<core::CameraRig, sim::Simulation::PlayerCount> previousCameraRigs_;
+        std::vector<core::PlaneState> previousAiStates_;
+        std::vector<core::PlaneState> aiStates_;
+        features::movement::BoostTrailSystem boostTrailSystem_;
+        core::JobGraph presentationGraph_;
+        sim::InputRecorder recorder_;
+
+        core::TripleBuffer<sim::Simulation::PlayerInputs> inputs_;
+        core::TripleBuffer<WorldSnapshot> snapshots_;
+
+        const std::chrono::steady_clock::time_point epoch_ { std::chrono::steady_clock::now() };
+        std::thread thread_;
+        std::mutex controlMutex_;
+        std::condition_variable controlCondition_;
+        bool running_ { false };
+        bool restartRequested_ { false };
+        bool stopRequested_ { false };
+
+        std::vector<world::HeightField::GridRect> terrainEdits_;    // Sim thread scratch.
+        std::mutex terrainMutex_;
+        std::vector<world::HeightField::Patch> terrainPatches_;
+    };
+}
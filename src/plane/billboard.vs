@@ -1,8 +1,12 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 
-uniform mat4 projection;
-uniform mat4 view;
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
 uniform vec3 worldPos;
 uniform vec3 cameraRight;
 uniform vec3 cameraUp;
@@ -3,8 +3,12 @@ layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec4 aColor;
 layout (location = 2) in float aSize;
 
-uniform mat4 projection;
-uniform mat4 view;
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
 
 out vec4 vColor;
 
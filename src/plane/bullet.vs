@@ -0,0 +1,47 @@
+#version 330 core
+// Instanced bullets: each instance brings its position and flight direction, and the
+// model basis is rebuilt here rather than per bullet on the CPU. Feeds plane.fs.
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec3 aNormal;
+layout (location = 2) in vec2 aTexCoords;
+layout (location = 7) in vec3 aInstancePos;
+layout (location = 8) in vec3 aInstanceDir;
+
+out VS_OUT
+{
+    vec3 FragPos;
+    vec3 Normal;
+    vec2 TexCoords;
+    vec4 FragPosLightSpace;
+} vs_out;
+
+layout (std140) uniform FrameBlock
+{
+    mat4 lightSpaceMatrix;
+    vec4 lightDir;
+};
+
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
+
+const float kBulletScale = 0.25;
+
+void main()
+{
+    // Model -Z points along the flight direction.
+    vec3 dir = length(aInstanceDir) > 0.0001 ? normalize(aInstanceDir) : vec3(0.0, 0.0, -1.0);
+    vec3 right = normalize(cross(vec3(0.0, 1.0, 0.0), dir));
+    vec3 up = cross(dir, right);
+    mat3 orient = mat3(right, up, -dir);
+
+    vec4 worldPos = vec4(aInstancePos + orient * (aPos * kBulletScale), 1.0);
+    vs_out.FragPos = worldPos.xyz;
+    vs_out.Normal = orient * aNormal;
+    vs_out.TexCoords = aTexCoords;
+    vs_out.FragPosLightSpace = lightSpaceMatrix * worldPos;
+    gl_Position = projection * view * worldPos;
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+
 namespace plane::core
 {
     // Central place for resolution constants so window + camera stay in sync.
@@ -7,6 +9,37 @@ namespace plane::core
     {
         static constexpr unsigned int ScreenWidth = 1920;
         static constexpr unsigned int ScreenHeight = 1080;
+
+        // Fixed simulation rate; rendering runs as fast as the display allows and interpolates.
+        static constexpr float SimulationHz = 120.0f;
+        // Caps catch-up work after a hitch so a slow frame cannot snowball into a slower one.
+        static constexpr int MaxTicksPerFrame = 8;
+        static constexpr float MaxFrameTime = 0.25f;
+
+        // Seeds all procedural world content; the same seed always builds the same world.
+        // 0 picks a fresh world every launch, and then the terrain cache is not used.
+        static constexpr std::uint64_t WorldSeed = 0x2f6b1c93d4e85a17ull;
+        // Generated height fields and terrain meshes, keyed by seed, size and resolution.
+        static constexpr const char* TerrainCacheDirectory = "terrain_cache";
+        // Cooked elevation model (plane_demcook) to fly over instead of the procedural
+        // terrain; empty keeps the generator.
+        static constexpr const char* TerrainDemPath = "";
+
+        // Terrain chunks take the coarsest LOD whose error stays under this many pixels.
+        static constexpr float TerrainMaxPixelError = 2.0f;
+        // Streamed terrain tiles kept around each player, and the fixed pool they share;
+        // the pool holds both players' (2 * rings + 1)^2 tiles with room to spare.
+        static constexpr int TerrainTileRings = 2;
+        static constexpr int TerrainTilePoolSize = 64;
+
+        // Main-thread time per frame spent uploading streamed assets to the GPU.
+        static constexpr double AssetUploadBudgetSeconds = 0.004;
+        // Linked shader program binaries from earlier runs, keyed by source and driver.
+        static constexpr const char* ShaderCacheDirectory = "shader_cache";
+
+        // Written by the CPU profiler on F9 and at shutdown; open in chrome://tracing.
+        static constexpr const char* ProfileTracePath = "plane_trace.json";
+        // Every tick's input of the session, written at shutdown; plane_headless --replay plays it back.
+        static constexpr const char* ReplayPath = "plane_replay.rec";
     };
 }
-
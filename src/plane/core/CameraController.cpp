@@ -1,4 +1,5 @@
 #include "CameraController.h"
+#include "core/Profiler.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -29,6 +30,7 @@ namespace plane::core
 
     void CameraController::Update(const PlaneState& planeState, CameraRig& cameraRig, float deltaTime) const
     {
+        PLANE_PROFILE_SCOPE("CameraController::Update");
         // Camera follows plane's orientation (yaw, pitch, roll) to make plane appear static.
         constexpr float cameraDistance = 12.0f;
         constexpr float boostExtraDistance = 3.0f;
@@ -0,0 +1,195 @@
+#include "EntityRegistry.h"
+
+#include <cassert>
+
+namespace plane::core
+{
+    namespace
+    {
+        // Move the last element into 'index' and drop the tail.
+        template <typename T>
+        void SwapRemove(std::vector<T>& column, std::size_t index)
+        {
+            if (index + 1 != column.size())
+            {
+                column[index] = column.back();
+            }
+            column.pop_back();
+        }
+    }
+
+    EntityHandle EntityRegistry::Create(const PlaneState& initial)
+    {
+        const auto index = static_cast<std::uint32_t>(positions_.size());
+
+        std::uint32_t slot = freeSlot_;
+        if (slot != EntityHandle::InvalidSlot)
+        {
+            freeSlot_ = slots_[slot].index;
+        }
+        else
+        {
+            slot = static_cast<std::uint32_t>(slots_.size());
+            slots_.push_back(Slot{});
+        }
+        slots_[slot].index = index;
+
+        positions_.emplace_back();
+        orientations_.emplace_back();
+        speeds_.emplace_back();
+        healths_.emplace_back();
+        boosters_.emplace_back();
+        pilots_.emplace_back();
+        surfaces_.emplace_back();
+        tunings_.emplace_back();
+        denseToSlot_.push_back(slot);
+        Scatter(index, initial);
+
+        return EntityHandle { slot, slots_[slot].generation };
+    }
+
+    void EntityRegistry::Destroy(EntityHandle handle)
+    {
+        if (!IsValid(handle))
+        {
+            return;
+        }
+
+        const std::size_t index = slots_[handle.slot].index;
+        const std::uint32_t movedSlot = denseToSlot_.back();
+
+        SwapRemove(positions_, index);
+        SwapRemove(orientations_, index);
+        SwapRemove(speeds_, index);
+        SwapRemove(healths_, index);
+        SwapRemove(boosters_, index);
+        SwapRemove(pilots_, index);
+        SwapRemove(surfaces_, index);
+        SwapRemove(tunings_, index);
+        SwapRemove(denseToSlot_, index);
+        slots_[movedSlot].index = static_cast<std::uint32_t>(index);
+
+        Slot& freed = slots_[handle.slot];
+        ++freed.generation;
+        freed.index = freeSlot_;
+        freeSlot_ = handle.slot;
+    }
+
+    void EntityRegistry::Clear()
+    {
+        // Stale every outstanding handle, then thread all slots onto the free list.
+        for (std::uint32_t slot : denseToSlot_)
+        {
+            ++slots_[slot].generation;
+            slots_[slot].index = freeSlot_;
+            freeSlot_ = slot;
+        }
+
+        positions_.clear();
+        orientations_.clear();
+        speeds_.clear();
+        healths_.clear();
+        boosters_.clear();
+        pilots_.clear();
+        surfaces_.clear();
+        tunings_.clear();
+        denseToSlot_.clear();
+    }
+
+    void EntityRegistry::Reserve(std::size_t capacity)
+    {
+        positions_.reserve(capacity);
+        orientations_.reserve(capacity);
+        speeds_.reserve(capacity);
+        healths_.reserve(capacity);
+        boosters_.reserve(capacity);
+        pilots_.reserve(capacity);
+        surfaces_.reserve(capacity);
+        tunings_.reserve(capacity);
+        denseToSlot_.reserve(capacity);
+        slots_.reserve(capacity);
+    }
+
+    bool EntityRegistry::IsValid(EntityHandle handle) const
+    {
+        if (handle.slot >= slots_.size())
+        {
+            return false;
+        }
+        const Slot& slot = slots_[handle.slot];
+        return slot.generation == handle.generation
+            && slot.index < denseToSlot_.size()
+            && denseToSlot_[slot.index] == handle.slot;
+    }
+
+    EntityHandle EntityRegistry::HandleAt(std::size_t index) const
+    {
+        const std::uint32_t slot = denseToSlot_[index];
+        return EntityHandle { slot, slots_[slot].generation };
+    }
+
+    PlaneState EntityRegistry::Gather(std::size_t index) const
+    {
+        assert(index < Size());
+        const Orientation& orientation = orientations_[index];
+        const Speed& speed = speeds_[index];
+        const Health& health = healths_[index];
+        const BoosterState& booster = boosters_[index];
+        const PilotState& pilot = pilots_[index];
+        const ControlSurfaces& surfaces = surfaces_[index];
+        const PlaneTuning& tuning = tunings_[index];
+
+        PlaneState state;
+        state.position = positions_[index];
+        state.pitch = orientation.pitch;
+        state.yaw = orientation.yaw;
+        state.roll = orientation.roll;
+        state.baseSpeed = speed.base;
+        state.speed = speed.current;
+        state.health = health.points;
+        state.isAlive = health.alive;
+
+        state.boosterMaxFuelSeconds = tuning.boosterMaxFuelSeconds;
+        state.boosterRechargeSeconds = tuning.boosterRechargeSeconds;
+        state.boosterSpeedMultiplier = tuning.boosterSpeedMultiplier;
+        state.boosterRampUpSeconds = tuning.boosterRampUpSeconds;
+        state.boosterRampDownSeconds = tuning.boosterRampDownSeconds;
+
+        state.boosterFuelSeconds = booster.fuelSeconds;
+        state.boostHeld = booster.held;
+        state.isBoosting = booster.boosting;
+        state.boosterExhausted = booster.exhausted;
+
+        state.pitchInputTime = pilot.pitchInputTime;
+        state.rollInputTime = pilot.rollInputTime;
+
+        state.tailAngle = surfaces.tailAngle;
+        state.flapRAngle = surfaces.flapRAngle;
+        state.flapLAngle = surfaces.flapLAngle;
+        state.bladeAngle = surfaces.bladeAngle;
+
+        state.fireCooldown = pilot.fireCooldown;
+        state.fireRatePerSec = tuning.fireRatePerSec;
+        return state;
+    }
+
+    void EntityRegistry::Scatter(std::size_t index, const PlaneState& state)
+    {
+        assert(index < Size());
+        positions_[index] = state.position;
+        orientations_[index] = Orientation { state.pitch, state.yaw, state.roll };
+        speeds_[index] = Speed { state.baseSpeed, state.speed };
+        healths_[index] = Health { state.health, state.isAlive };
+        boosters_[index] = BoosterState { state.boosterFuelSeconds, state.boostHeld, state.isBoosting, state.boosterExhausted };
+        pilots_[index] = PilotState { state.pitchInputTime, state.rollInputTime, state.fireCooldown };
+        surfaces_[index] = ControlSurfaces { state.tailAngle, state.flapRAngle, state.flapLAngle, state.bladeAngle };
+        tunings_[index] = PlaneTuning {
+            state.boosterMaxFuelSeconds,
+            state.boosterRechargeSeconds,
+            state.boosterSpeedMultiplier,
+            state.boosterRampUpSeconds,
+            state.boosterRampDownSeconds,
+            state.fireRatePerSec
+        };
+    }
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "PlaneState.h"
+
+namespace plane::core
+{
+    // Stable reference to a registry entity. Stays valid while other entities are
+    // created and destroyed; goes stale (IsValid false) once its own entity is destroyed.
+    struct EntityHandle
+    {
+        static constexpr std::uint32_t InvalidSlot = 0xFFFFFFFFu;
+
+        std::uint32_t slot { InvalidSlot };
+        std::uint32_t generation { 0 };
+
+        bool IsNull() const { return slot == InvalidSlot; }
+        bool operator==(const EntityHandle& other) const { return slot == other.slot && generation == other.generation; }
+        bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    };
+
+    // Hot components: read or written by every plane every tick.
+    struct Orientation
+    {
+        float pitch { 0.0f };
+        float yaw { 0.0f };
+        float roll { 0.0f };
+    };
+
+    struct Speed
+    {
+        float base { 25.0f };     // Throttle setting (affected by collisions).
+        float current { 25.0f };  // Effective forward speed, including the booster.
+    };
+
+    struct Health
+    {
+        float points { 100.0f };
+        bool alive { true };
+    };
+
+    struct BoosterState
+    {
+        float fuelSeconds { 3.0f };
+        bool held { false };
+        bool boosting { false };
+        bool exhausted { false };
+    };
+
+    // Warm components: only piloted planes and presentation touch these.
+    struct PilotState
+    {
+        float pitchInputTime { 0.0f };
+        float rollInputTime { 0.0f };
+        float fireCooldown { 0.0f };
+    };
+
+    struct ControlSurfaces
+    {
+        float tailAngle { 0.0f };
+        float flapRAngle { 0.0f };
+        float flapLAngle { 0.0f };
+        float bladeAngle { 0.0f };
+    };
+
+    // Cold tuning constants, written at spawn and only read afterwards.
+    struct PlaneTuning
+    {
+        float boosterMaxFuelSeconds { 3.0f };
+        float boosterRechargeSeconds { 5.0f };
+        float boosterSpeedMultiplier { 5.0f };
+        float boosterRampUpSeconds { 0.5f };
+        float boosterRampDownSeconds { 0.5f };
+        float fireRatePerSec { 8.0f };
+    };
+
+    // Every plane in the match stored as structure-of-arrays: one densely packed
+    // column per component, so a system walking positions or speeds streams through
+    // contiguous memory instead of striding over whole PlaneStates. Dense indices
+    // [0, Size()) shift when entities are destroyed (the last entity fills the gap);
+    // hold an EntityHandle to refer to a particular plane across that.
+    //
+    // Columns may be written concurrently as long as no two threads touch the same
+    // index; Create, Destroy and Clear must not overlap with anything else.
+    class EntityRegistry
+    {
+    public:
+        EntityHandle Create(const PlaneState& initial = {});
+        void Destroy(EntityHandle handle);
+        void Clear();
+        void Reserve(std::size_t capacity);
+
+        bool IsValid(EntityHandle handle) const;
+        std::size_t Size() const { return positions_.size(); }
+
+        // Dense index of a valid handle, and back.
+        std::size_t IndexOf(EntityHandle handle) const { return slots_[handle.slot].index; }
+        EntityHandle HandleAt(std::size_t index) const;
+
+        // Assemble / write back the per-plane view used by controls, cameras and rendering.
+        PlaneState Gather(std::size_t index) const;
+        void Scatter(std::size_t index, const PlaneState& planeState);
+
+        std::vector<glm::vec3>& Positions() { return positions_; }
+        std::vector<Orientation>& Orientations() { return orientations_; }
+        std::vector<Speed>& Speeds() { return speeds_; }
+        std::vector<Health>& Healths() { return healths_; }
+        std::vector<BoosterState>& Boosters() { return boosters_; }
+        std::vector<PilotState>& Pilots() { return pilots_; }
+        std::vector<ControlSurfaces>& Surfaces() { return surfaces_; }
+        const std::vector<glm::vec3>& Positions() const { return positions_; }
+        const std::vector<Orientation>& Orientations() const { return orientations_; }
+        const std::vector<Speed>& Speeds() const { return speeds_; }
+        const std::vector<Health>& Healths() const { return healths_; }
+        const std::vector<BoosterState>& Boosters() const { return boosters_; }
+        const std::vector<PilotState>& Pilots() const { return pilots_; }
+        const std::vector<ControlSurfaces>& Surfaces() const { return surfaces_; }
+        const std::vector<PlaneTuning>& Tunings() const { return tunings_; }
+
+    private:
+        struct Slot
+        {
+            std::uint32_t index { 0 };       // Dense index while alive, next free slot otherwise.
+            std::uint32_t generation { 0 };  // Bumped on destroy so old handles go stale.
+        };
+
+        std::vector<glm::vec3> positions_;
+        std::vector<Orientation> orientations_;
+        std::vector<Speed> speeds_;
+        std::vector<Health> healths_;
+        std::vector<BoosterState> boosters_;
+        std::vector<PilotState> pilots_;
+        std::vector<ControlSurfaces> surfaces_;
+        std::vector<PlaneTuning> tunings_;
+
+        // Dense index -> owning slot, parallel to the columns.
+        std::vector<std::uint32_t> denseToSlot_;
+        std::vector<Slot> slots_;
+        std::uint32_t freeSlot_ { EntityHandle::InvalidSlot };
+    };
+}
@@ -0,0 +1,45 @@
+#include "Interpolation.h"
+
+#include <glm/glm.hpp>
+
+#include <cmath>
+
+namespace plane::core
+{
+    float InterpolateAngleDegrees(float previous, float current, float alpha)
+    {
+        float diff = std::fmod(current - previous, 360.0f);
+        if (diff > 180.0f) diff -= 360.0f;
+        if (diff < -180.0f) diff += 360.0f;
+        return previous + diff * alpha;
+    }
+
+    PlaneState InterpolatePlaneState(const PlaneState& previous, const PlaneState& current, float alpha)
+    {
+        // Start from the newest tick so discrete state (alive, boosting, health) is never stale.
+        PlaneState result = current;
+        result.position = glm::mix(previous.position, current.position, alpha);
+        result.pitch = InterpolateAngleDegrees(previous.pitch, current.pitch, alpha);
+        result.yaw = InterpolateAngleDegrees(previous.yaw, current.yaw, alpha);
+        result.roll = InterpolateAngleDegrees(previous.roll, current.roll, alpha);
+        result.speed = glm::mix(previous.speed, current.speed, alpha);
+        result.boosterFuelSeconds = glm::mix(previous.boosterFuelSeconds, current.boosterFuelSeconds, alpha);
+        result.tailAngle = glm::mix(previous.tailAngle, current.tailAngle, alpha);
+        result.flapRAngle = glm::mix(previous.flapRAngle, current.flapRAngle, alpha);
+        result.flapLAngle = glm::mix(previous.flapLAngle, current.flapLAngle, alpha);
+        result.bladeAngle = glm::radians(InterpolateAngleDegrees(glm::degrees(previous.bladeAngle), glm::degrees(current.bladeAngle), alpha));
+        return result;
+    }
+
+    CameraRig InterpolateCameraRig(const CameraRig& previous, const CameraRig& current, float alpha)
+    {
+        CameraRig result = current;
+        result.camera.Position = glm::mix(previous.camera.Position, current.camera.Position, alpha);
+
+        glm::vec3 front = glm::mix(previous.camera.Front, current.camera.Front, alpha);
+        glm::vec3 up = glm::mix(previous.camera.Up, current.camera.Up, alpha);
+        if (glm::length(front) > 0.0001f) result.camera.Front = glm::normalize(front);
+        if (glm::length(up) > 0.0001f) result.camera.Up = glm::normalize(up);
+        return result;
+    }
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "CameraRig.h"
+#include "PlaneState.h"
+
+namespace plane::core
+{
+    // Blend two simulation ticks for rendering. Angles take the shortest path so
+    // wrapped yaw/pitch (359 -> 1 degrees) do not spin the plane the long way round.
+    PlaneState InterpolatePlaneState(const PlaneState& previous, const PlaneState& current, float alpha);
+
+    // Chase camera pose blended the same way; zoom and mouse bookkeeping come from the newest tick.
+    CameraRig InterpolateCameraRig(const CameraRig& previous, const CameraRig& current, float alpha);
+
+    float InterpolateAngleDegrees(float previous, float current, float alpha);
+}
@@ -0,0 +1,240 @@
+#include "JobSystem.h"
+
+#include "Profiler.h"
+
+#include <algorithm>
+#include <string>
+
+namespace plane::core
+{
+    JobGraph::JobId JobGraph::Add(const char* name, std::function<void()> work)
+    {
+        Node node;
+        node.name = name;
+        node.work = std::move(work);
+        nodes_.push_back(std::move(node));
+        return static_cast<JobId>(nodes_.size() - 1);
+    }
+
+    void JobGraph::Precede(JobId before, JobId after)
+    {
+        nodes_[before].successors.push_back(after);
+        ++nodes_[after].dependencyCount;
+    }
+
+    void JobGraph::Clear()
+    {
+        nodes_.clear();
+    }
+
+    void JobGraph::ResetCounters()
+    {
+        if (pendingCapacity_ < nodes_.size())
+        {
+            pending_ = std::make_unique<std::atomic<std::uint32_t>[]>(nodes_.size());
+            pendingCapacity_ = nodes_.size();
+        }
+        for (std::size_t i = 0; i < nodes_.size(); ++i)
+        {
+            pending_[i].store(nodes_[i].dependencyCount, std::memory_order_relaxed);
+        }
+        remaining_.store(static_cast<std::uint32_t>(nodes_.size()), std::memory_order_relaxed);
+    }
+
+    void JobGraph::RunInline()
+    {
+        ResetCounters();
+
+        std::vector<JobId> ready;
+        for (JobId id = 0; id < nodes_.size(); ++id)
+        {
+            if (nodes_[id].dependencyCount == 0)
+                ready.push_back(id);
+        }
+
+        while (!ready.empty())
+        {
+            const JobId id = ready.back();
+            ready.pop_back();
+            {
+                PLANE_PROFILE_SCOPE(nodes_[id].name);
+                nodes_[id].work();
+            }
+            for (JobId next : nodes_[id].successors)
+            {
+                if (pending_[next].fetch_sub(1, std::memory_order_relaxed) == 1)
+                    ready.push_back(next);
+            }
+        }
+    }
+
+    JobSystem::JobSystem(unsigned workerCount)
+    {
+        queues_.reserve(workerCount + 1);
+        for (unsigned i = 0; i <= workerCount; ++i)
+        {
+            queues_.push_back(std::make_unique<WorkQueue>());
+        }
+
+        workers_.reserve(workerCount);
+        for (unsigned i = 1; i <= workerCount; ++i)
+        {
+            workers_.emplace_back(&JobSystem::WorkerLoop, this, i);
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            stopping_ = true;
+        }
+        wakeCondition_.notify_all();
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    unsigned JobSystem::DefaultWorkerCount()
+    {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        return (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+    }
+
+    void JobSystem::Run(JobGraph& graph)
+    {
+        if (graph.Size() == 0)
+        {
+            return;
+        }
+
+        graph.ResetCounters();
+        for (JobGraph::JobId id = 0; id < graph.Size(); ++id)
+        {
+            if (graph.nodes_[id].dependencyCount == 0)
+                Push(0, Task { &graph, id });
+        }
+
+        // Help out instead of sleeping; sim graphs are short enough that blocking
+        // on a condition variable would cost more than the jobs themselves.
+        while (graph.remaining_.load(std::memory_order_acquire) > 0)
+        {
+            if (!TryRunOne(0))
+                std::this_thread::yield();
+        }
+    }
+
+    void JobSystem::WorkerLoop(unsigned queueIndex)
+    {
+        const std::string threadName = "Job Worker " + std::to_string(queueIndex);
+        Profiler::SetThreadName(threadName.c_str());
+
+        // Sim graphs arrive every tick; spinning a little between them is far cheaper
+        // than a sleep/wake round trip through the condition variable.
+        constexpr int kSpinsBeforeSleep = 4096;
+
+        for (;;)
+        {
+            if (TryRunOne(queueIndex))
+                continue;
+
+            bool foundWork = false;
+            for (int spin = 0; spin < kSpinsBeforeSleep && !foundWork; ++spin)
+            {
+                foundWork = queuedTasks_.load(std::memory_order_acquire) > 0;
+                if (!foundWork)
+                    std::this_thread::yield();
+            }
+            if (foundWork)
+                continue;
+
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            sleepingWorkers_.fetch_add(1);
+            wakeCondition_.wait(lock, [this]
+            {
+                return stopping_ || queuedTasks_.load() > 0;
+            });
+            sleepingWorkers_.fetch_sub(1);
+            if (stopping_)
+                return;
+        }
+    }
+
+    void JobSystem::Push(unsigned queueIndex, const Task& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(queues_[queueIndex]->mutex);
+            queues_[queueIndex]->tasks.push_back(task);
+        }
+        // Sequentially consistent with the sleeper count: either the worker sees the
+        // new task before sleeping or we see it asleep and wake it.
+        queuedTasks_.fetch_add(1);
+
+        if (sleepingWorkers_.load() > 0)
+        {
+            // Taking the lock orders this notify after the worker's predicate check.
+            { std::lock_guard<std::mutex> lock(wakeMutex_); }
+            wakeCondition_.notify_one();
+        }
+    }
+
+    bool JobSystem::TryPop(unsigned queueIndex, Task& task)
+    {
+        WorkQueue& queue = *queues_[queueIndex];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty())
+            return false;
+
+        task = queue.tasks.back();
+        queue.tasks.pop_back();
+        return true;
+    }
+
+    bool JobSystem::TrySteal(unsigned thiefIndex, Task& task)
+    {
+        const std::size_t queueCount = queues_.size();
+        for (std::size_t offset = 1; offset < queueCount; ++offset)
+        {
+            WorkQueue& victim = *queues_[(thiefIndex + offset) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.empty())
+                continue;
+
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    bool JobSystem::TryRunOne(unsigned queueIndex)
+    {
+        Task task;
+        if (!TryPop(queueIndex, task) && !TrySteal(queueIndex, task))
+            return false;
+
+        queuedTasks_.fetch_sub(1, std::memory_order_acq_rel);
+        Execute(queueIndex, task);
+        return true;
+    }
+
+    void JobSystem::Execute(unsigned queueIndex, const Task& task)
+    {
+        JobGraph& graph = *task.graph;
+        const JobGraph::Node& node = graph.nodes_[task.id];
+        {
+            PLANE_PROFILE_SCOPE(node.name);
+            node.work();
+        }
+
+        // Newly unblocked successors go on this thread's queue so they run hot in cache.
+        for (JobGraph::JobId next : node.successors)
+        {
+            if (graph.pending_[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+                Push(queueIndex, Task { &graph, next });
+        }
+
+        graph.remaining_.fetch_sub(1, std::memory_order_acq_rel);
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace plane::core
+{
+    // A reusable set of jobs plus "must run before" edges. Build it once (e.g. the
+    // per-tick sim pipeline) and hand it to JobSystem::Run every tick; per-run
+    // bookkeeping is reset on each run so no allocation happens in steady state.
+    class JobGraph
+    {
+    public:
+        using JobId = std::uint32_t;
+
+        // name must be a string literal; it labels the job in profiler traces.
+        JobId Add(const char* name, std::function<void()> work);
+
+        // 'after' does not start until 'before' has finished.
+        void Precede(JobId before, JobId after);
+
+        void Clear();
+        std::size_t Size() const { return nodes_.size(); }
+
+        // Run every job on the calling thread in dependency order.
+        void RunInline();
+
+    private:
+        friend class JobSystem;
+
+        struct Node
+        {
+            const char* name { nullptr };
+            std::function<void()> work;
+            std::vector<JobId> successors;
+            std::uint32_t dependencyCount { 0 };
+        };
+
+        void ResetCounters();
+
+        std::vector<Node> nodes_;
+        std::unique_ptr<std::atomic<std::uint32_t>[]> pending_;
+        std::size_t pendingCapacity_ { 0 };
+        std::atomic<std::uint32_t> remaining_ { 0 };
+    };
+
+    // Fixed pool of worker threads, each with its own deque. A thread pops its own
+    // newest job first (cache-warm continuation of what it just ran) and, when empty,
+    // steals the oldest job from another queue. The thread calling Run helps execute
+    // until the graph drains, so a pool with zero workers degrades to serial execution.
+    class JobSystem
+    {
+    public:
+        explicit JobSystem(unsigned workerCount = DefaultWorkerCount());
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // One worker per hardware thread, leaving one for the caller.
+        static unsigned DefaultWorkerCount();
+        unsigned GetWorkerCount() const { return static_cast<unsigned>(workers_.size()); }
+
+        // Blocks until every job in the graph has run. Not reentrant: jobs must not
+        // call Run, and only one thread may drive the system at a time.
+        void Run(JobGraph& graph);
+
+    private:
+        struct Task
+        {
+            JobGraph* graph { nullptr };
+            JobGraph::JobId id { 0 };
+        };
+
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void WorkerLoop(unsigned queueIndex);
+        void Push(unsigned queueIndex, const Task& task);
+        bool TryPop(unsigned queueIndex, Task& task);
+        bool TrySteal(unsigned thiefIndex, Task& task);
+        bool TryRunOne(unsigned queueIndex);
+        void Execute(unsigned queueIndex, const Task& task);
+
+        // Queue 0 belongs to the thread calling Run; workers own 1..N.
+        std::vector<std::unique_ptr<WorkQueue>> queues_;
+        std::vector<std::thread> workers_;
+
+        std::mutex wakeMutex_;
+        std::condition_variable wakeCondition_;
+        std::atomic<std::uint32_t> queuedTasks_ { 0 };
+        std::atomic<std::uint32_t> sleepingWorkers_ { 0 };
+        bool stopping_ { false };
+    };
+}
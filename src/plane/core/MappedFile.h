@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace plane::core
+{
+    // Size and modification time of a file, used to tell whether something derived
+    // from it (a baked asset, a cache entry) is still current.
+    struct FileStamp
+    {
+        std::uint64_t size { 0 };
+        std::int64_t time { 0 };
+
+        bool operator==(const FileStamp& other) const { return size == other.size && time == other.time; }
+        bool operator!=(const FileStamp& other) const { return !(*this == other); }
+    };
+
+    // False if the file does not exist.
+    bool GetFileStamp(const std::string& path, FileStamp& stamp);
+
+    // Read-only memory mapping of a whole file. The OS pages it in on first touch,
+    // so opening is cheap no matter the size and nothing is copied up front.
+    class MappedFile
+    {
+    public:
+        MappedFile() = default;
+        ~MappedFile();
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False if the file is missing, empty or cannot be mapped.
+        bool Open(const std::string& path);
+        void Close();
+
+        bool IsOpen() const { return data_ != nullptr; }
+        const std::uint8_t* Data() const { return static_cast<const std::uint8_t*>(data_); }
+        std::size_t Size() const { return size_; }
+
+    private:
+        const void* data_ { nullptr };
+        std::size_t size_ { 0 };
+#ifdef _WIN32
+        void* file_ { nullptr };
+        void* mapping_ { nullptr };
+#endif
+    };
+}
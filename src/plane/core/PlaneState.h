@@ -4,7 +4,9 @@
 
 namespace plane::core
 {
-    // Mutable flight parameters the sim updates every frame.
+    // One plane's full state in a single struct, for code that works a plane at a
+    // time (piloted controls, cameras, rendering). The simulation itself stores
+    // these fields split into core::EntityRegistry columns; Gather/Scatter convert.
     struct PlaneState
     {
         glm::vec3 position { 100.0f, 26.0f, 0.0f };
@@ -40,6 +42,7 @@ namespace plane::core
         float tailAngle { 0.0f };   // Current tail rotation angle (radians)
         float flapRAngle { 0.0f };  // Current right flap angle (radians)
         float flapLAngle { 0.0f };  // Current left flap angle (radians)
+        float bladeAngle { 0.0f };  // Propeller spin angle (radians, wraps at 2*pi)
 
         // Firing cooldown state
         float fireCooldown { 0.0f };
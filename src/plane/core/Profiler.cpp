@@ -0,0 +1,152 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace plane::core
+{
+    namespace
+    {
+        // One per thread. Only the owning thread writes; the dump reads up to the
+        // published head, so a thread still recording may overwrite its oldest entries
+        // mid-dump. That is acceptable for a debugging aid.
+        struct ThreadBuffer
+        {
+            std::uint32_t threadId { 0 };
+            std::string name;
+            std::vector<Profiler::Event> events = std::vector<Profiler::Event>(Profiler::EventsPerThread);
+            std::atomic<std::uint64_t> head { 0 };
+        };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            // Buffers outlive their threads so late dumps still see finished workers.
+            std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+            std::atomic<bool> enabled { true };
+            const std::chrono::steady_clock::time_point epoch { std::chrono::steady_clock::now() };
+        };
+
+        Registry& GetRegistry()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        ThreadBuffer& GetThreadBuffer()
+        {
+            thread_local ThreadBuffer* buffer = []
+            {
+                auto& registry = GetRegistry();
+                std::lock_guard<std::mutex> lock(registry.mutex);
+                registry.buffers.push_back(std::make_unique<ThreadBuffer>());
+                ThreadBuffer* created = registry.buffers.back().get();
+                created->threadId = static_cast<std::uint32_t>(registry.buffers.size());
+                return created;
+            }();
+            return *buffer;
+        }
+
+        void WriteEscaped(std::ostream& out, const char* text)
+        {
+            for (const char* c = text; *c != '\0'; ++c)
+            {
+                if (*c == '"' || *c == '\\')
+                    out << '\\';
+                out << *c;
+            }
+        }
+    }
+
+    void Profiler::SetEnabled(bool enabled)
+    {
+        GetRegistry().enabled.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool Profiler::IsEnabled()
+    {
+        return GetRegistry().enabled.load(std::memory_order_relaxed);
+    }
+
+    void Profiler::SetThreadName(const char* name)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+        buffer.name = name;
+    }
+
+    std::uint64_t Profiler::NowNs()
+    {
+        const auto elapsed = std::chrono::steady_clock::now() - GetRegistry().epoch;
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+    void Profiler::Record(const char* name, std::uint64_t startNs, std::uint64_t endNs)
+    {
+        ThreadBuffer& buffer = GetThreadBuffer();
+        const std::uint64_t head = buffer.head.load(std::memory_order_relaxed);
+        Event& event = buffer.events[head % EventsPerThread];
+        event.name = name;
+        event.startNs = startNs;
+        event.durationNs = endNs - startNs;
+        buffer.head.store(head + 1, std::memory_order_release);
+    }
+
+    bool Profiler::WriteChromeTrace(const std::string& path)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+        {
+            return false;
+        }
+
+        auto& registry = GetRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+
+        // Chrome trace timestamps are microseconds; keep sub-microsecond precision.
+        out.setf(std::ios::fixed);
+        out.precision(3);
+
+        out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+        bool first = true;
+        auto separator = [&]()
+        {
+            if (!first)
+                out << ",\n";
+            first = false;
+        };
+
+        for (const auto& buffer : registry.buffers)
+        {
+            if (!buffer->name.empty())
+            {
+                separator();
+                out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"args\":{\"name\":\"";
+                WriteEscaped(out, buffer->name.c_str());
+                out << "\"}}";
+            }
+
+            const std::uint64_t head = buffer->head.load(std::memory_order_acquire);
+            const std::uint64_t count = (std::min)(head, static_cast<std::uint64_t>(EventsPerThread));
+            for (std::uint64_t i = head - count; i < head; ++i)
+            {
+                const Event& event = buffer->events[i % EventsPerThread];
+                separator();
+                out << "{\"name\":\"";
+                WriteEscaped(out, event.name);
+                out << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId
+                    << ",\"ts\":" << (event.startNs / 1000.0)
+                    << ",\"dur\":" << (event.durationNs / 1000.0) << "}";
+            }
+        }
+
+        out << "]}\n";
+        return static_cast<bool>(out);
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace plane::core
+{
+    // Lightweight CPU profiler. Each thread records completed zones into its own ring
+    // buffer; WriteChromeTrace dumps every buffer as chrome://tracing JSON where nested
+    // zones show up as a flame chart. Compile with PLANE_ENABLE_PROFILER to turn on the
+    // PLANE_PROFILE_SCOPE macro; without it zones compile away entirely.
+    class Profiler
+    {
+    public:
+        struct Event
+        {
+            const char* name { nullptr };
+            std::uint64_t startNs { 0 };
+            std::uint64_t durationNs { 0 };
+        };
+
+        static constexpr std::size_t EventsPerThread = 1u << 16;
+
+        // Runtime switch; zones still cost one relaxed load while disabled.
+        static void SetEnabled(bool enabled);
+        static bool IsEnabled();
+
+        // Label for the calling thread in the trace viewer.
+        static void SetThreadName(const char* name);
+
+        static std::uint64_t NowNs();
+        static void Record(const char* name, std::uint64_t startNs, std::uint64_t endNs);
+
+        // Writes the most recent events of every thread. Returns false if the file cannot be opened.
+        static bool WriteChromeTrace(const std::string& path);
+    };
+
+    // RAII zone; name must be a string literal (only the pointer is stored).
+    class ProfileScope
+    {
+    public:
+        explicit ProfileScope(const char* name)
+            : name_(Profiler::IsEnabled() ? name : nullptr)
+            , startNs_(name_ ? Profiler::NowNs() : 0)
+        {
+        }
+
+        ~ProfileScope()
+        {
+            if (name_)
+                Profiler::Record(name_, startNs_, Profiler::NowNs());
+        }
+
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        const char* name_;
+        std::uint64_t startNs_;
+    };
+}
+
+#define PLANE_PROFILE_CONCAT_INNER(a, b) a##b
+#define PLANE_PROFILE_CONCAT(a, b) PLANE_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PLANE_ENABLE_PROFILER
+#define PLANE_PROFILE_SCOPE(name) ::plane::core::ProfileScope PLANE_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+#else
+#define PLANE_PROFILE_SCOPE(name) ((void)0)
+#endif
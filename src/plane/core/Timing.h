@@ -3,10 +3,15 @@
 namespace plane::core
 {
     // Stores frame timing so multiple systems see identical deltaTime.
+    // deltaTime is the fixed simulation tick; frameTime is the wall-clock
+    // time between rendered frames that feeds the tick accumulator.
     struct TimingState
     {
         float deltaTime { 0.0f };
         float lastFrame { 0.0f };
+        float frameTime { 0.0f };
+        float accumulator { 0.0f };
+        // Fraction of a tick left in the accumulator, used to blend the last two ticks when rendering.
+        float interpolationAlpha { 0.0f };
     };
 }
-
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace plane::core
+{
+    // Single-producer/single-consumer handoff of whole values without locks. The
+    // writer fills Back() and calls Publish(); the reader calls Update() and then
+    // reads Front(), always getting the most recent complete value. Neither side
+    // ever waits on the other, and a slow reader simply skips intermediate values.
+    //
+    // Back() keeps whatever a previous publish left in that slot, so the writer must
+    // overwrite every field (assigning containers reuses their capacity).
+    template <typename T>
+    class TripleBuffer
+    {
+    public:
+        // Writer side.
+        T& Back() { return buffers_[backIndex_]; }
+
+        void Publish()
+        {
+            backIndex_ = state_.exchange(backIndex_ | kNewData, std::memory_order_acq_rel) & kIndexMask;
+        }
+
+        // Reader side. Returns true when Front() changed.
+        bool Update()
+        {
+            if ((state_.load(std::memory_order_relaxed) & kNewData) == 0)
+                return false;
+
+            frontIndex_ = state_.exchange(frontIndex_, std::memory_order_acq_rel) & kIndexMask;
+            return true;
+        }
+
+        const T& Front() const { return buffers_[frontIndex_]; }
+
+    private:
+        static constexpr unsigned kIndexMask = 0x3u;
+        static constexpr unsigned kNewData = 0x4u;
+
+        std::array<T, 3> buffers_ {};
+        unsigned backIndex_ { 0 };
+        unsigned frontIndex_ { 1 };
+        // Index of the middle slot, plus kNewData when it holds an unread publish.
+        std::atomic<unsigned> state_ { 2 };
+    };
+}
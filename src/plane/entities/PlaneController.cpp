@@ -1,4 +1,6 @@
+
 #include "PlaneController.h"
+#include "core/Profiler.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -12,22 +14,32 @@ namespace plane::entities
         constexpr float kTurnRate = 45.0f; // degrees per second at full roll (90 degrees)
     }
 
-    void PlaneController::UpdateFlightDynamics(core::PlaneState& planeState, float deltaTime) const
+    void PlaneController::UpdateFlightDynamics(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime) const
     {
-        // Bank angle feeds into yaw using sin(roll) for realistic turning
-        // Most effective at 90 degree roll, no turn at 0 degree roll
-        float rollRad = glm::radians(planeState.roll);
-        planeState.yaw -= std::sin(rollRad) * kTurnRate * deltaTime;
-        NormalizeYaw(planeState);
-
-        glm::vec3 forward = CalculateForwardVector(planeState);
-        planeState.position += forward * planeState.speed * deltaTime;
+        PLANE_PROFILE_SCOPE("PlaneController::UpdateFlightDynamics");
+        auto& orientations = registry.Orientations();
+        auto& positions = registry.Positions();
+        const auto& speeds = registry.Speeds();
+
+        for (std::size_t i = begin; i < end; ++i)
+        {
+            auto& orientation = orientations[i];
+
+            // Bank angle feeds into yaw using sin(roll) for realistic turning
+            // Most effective at 90 degree roll, no turn at 0 degree roll
+            float rollRad = glm::radians(orientation.roll);
+            orientation.yaw -= std::sin(rollRad) * kTurnRate * deltaTime;
+            NormalizeYaw(orientation);
+
+            glm::vec3 forward = CalculateForwardVector(orientation);
+            positions[i] += forward * speeds[i].current * deltaTime;
+        }
     }
 
-    glm::vec3 PlaneController::CalculateForwardVector(const core::PlaneState& planeState) const
+    glm::vec3 PlaneController::CalculateForwardVector(const core::Orientation& orientation) const
     {
-        float yawRad = glm::radians(planeState.yaw);
-        float pitchRad = glm::radians(planeState.pitch);
+        float yawRad = glm::radians(orientation.yaw);
+        float pitchRad = glm::radians(orientation.pitch);
 
         glm::vec3 forward(
             std::sin(yawRad) * std::cos(pitchRad),
@@ -38,10 +50,10 @@ namespace plane::entities
         return glm::normalize(forward);
     }
 
-    void PlaneController::NormalizeYaw(core::PlaneState& planeState) const
+    void PlaneController::NormalizeYaw(core::Orientation& orientation) const
     {
-        while (planeState.yaw < 0.0f) planeState.yaw += 360.0f;
-        while (planeState.yaw >= 360.0f) planeState.yaw -= 360.0f;
+        while (orientation.yaw < 0.0f) orientation.yaw += 360.0f;
+        while (orientation.yaw >= 360.0f) orientation.yaw -= 360.0f;
     }
 }
 
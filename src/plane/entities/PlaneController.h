@@ -1,22 +1,22 @@
 #pragma once
 
+#include <cstddef>
+
 #include <glm/glm.hpp>
 
-#include "core/PlaneState.h"
+#include "core/EntityRegistry.h"
 
 namespace plane::entities
 {
     class PlaneController
     {
     public:
-        void UpdateFlightDynamics(core::PlaneState& planeState, float deltaTime) const;
-        glm::vec3 CalculateForwardVector(const core::PlaneState& planeState) const;
+        // Bank-to-turn and forward motion for planes [begin, end) of the registry.
+        void UpdateFlightDynamics(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime) const;
+        glm::vec3 CalculateForwardVector(const core::Orientation& orientation) const;
 
     private:
-        void NormalizeYaw(core::PlaneState& planeState) const;
-        
-        // Track previous roll to calculate smooth derivative instead of using wrapped angle
-        mutable float previousRoll = 0.0f;
+        void NormalizeYaw(core::Orientation& orientation) const;
     };
 }
 
@@ -1,4 +1,5 @@
 #include "SkeletalAnimationSystem.h"
+#include "core/Profiler.h"
 
 #include <iostream>
 
@@ -12,6 +13,7 @@ namespace plane::features::animation
 
     void SkeletalAnimationSystem::Update(float /*deltaTime*/)
     {
+        PLANE_PROFILE_SCOPE("SkeletalAnimationSystem::Update");
         // TODO: Blend and upload pose matrices to shaders.
     }
 }
@@ -1,4 +1,5 @@
 #include "AdvancedMovementSystem.h"
+#include "core/Profiler.h"
 
 #include <iostream>
 
@@ -12,6 +13,7 @@ namespace plane::features::movement
 
     void AdvancedMovementSystem::Update(float /*deltaTime*/)
     {
+        PLANE_PROFILE_SCOPE("AdvancedMovementSystem::Update");
         // TODO: Apply smoothing, turbulence, and autopilot logic.
     }
 }
@@ -0,0 +1,138 @@
+#include "BoostTrailSystem.h"
+
+#include "core/PlaneState.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace plane::features::movement
+{
+    void BoostTrailSystem::Resize(std::size_t planeCount)
+    {
+        particles_.resize(planeCount);
+        emitAccumulator_.resize(planeCount, 0.0f);
+        const std::size_t seeded = rngState_.size();
+        rngState_.resize(planeCount);
+        for (std::size_t i = seeded; i < planeCount; ++i)
+        {
+            // Distinct per-plane streams; planes 0 and 1 keep their original seeds.
+            rngState_[i] = 0x12345678u + static_cast<std::uint32_t>(i) * 0x7530ECA9u;
+        }
+    }
+
+    void BoostTrailSystem::Clear()
+    {
+        for (auto &particles : particles_)
+        {
+            particles.clear();
+        }
+        std::fill(emitAccumulator_.begin(), emitAccumulator_.end(), 0.0f);
+    }
+
+    float BoostTrailSystem::NextFloat01(std::size_t planeIndex)
+    {
+        std::uint32_t &state = rngState_[planeIndex];
+        state = 1664525u * state + 1013904223u;
+        const std::uint32_t mantissa = (state >> 8) & 0x00FFFFFFu;
+        return static_cast<float>(mantissa) / static_cast<float>(0x01000000u);
+    }
+
+    glm::vec3 BoostTrailSystem::CalculateForwardVector(const core::PlaneState &planeState) const
+    {
+        float yawRad = glm::radians(planeState.yaw);
+        float pitchRad = glm::radians(planeState.pitch);
+
+        glm::vec3 forward(
+            std::sin(yawRad) * std::cos(pitchRad),
+            -std::sin(pitchRad),
+            std::cos(yawRad) * std::cos(pitchRad));
+
+        float len = glm::length(forward);
+        if (len <= 0.0001f)
+        {
+            return glm::vec3(0.0f, 0.0f, 1.0f);
+        }
+        return forward / len;
+    }
+
+    void BoostTrailSystem::UpdateForPlane(const core::PlaneState &planeState, float deltaTime, std::size_t planeIndex)
+    {
+        PLANE_PROFILE_SCOPE("BoostTrailSystem::UpdateForPlane");
+        const float dt = (std::max)(0.0f, deltaTime);
+        auto &particles = particles_[planeIndex];
+
+        for (auto &p : particles)
+        {
+            p.position += p.velocity * dt;
+            p.remaining -= dt;
+        }
+
+        particles.erase(
+            std::remove_if(
+                particles.begin(),
+                particles.end(),
+                [](const BoostParticle &p)
+                { return p.remaining <= 0.0f; }),
+            particles.end());
+
+        if (!planeState.isAlive)
+        {
+            return;
+        }
+
+        // Emit particles while boosting.
+        if (planeState.isBoosting)
+        {
+            constexpr float emitRatePerSecond = 55.0f;
+            emitAccumulator_[planeIndex] += emitRatePerSecond * dt;
+            int toEmit = static_cast<int>(emitAccumulator_[planeIndex]);
+            emitAccumulator_[planeIndex] -= static_cast<float>(toEmit);
+
+            glm::vec3 forward = CalculateForwardVector(planeState);
+            glm::vec3 up(0.0f, 1.0f, 0.0f);
+            glm::vec3 right = glm::normalize(glm::cross(up, forward));
+            if (glm::length(right) < 0.001f)
+            {
+                right = glm::vec3(1.0f, 0.0f, 0.0f);
+            }
+
+            // Slightly behind the plane.
+            const glm::vec3 baseSpawn = planeState.position - forward * 2.4f + up * 0.2f;
+
+            for (int i = 0; i < toEmit; ++i)
+            {
+                BoostParticle p;
+                float side = (NextFloat01(planeIndex) - 0.5f) * 0.9f;
+                float vertical = (NextFloat01(planeIndex) - 0.5f) * 0.4f;
+                p.position = baseSpawn + right * side + up * vertical;
+
+                float speed = (std::max)(20.0f, planeState.speed);
+                glm::vec3 jitter = right * ((NextFloat01(planeIndex) - 0.5f) * 3.0f) + up * (NextFloat01(planeIndex) * 1.5f);
+                p.velocity = (-forward * (speed * 0.6f)) + jitter;
+
+                p.lifetime = 0.25f + NextFloat01(planeIndex) * 0.20f;
+                p.remaining = p.lifetime;
+                p.size = 10.0f + NextFloat01(planeIndex) * 10.0f;
+
+                // Cool blue/white trail.
+                p.color = glm::vec3(0.3f, 0.8f, 1.0f);
+                particles.push_back(p);
+            }
+        }
+        else
+        {
+            // Keep accumulator stable when not boosting.
+            emitAccumulator_[planeIndex] = 0.0f;
+        }
+    }
+
+    void BoostTrailSystem::CollectParticles(std::vector<BoostParticle> &out) const
+    {
+        out.clear();
+        for (const auto &perPlane : particles_)
+        {
+            out.insert(out.end(), perPlane.begin(), perPlane.end());
+        }
+    }
+}
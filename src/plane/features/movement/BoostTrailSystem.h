@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace plane::core
+{
+    struct PlaneState;
+}
+
+namespace plane::features::movement
+{
+    struct BoostParticle
+    {
+        glm::vec3 position;
+        glm::vec3 velocity;
+        glm::vec3 color;
+        float lifetime;
+        float remaining;
+        float size;
+    };
+
+    // Emits and ages the exhaust particles behind boosting planes. Pure CPU state;
+    // render::BoostTrailRenderer draws whatever CollectParticles hands it.
+    class BoostTrailSystem
+    {
+    public:
+        // Allocates per-plane emitters; call before the first UpdateForPlane.
+        void Resize(std::size_t planeCount);
+        void Clear();
+
+        // Each plane index touches only its own particles, so planes may update concurrently.
+        void UpdateForPlane(const core::PlaneState& planeState, float deltaTime, std::size_t planeIndex);
+
+        // Replaces 'out' with every live particle.
+        void CollectParticles(std::vector<BoostParticle>& out) const;
+
+    private:
+        float NextFloat01(std::size_t planeIndex);
+        glm::vec3 CalculateForwardVector(const core::PlaneState& planeState) const;
+
+        std::vector<std::vector<BoostParticle>> particles_;
+        std::vector<float> emitAccumulator_;
+        std::vector<std::uint32_t> rngState_;
+    };
+}
@@ -1,6 +1,7 @@
 #include "BoosterSystem.h"
 
-#include "core/PlaneState.h"
+#include "core/EntityRegistry.h"
+#include "core/Profiler.h"
 
 #include <algorithm>
 #include <cmath>
@@ -18,59 +19,72 @@ namespace plane::features::movement
         }
     }
 
-    void BoosterSystem::Update(core::PlaneState& planeState, float deltaTime) const
+    void BoosterSystem::Update(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime) const
     {
-        if (!planeState.isAlive)
+        PLANE_PROFILE_SCOPE("BoosterSystem::Update");
+        auto& boosters = registry.Boosters();
+        auto& speeds = registry.Speeds();
+        const auto& healths = registry.Healths();
+        const auto& tunings = registry.Tunings();
+
+        for (std::size_t i = begin; i < end; ++i)
         {
-            planeState.isBoosting = false;
-            planeState.speed = planeState.baseSpeed;
-            return;
-        }
+            auto& booster = boosters[i];
+            auto& speed = speeds[i];
+            const auto& tuning = tunings[i];
 
-        const float maxFuel = (std::max)(0.0f, planeState.boosterMaxFuelSeconds);
-        const float rechargeSeconds = (std::max)(0.001f, planeState.boosterRechargeSeconds);
+            if (!healths[i].alive)
+            {
+                booster.boosting = false;
+                speed.current = speed.base;
+                continue;
+            }
 
-        planeState.boosterFuelSeconds = (std::clamp)(planeState.boosterFuelSeconds, 0.0f, maxFuel);
+            const float maxFuel = (std::max)(0.0f, tuning.boosterMaxFuelSeconds);
+            const float rechargeSeconds = (std::max)(0.001f, tuning.boosterRechargeSeconds);
 
-        bool canBoost = !planeState.boosterExhausted && (maxFuel > 0.0f) && (planeState.boosterFuelSeconds > 0.0f);
-        bool shouldBoost = planeState.boostHeld && canBoost;
+            booster.fuelSeconds = (std::clamp)(booster.fuelSeconds, 0.0f, maxFuel);
 
-        if (shouldBoost)
-        {
-            planeState.isBoosting = true;
-            planeState.boosterFuelSeconds = (std::max)(0.0f, planeState.boosterFuelSeconds - (std::max)(0.0f, deltaTime));
+            bool canBoost = !booster.exhausted && (maxFuel > 0.0f) && (booster.fuelSeconds > 0.0f);
+            bool shouldBoost = booster.held && canBoost;
 
-            if (planeState.boosterFuelSeconds <= 0.0f)
+            if (shouldBoost)
             {
-                planeState.boosterFuelSeconds = 0.0f;
-                planeState.isBoosting = false;
-                planeState.boosterExhausted = true;
-            }
-        }
-        else
-        {
-            planeState.isBoosting = false;
+                booster.boosting = true;
+                booster.fuelSeconds = (std::max)(0.0f, booster.fuelSeconds - (std::max)(0.0f, deltaTime));
 
-            if (maxFuel > 0.0f && planeState.boosterFuelSeconds < maxFuel)
-            {
-                const float rechargeRate = maxFuel / rechargeSeconds;
-                planeState.boosterFuelSeconds = (std::min)(maxFuel, planeState.boosterFuelSeconds + rechargeRate * (std::max)(0.0f, deltaTime));
+                if (booster.fuelSeconds <= 0.0f)
+                {
+                    booster.fuelSeconds = 0.0f;
+                    booster.boosting = false;
+                    booster.exhausted = true;
+                }
             }
-
-            if (planeState.boosterExhausted && planeState.boosterFuelSeconds >= maxFuel)
+            else
             {
-                planeState.boosterFuelSeconds = maxFuel;
-                planeState.boosterExhausted = false;
+                booster.boosting = false;
+
+                if (maxFuel > 0.0f && booster.fuelSeconds < maxFuel)
+                {
+                    const float rechargeRate = maxFuel / rechargeSeconds;
+                    booster.fuelSeconds = (std::min)(maxFuel, booster.fuelSeconds + rechargeRate * (std::max)(0.0f, deltaTime));
+                }
+
+                if (booster.exhausted && booster.fuelSeconds >= maxFuel)
+                {
+                    booster.fuelSeconds = maxFuel;
+                    booster.exhausted = false;
+                }
             }
-        }
 
-        const float multiplier = planeState.isBoosting ? (std::max)(1.0f, planeState.boosterSpeedMultiplier) : 1.0f;
-        const float targetSpeed = (std::max)(0.0f, planeState.baseSpeed * multiplier);
+            const float multiplier = booster.boosting ? (std::max)(1.0f, tuning.boosterSpeedMultiplier) : 1.0f;
+            const float targetSpeed = (std::max)(0.0f, speed.base * multiplier);
 
-        const float rampSeconds = planeState.isBoosting
-            ? (std::max)(0.001f, planeState.boosterRampUpSeconds)
-            : (std::max)(0.001f, planeState.boosterRampDownSeconds);
+            const float rampSeconds = booster.boosting
+                ? (std::max)(0.001f, tuning.boosterRampUpSeconds)
+                : (std::max)(0.001f, tuning.boosterRampDownSeconds);
 
-        planeState.speed = ExponentialApproach(planeState.speed, targetSpeed, deltaTime, rampSeconds);
+            speed.current = ExponentialApproach(speed.current, targetSpeed, deltaTime, rampSeconds);
+        }
     }
 }
@@ -1,9 +1,10 @@
 #pragma once
 
+#include <cstddef>
 
 namespace plane::core
 {
-    struct PlaneState;
+    class EntityRegistry;
 }
 
 namespace plane::features::movement
@@ -11,7 +12,8 @@ namespace plane::features::movement
     class BoosterSystem
     {
     public:
-        void Update(core::PlaneState& planeState, float deltaTime) const;
+        // Burns or recharges fuel and ramps speed for planes [begin, end) of the registry.
+        void Update(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime) const;
     };
 }
 
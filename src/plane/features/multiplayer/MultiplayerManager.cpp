@@ -1,4 +1,5 @@
 #include "MultiplayerManager.h"
+#include "core/Profiler.h"
 
 #include <iostream>
 
@@ -12,6 +13,7 @@ namespace plane::features::multiplayer
 
     void MultiplayerManager::Update(float /*deltaTime*/)
     {
+        PLANE_PROFILE_SCOPE("MultiplayerManager::Update");
         // TODO: Pump network events and drive multi-view rendering.
     }
 }
@@ -1,80 +1,88 @@
 #include "ShootingSystem.h"
 
-#include <glad/glad.h>
-
-#include <learnopengl/shader_m.h>
-#include <learnopengl/model.h>
-#include <learnopengl/filesystem.h>
-
 #include <glm/gtc/matrix_transform.hpp>
 
+#include "core/EntityRegistry.h"
 #include "core/PlaneState.h"
+#include "core/Profiler.h"
+#include "world/HeightField.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 namespace plane::features::shooting
 {
     namespace
     {
-        constexpr float kBulletSpeed = 160.0f;  // units per second
-        constexpr float kBulletLifetime = 3.0f;
+        // Tuned back when bullets advanced once per plane per tick (twice with two
+        // players); doubled/halved so speed and range stay the same now that they
+        // advance once per tick.
+        constexpr float kBulletSpeed = 320.0f;  // units per second
+        constexpr float kBulletLifetime = 1.5f;
         constexpr float kBulletDamage = 5.0f;   // Damage per bullet hit
         constexpr float kPlaneCollisionRadius = 3.0f;  // Plane's collision radius
     }
 
     void ShootingSystem::Initialize()
     {
-        // Load bullet model once
-        bulletModel_ = std::make_unique<Model>(FileSystem::getPath("resources/objects/bullet/Bullet.dae"));
-    }
-
-    void ShootingSystem::InitializeGeometry()
-    {
-        // No-op: model-based rendering now
+        // Bullets are pure simulation state; render::BulletRenderer owns the model.
+        bullets_.clear();
+        groundHits_.clear();
     }
 
-    void ShootingSystem::Update(float deltaTime, core::PlaneState& planeState)
+    void ShootingSystem::Update(float deltaTime, core::EntityRegistry& registry)
     {
+        PLANE_PROFILE_SCOPE("ShootingSystem::Update");
+        groundHits_.clear();
         if (bullets_.empty())
         {
             return;
         }
 
-        // Track which bullets hit the plane
-        std::vector<size_t> bulletsToRemove;
+        const auto& positions = registry.Positions();
+        auto& healths = registry.Healths();
 
-        for (size_t i = 0; i < bullets_.size(); ++i)
+        for (auto& bullet : bullets_)
         {
-            auto& bullet = bullets_[i];
             bullet.position += bullet.velocity * deltaTime;
             bullet.lifetime -= deltaTime;
 
-            // Check collision with plane
-            if (planeState.isAlive && CheckBulletPlaneCollision(bullet, planeState))
+            // The ground stops a bullet before it can reach a plane beyond.
+            if (heightField_ && bullet.position.y <= heightField_->GetHeightAt(bullet.position.x, bullet.position.z))
             {
+                groundHits_.push_back(bullet.position);
+                bullet.lifetime = 0.0f;
+                continue;
+            }
+
+            // Check collision against every live plane; a bullet is spent on its first hit.
+            for (std::size_t i = 0; i < positions.size(); ++i)
+            {
+                auto& health = healths[i];
+                if (!health.alive || !CheckBulletPlaneCollision(bullet, positions[i]))
+                {
+                    continue;
+                }
+
                 // Apply damage to plane
-                planeState.health -= kBulletDamage;
-                std::cout << "Plane hit! Health: " << planeState.health << std::endl;
+                health.points -= kBulletDamage;
+                std::cout << "Plane hit! Health: " << health.points << std::endl;
                 
-                if (planeState.health <= 0.0f)
+                if (health.points <= 0.0f)
                 {
-                    planeState.health = 0.0f;
-                    planeState.isAlive = false;
+                    health.points = 0.0f;
+                    health.alive = false;
                     std::cout << "Plane destroyed!" << std::endl;
                 }
                 
                 // Mark bullet for removal
-                bulletsToRemove.push_back(i);
+                bullet.lifetime = 0.0f;
+                break;
             }
         }
 
-        // Remove bullets that hit the plane (iterate backwards to maintain indices)
-        for (auto it = bulletsToRemove.rbegin(); it != bulletsToRemove.rend(); ++it)
-        {
-            bullets_.erase(bullets_.begin() + *it);
-        }
-
-        // Remove bullets whose lifetime expired.
+        // Remove bullets that hit a plane or the ground, or whose lifetime expired.
         bullets_.erase(
             std::remove_if(
                 bullets_.begin(),
@@ -84,15 +92,20 @@ namespace plane::features::shooting
         );
     }
 
-    bool ShootingSystem::CheckBulletPlaneCollision(const Bullet& bullet, const core::PlaneState& planeState) const
+    bool ShootingSystem::CheckBulletPlaneCollision(const Bullet& bullet, const glm::vec3& planePosition) const
     {
         // Simple sphere-sphere collision detection
-        float distance = glm::length(bullet.position - planeState.position);
+        float distance = glm::length(bullet.position - planePosition);
         float combinedRadius = bullet.radius + kPlaneCollisionRadius;
         return distance <= combinedRadius;
     }
 
     void ShootingSystem::FireBullet(const core::PlaneState& planeState)
+    {
+        AddBullet(CreateBullet(planeState));
+    }
+
+    Bullet ShootingSystem::CreateBullet(const core::PlaneState& planeState) const
     {
         // Reconstruct the forward vector similarly to PlaneController.
         float yawRad = glm::radians(planeState.yaw);
@@ -114,47 +127,12 @@ namespace plane::features::shooting
         bullet.velocity = forward * kBulletSpeed;
         bullet.radius = 0.5f;
         bullet.lifetime = kBulletLifetime;
-
-        bullets_.push_back(bullet);
+        return bullet;
     }
 
-    void ShootingSystem::Render(Shader& shader) const
+    void ShootingSystem::AddBullet(const Bullet& bullet)
     {
-        if (bullets_.empty() || !bulletModel_)
-        {
-            return;
-        }
-
-        for (const auto& bullet : bullets_)
-        {
-            glm::mat4 model = glm::mat4(1.0f);
-            model = glm::translate(model, bullet.position);
-
-            // Align the model with the velocity direction.
-            glm::vec3 dir = glm::normalize(bullet.velocity);
-            if (glm::length(dir) < 0.0001f)
-            {
-                dir = glm::vec3(0.0f, 0.0f, -1.0f);
-            }
-
-            glm::vec3 worldUp(0.0f, 1.0f, 0.0f);
-            glm::vec3 right = glm::normalize(glm::cross(worldUp, dir));
-            glm::vec3 up = glm::cross(dir, right);
-
-            glm::mat4 orient(1.0f);
-            orient[0] = glm::vec4(right, 0.0f);
-            orient[1] = glm::vec4(up, 0.0f);
-            orient[2] = glm::vec4(-dir, 0.0f);
-
-            model *= orient;
-
-            // Adjust model scale .
-            model = glm::scale(model, glm::vec3(0.25f));
-
-            shader.setMat4("model", model);
-            bulletModel_->Draw(shader);
-        }
+        bullets_.push_back(bullet);
     }
 }
 
-
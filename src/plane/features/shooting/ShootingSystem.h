@@ -2,18 +2,21 @@
 
 #include <glm/glm.hpp>
 
-#include <memory>
+#include <cstddef>
 #include <vector>
 
-class Shader;
-class Model;
-
 namespace plane
 {
     namespace core
     {
+        class EntityRegistry;
         struct PlaneState;
     }
+
+    namespace world
+    {
+        class HeightField;
+    }
 }
 
 namespace plane::features::shooting
@@ -32,25 +35,34 @@ namespace plane::features::shooting
     public:
         void Initialize();
 
-        // Advance all active bullets and prune expired ones.
-        // Now also checks for bullet-plane collisions and applies damage.
-        void Update(float deltaTime, core::PlaneState& planeState);
+        // Bullets that reach this terrain are spent there; null lets them fly through.
+        void SetHeightField(const world::HeightField* heightField) { heightField_ = heightField; }
+
+        // Advance all active bullets once, apply damage to every plane in the registry
+        // they hit, and prune spent ones.
+        void Update(float deltaTime, core::EntityRegistry& registry);
+
+        // Where bullets struck the terrain during the last Update, in bullet order.
+        const std::vector<glm::vec3>& GetGroundHits() const { return groundHits_; }
 
         // Spawn a new bullet travelling along the aircraft's forward vector.
         void FireBullet(const core::PlaneState& planeState);
 
-        // Render all active bullets as small triangles. Caller must have
-        // projection/view set on the shader before calling.
-        void Render(Shader& shader) const;
+        // FireBullet split in two so per-plane jobs can build bullets in parallel
+        // and hand them over to AddBullet in a fixed order.
+        Bullet CreateBullet(const core::PlaneState& planeState) const;
+        void AddBullet(const Bullet& bullet);
+
+        // Active bullets, for render::BulletRenderer and snapshots.
+        const std::vector<Bullet>& GetBullets() const { return bullets_; }
 
     private:
-        void InitializeGeometry();
-        
-        // Check if a bullet collides with the plane (sphere-sphere collision)
-        bool CheckBulletPlaneCollision(const Bullet& bullet, const core::PlaneState& planeState) const;
+        // Check if a bullet collides with a plane at planePosition (sphere-sphere collision)
+        bool CheckBulletPlaneCollision(const Bullet& bullet, const glm::vec3& planePosition) const;
 
         std::vector<Bullet> bullets_;
-        std::unique_ptr<Model> bulletModel_;
+        std::vector<glm::vec3> groundHits_;
+        const world::HeightField* heightField_ { nullptr };
     };
 }
 
@@ -5,8 +5,13 @@ layout (location = 1) in vec2 aTexCoords;
 out vec3 WorldPos;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
+
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
 
 void main()
 {
@@ -0,0 +1,213 @@
+#include "FlightControls.h"
+#include "core/Profiler.h"
+
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+
+#include <cmath>
+
+namespace plane::input
+{
+    namespace
+    {
+        constexpr float kMinRotationSpeed = 10.0f;  // Starting speed
+        constexpr float kMaxRotationSpeed = 80.0f;  // Maximum speed for roll
+        constexpr float kMaxRotationSpeed_pitch = 40.0f;  // Maximum speed for pitch
+        constexpr float kRotationAccelTime = 1.5f;  // Time to reach max speed (seconds)
+        constexpr float kAcceleration = 15.0f;  // units per second^2
+
+        // Control surface limits and speeds
+        constexpr float kMaxTailAngleDeg = 45.0f;     // degrees
+        constexpr float kMaxFlapAngleDeg = 45.0f;     // degrees (down)
+        constexpr float kTailMoveSpeedDeg = 45.0f;    // degrees per second
+        constexpr float kFlapMoveSpeedDeg = 45.0f;    // degrees per second
+
+        inline float MoveTowards(float current, float target, float maxDelta)
+        {
+            float delta = target - current;
+            if (std::abs(delta) <= maxDelta) return target;
+            return current + std::copysign(maxDelta, delta);
+        }
+    }
+
+    void FlightControls::Apply(const PlayerInput& input, core::PlaneState& planeState, float deltaTime) const
+    {
+        PLANE_PROFILE_SCOPE("FlightControls::Apply");
+        // Directly map keyboard input to Euler adjustments / throttle.
+        // Store rotation deltas
+        float pitchDelta = 0.0f;
+        float yawDelta = 0.0f;
+        float rollDelta = 0.0f;
+        
+        // For polling data from the Dualsense controller
+
+        // Track pitch input and calculate speed
+        bool pitchInputActive = false;
+        if (input.IsDown(PlayerInput::PitchUp) || input.hasController)
+        {
+            pitchInputActive = true;
+            planeState.pitchInputTime += deltaTime;
+            float t = glm::clamp(planeState.pitchInputTime / kRotationAccelTime, 0.0f, 1.0f);
+            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed_pitch, t);
+            if (!input.hasController) {
+                pitchDelta += currentSpeed * deltaTime;
+            }
+            else  {
+                if(input.analogLeftY <= 0x75 || input.analogLeftY >= 0x85 )
+                    pitchDelta += currentSpeed * deltaTime * ((((input.analogLeftY) / 255.0)-0.5)*-2.0);
+            }
+        }
+        if (input.IsDown(PlayerInput::PitchDown))
+        {
+            pitchInputActive = true;
+            planeState.pitchInputTime += deltaTime;
+            float t = glm::clamp(planeState.pitchInputTime / kRotationAccelTime, 0.0f, 1.0f);
+            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed_pitch, t);
+            pitchDelta -= currentSpeed * deltaTime;
+        }
+        if (!pitchInputActive)
+            planeState.pitchInputTime = 0.0f;
+
+        // Track roll input and calculate speed
+        bool rollInputActive = false;
+        if (input.IsDown(PlayerInput::RollRight) || input.hasController)
+        {
+            rollInputActive = true;
+            planeState.rollInputTime += deltaTime;
+            float t = glm::clamp(planeState.rollInputTime / kRotationAccelTime, 0.0f, 1.0f);
+            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed, t);
+
+            if (!input.hasController) {
+                rollDelta += currentSpeed * deltaTime;
+            }
+            else {
+                //if (input.analogRightX <= 0x75 || input.analogRightX >= 0x85)
+                    rollDelta += currentSpeed * deltaTime * ((((input.analogRightX) / 255.0) - 0.5) * 2.0);
+            }
+        }
+        if (input.IsDown(PlayerInput::RollLeft))
+        {
+            rollInputActive = true;
+            planeState.rollInputTime += deltaTime;
+            float t = glm::clamp(planeState.rollInputTime / kRotationAccelTime, 0.0f, 1.0f);
+            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed, t);
+            rollDelta -= currentSpeed * deltaTime;
+        }
+        if (input.IsDown(PlayerInput::ThrottleUp))
+            planeState.speed += kAcceleration * deltaTime;
+        if (input.IsDown(PlayerInput::ThrottleDown))
+            planeState.speed -= kAcceleration * deltaTime;
+
+        if (!rollInputActive)
+            planeState.rollInputTime = 0.0f;
+
+        // Apply roll directly
+        planeState.roll += rollDelta;
+        
+        // Apply pitch and yaw with roll compensation
+        // When rolled, pitch input should affect both pitch and yaw
+        float rollRad = glm::radians(planeState.roll);
+         
+        // Reduce pitch effect as roll approaches ±90°
+        // Use max(0.1, cos(abs(roll))) to clamp minimum at 0.1
+        float cosAbsRoll = std::abs(std::cos(rollRad));
+        float pitchDamping = (cosAbsRoll > 0.1f) ? cosAbsRoll : 0.1f;
+        float dampedPitchDelta = pitchDelta * pitchDamping;
+        
+        planeState.pitch += dampedPitchDelta * std::cos(rollRad);
+        planeState.yaw += dampedPitchDelta * std::sin(rollRad);
+
+        // if (planeState.pitch > 89.0f) planeState.pitch = 89.0f;
+        // if (planeState.pitch < -89.0f) planeState.pitch = -89.0f;
+
+        while (planeState.yaw < 0.0f) planeState.yaw += 360.0f;
+        while (planeState.yaw >= 360.0f) planeState.yaw -= 360.0f;
+        while (planeState.pitch < 0.0f) planeState.pitch += 360.0f;
+        while (planeState.pitch >= 360.0f) planeState.pitch -= 360.0f;
+        // while (planeState.roll < 0.0f) planeState.roll += 360.0f;
+        // while (planeState.roll >= 360.0f) planeState.roll -= 360.0f;
+
+        // if (planeState.roll > 90.0f) planeState.roll = 90.0f;
+        // if (planeState.roll < -90.0f) planeState.roll = -90.0f;
+
+        if (input.IsDown(PlayerInput::ThrottleUp))
+            planeState.baseSpeed += kAcceleration * deltaTime;
+        if (input.IsDown(PlayerInput::ThrottleDown))
+            planeState.baseSpeed -= kAcceleration * deltaTime;
+
+        if (planeState.speed < 25.0f) planeState.speed = 25.0f;
+        if (planeState.speed > 50.0f) planeState.speed = 50.0f;
+
+        // Control-surface animation targets (radians).
+        float tailTarget = 0.0f;
+        float flapRTarget = 0.0f;
+        float flapLTarget = 0.0f;
+        if (!input.hasController){
+            // Targets (radians)
+            if (input.IsDown(PlayerInput::TailUp))
+                tailTarget = glm::radians(kMaxTailAngleDeg);    // up to +30°
+            else if (input.IsDown(PlayerInput::TailDown))
+                tailTarget = glm::radians(-kMaxTailAngleDeg);   // down to -30°
+
+            if (input.IsDown(PlayerInput::FlapLeftDown))
+                flapRTarget = glm::radians(-kMaxFlapAngleDeg);  // right flap down 30°
+
+            if (input.IsDown(PlayerInput::FlapRightDown))
+                flapLTarget = glm::radians(-kMaxFlapAngleDeg);  // left flap down 30°
+        }
+        else {
+            // handle tail
+            if (input.analogLeftY <= 0x75 || input.analogLeftY >= 0x85) {
+                float mappedTailAngle = ((input.analogLeftY/255.0)*90.0)-45.0;
+                tailTarget = glm::radians(kMaxTailAngleDeg);
+            }
+            // handle flaps with right stick X: >0x7F left flap down, <0x7F right flap down
+            if (input.analogRightX > 0x7F) {
+                float t = (input.analogRightX - 0x7F) / static_cast<float>(0xFF - 0x7F);
+                t = glm::clamp(t, 0.0f, 1.0f);
+                flapLTarget = glm::radians(-kMaxFlapAngleDeg * t);
+            }
+            else if (input.analogRightX < 0x7F) {
+                float t = (0x7F - input.analogRightX) / static_cast<float>(0x7F);
+                t = glm::clamp(t, 0.0f, 1.0f);
+                flapRTarget = glm::radians(-kMaxFlapAngleDeg * t);
+            }
+        }
+
+        // Approach targets smoothly
+        const float tailStepMax = glm::radians(kTailMoveSpeedDeg) * deltaTime;
+        const float flapStepMax = glm::radians(kFlapMoveSpeedDeg) * deltaTime;
+
+        float newTailAngle = MoveTowards(planeState.tailAngle, tailTarget, tailStepMax);
+        float newFlapRAngle = MoveTowards(planeState.flapRAngle, flapRTarget, flapStepMax);
+        float newFlapLAngle = MoveTowards(planeState.flapLAngle, flapLTarget, flapStepMax);
+
+        // Update stored angles in planeState; Plane::ApplyControlSurfaces turns them into part transforms.
+        planeState.tailAngle = newTailAngle;
+        planeState.flapRAngle = newFlapRAngle;
+        planeState.flapLAngle = newFlapLAngle;
+
+        // Always spin blade around Z
+        const float bladeStep = glm::radians(360.0f) * deltaTime * 1.5f;
+        planeState.bladeAngle = std::fmod(planeState.bladeAngle + bladeStep, glm::two_pi<float>());
+
+        if (planeState.baseSpeed < 25.0f) planeState.baseSpeed = 25.0f;
+        if (planeState.baseSpeed > 50.0f) planeState.baseSpeed = 50.0f;
+
+        planeState.boostHeld = (input.IsDown(PlayerInput::Boost));
+        if (input.hasController) {
+            if (input.triggerLeft > 0x7F) {
+                planeState.boostHeld = planeState.boostHeld || true;
+            }
+        }
+    }
+
+    bool FlightControls::IsFirePressed(const PlayerInput& input) const
+    {
+        if (input.hasController)
+        {
+            return input.triggerRight >= 127;
+        }
+        return input.IsDown(PlayerInput::Fire);
+    }
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "PlayerInput.h"
+#include "core/PlaneState.h"
+
+namespace plane::input
+{
+    // Turns a tick's PlayerInput into attitude, throttle, booster and control-surface changes.
+    class FlightControls
+    {
+    public:
+        void Apply(const PlayerInput& input, core::PlaneState& planeState, float deltaTime) const;
+
+        // Fire trigger as the flight model sees it: right trigger on a controller, fire key otherwise.
+        bool IsFirePressed(const PlayerInput& input) const;
+    };
+}
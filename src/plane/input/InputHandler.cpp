@@ -1,216 +1,48 @@
 #include "InputHandler.h"
-#include "../app/Plane.h"
-#include <glm/glm.hpp>
-#include <cmath>
+#include "core/Profiler.h"
+
+#include <utility>
 
 namespace plane::input
 {
-    namespace
+    PlayerInput InputHandler::Sample(GLFWwindow* window, const InputBindings& bindings, const struct inputReportPayload* payload) const
     {
-        constexpr float kMinRotationSpeed = 10.0f;  // Starting speed
-        constexpr float kMaxRotationSpeed = 80.0f;  // Maximum speed for roll
-        constexpr float kMaxRotationSpeed_pitch = 40.0f;  // Maximum speed for pitch
-        constexpr float kRotationAccelTime = 1.5f;  // Time to reach max speed (seconds)
-        constexpr float kAcceleration = 15.0f;  // units per second^2
-
-        // Control surface limits and speeds
-        constexpr float kMaxTailAngleDeg = 45.0f;     // degrees
-        constexpr float kMaxFlapAngleDeg = 45.0f;     // degrees (down)
-        constexpr float kTailMoveSpeedDeg = 45.0f;    // degrees per second
-        constexpr float kFlapMoveSpeedDeg = 45.0f;    // degrees per second
-
-        inline float MoveTowards(float current, float target, float maxDelta)
-        {
-            float delta = target - current;
-            if (std::abs(delta) <= maxDelta) return target;
-            return current + std::copysign(maxDelta, delta);
-        }
-    }
-
-    void InputHandler::ProcessInput(GLFWwindow* window, core::PlaneState& planeState, const core::TimingState& timingState, const InputBindings& bindings, plane::app::Plane* plane, struct inputReportPayload* payload, std::size_t playerIndex) const
-    {
-        if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        {
-            glfwSetWindowShouldClose(window, true);
-        }
-
-        // Directly map keyboard input to Euler adjustments / throttle.
-        // Store rotation deltas
-        float pitchDelta = 0.0f;
-        float yawDelta = 0.0f;
-        float rollDelta = 0.0f;
-        
-        // For polling data from the Dualsense controller
-
-        // Track pitch input and calculate speed
-        bool pitchInputActive = false;
-        if (glfwGetKey(window, bindings.pitchUp) == GLFW_PRESS || payload != NULL)
-        {
-            pitchInputActive = true;
-            planeState.pitchInputTime += timingState.deltaTime;
-            float t = glm::clamp(planeState.pitchInputTime / kRotationAccelTime, 0.0f, 1.0f);
-            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed_pitch, t);
-            if (payload == NULL) {
-                pitchDelta += currentSpeed * timingState.deltaTime;
-            }
-            else  {
-                if(payload->analogLeftY <= 0x75 || payload->analogLeftY >= 0x85 )
-                    pitchDelta += currentSpeed * timingState.deltaTime * ((((payload->analogLeftY) / 255.0)-0.5)*-2.0);
-            }
-        }
-        if (glfwGetKey(window, bindings.pitchDown) == GLFW_PRESS)
+        PLANE_PROFILE_SCOPE("InputHandler::Sample");
+        const std::pair<int, PlayerInput::Button> keyMap[] = {
+            { bindings.pitchUp, PlayerInput::PitchUp },
+            { bindings.pitchDown, PlayerInput::PitchDown },
+            { bindings.rollLeft, PlayerInput::RollLeft },
+            { bindings.rollRight, PlayerInput::RollRight },
+            { bindings.throttleUp, PlayerInput::ThrottleUp },
+            { bindings.throttleDown, PlayerInput::ThrottleDown },
+            { bindings.boost, PlayerInput::Boost },
+            { bindings.fire, PlayerInput::Fire },
+            { bindings.tailUp, PlayerInput::TailUp },
+            { bindings.tailDown, PlayerInput::TailDown },
+            { bindings.flapRightDown, PlayerInput::FlapRightDown },
+            { bindings.flapLeftDown, PlayerInput::FlapLeftDown }
+        };
+
+        PlayerInput input;
+        for (const auto& [key, button] : keyMap)
         {
-            pitchInputActive = true;
-            planeState.pitchInputTime += timingState.deltaTime;
-            float t = glm::clamp(planeState.pitchInputTime / kRotationAccelTime, 0.0f, 1.0f);
-            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed_pitch, t);
-            pitchDelta -= currentSpeed * timingState.deltaTime;
-        }
-        if (!pitchInputActive)
-            planeState.pitchInputTime = 0.0f;
-
-        // Track roll input and calculate speed
-        bool rollInputActive = false;
-        if (glfwGetKey(window, bindings.rollRight) == GLFW_PRESS || payload != NULL)
-        {
-            rollInputActive = true;
-            planeState.rollInputTime += timingState.deltaTime;
-            float t = glm::clamp(planeState.rollInputTime / kRotationAccelTime, 0.0f, 1.0f);
-            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed, t);
-
-            if (payload == NULL) {
-                rollDelta += currentSpeed * timingState.deltaTime;
-            }
-            else {
-                //if (payload->analogRightX <= 0x75 || payload->analogRightX >= 0x85)
-                    rollDelta += currentSpeed * timingState.deltaTime * ((((payload->analogRightX) / 255.0) - 0.5) * 2.0);
+            if (glfwGetKey(window, key) == GLFW_PRESS)
+            {
+                input.buttons |= button;
             }
         }
-        if (glfwGetKey(window, bindings.rollLeft) == GLFW_PRESS)
-        {
-            rollInputActive = true;
-            planeState.rollInputTime += timingState.deltaTime;
-            float t = glm::clamp(planeState.rollInputTime / kRotationAccelTime, 0.0f, 1.0f);
-            float currentSpeed = glm::mix(kMinRotationSpeed, kMaxRotationSpeed, t);
-            rollDelta -= currentSpeed * timingState.deltaTime;
-        }
-        if (glfwGetKey(window, bindings.throttleUp) == GLFW_PRESS)
-            planeState.speed += kAcceleration * timingState.deltaTime;
-        if (glfwGetKey(window, bindings.throttleDown) == GLFW_PRESS)
-            planeState.speed -= kAcceleration * timingState.deltaTime;
-
-        if (!rollInputActive)
-            planeState.rollInputTime = 0.0f;
-
-        // Apply roll directly
-        planeState.roll += rollDelta;
-        
-        // Apply pitch and yaw with roll compensation
-        // When rolled, pitch input should affect both pitch and yaw
-        float rollRad = glm::radians(planeState.roll);
-         
-        // Reduce pitch effect as roll approaches ±90°
-        // Use max(0.1, cos(abs(roll))) to clamp minimum at 0.1
-        float cosAbsRoll = std::abs(std::cos(rollRad));
-        float pitchDamping = (cosAbsRoll > 0.1f) ? cosAbsRoll : 0.1f;
-        float dampedPitchDelta = pitchDelta * pitchDamping;
-        
-        planeState.pitch += dampedPitchDelta * std::cos(rollRad);
-        planeState.yaw += dampedPitchDelta * std::sin(rollRad);
-
-        // if (planeState.pitch > 89.0f) planeState.pitch = 89.0f;
-        // if (planeState.pitch < -89.0f) planeState.pitch = -89.0f;
-
-        while (planeState.yaw < 0.0f) planeState.yaw += 360.0f;
-        while (planeState.yaw >= 360.0f) planeState.yaw -= 360.0f;
-        while (planeState.pitch < 0.0f) planeState.pitch += 360.0f;
-        while (planeState.pitch >= 360.0f) planeState.pitch -= 360.0f;
-        // while (planeState.roll < 0.0f) planeState.roll += 360.0f;
-        // while (planeState.roll >= 360.0f) planeState.roll -= 360.0f;
 
-        // if (planeState.roll > 90.0f) planeState.roll = 90.0f;
-        // if (planeState.roll < -90.0f) planeState.roll = -90.0f;
-
-        if (glfwGetKey(window, bindings.throttleUp) == GLFW_PRESS)
-            planeState.baseSpeed += kAcceleration * timingState.deltaTime;
-        if (glfwGetKey(window, bindings.throttleDown) == GLFW_PRESS)
-            planeState.baseSpeed -= kAcceleration * timingState.deltaTime;
-
-        if (planeState.speed < 25.0f) planeState.speed = 25.0f;
-        if (planeState.speed > 50.0f) planeState.speed = 50.0f;
-
-        // Optional per-part transforms when a plane pointer is provided.
-        if (plane)
+        // For polling data from the Dualsense controller
+        if (payload != nullptr)
         {
-            float tailTarget = 0.0f;
-            float flapRTarget = 0.0f;
-            float flapLTarget = 0.0f;
-            if (payload == NULL){
-                // Targets (radians)
-                if (glfwGetKey(window, bindings.tailUp) == GLFW_PRESS)
-                    tailTarget = glm::radians(kMaxTailAngleDeg);    // up to +30°
-                else if (glfwGetKey(window, bindings.tailDown) == GLFW_PRESS)
-                    tailTarget = glm::radians(-kMaxTailAngleDeg);   // down to -30°
-
-                if (glfwGetKey(window, bindings.flapLeftDown) == GLFW_PRESS)
-                    flapRTarget = glm::radians(-kMaxFlapAngleDeg);  // right flap down 30°
-
-                if (glfwGetKey(window, bindings.flapRightDown) == GLFW_PRESS)
-                    flapLTarget = glm::radians(-kMaxFlapAngleDeg);  // left flap down 30°
-            }
-            else if (payload != NULL && (playerIndex == 0 || playerIndex == 1)) {
-                // Only apply controller transforms if payload belongs to this player
-                // (payload is passed only for the correct player in Update loop)
-                // handle tail
-                if (payload->analogLeftY <= 0x75 || payload->analogLeftY >= 0x85) {
-                    float mappedTailAngle = ((payload->analogLeftY/255.0)*90.0)-45.0;
-                    tailTarget = glm::radians(kMaxTailAngleDeg);
-                }
-                // handle flaps with right stick X: >0x7F left flap down, <0x7F right flap down
-                if (payload->analogRightX > 0x7F) {
-                    float t = (payload->analogRightX - 0x7F) / static_cast<float>(0xFF - 0x7F);
-                    t = glm::clamp(t, 0.0f, 1.0f);
-                    flapLTarget = glm::radians(-kMaxFlapAngleDeg * t);
-                }
-                else if (payload->analogRightX < 0x7F) {
-                    float t = (0x7F - payload->analogRightX) / static_cast<float>(0x7F);
-                    t = glm::clamp(t, 0.0f, 1.0f);
-                    flapRTarget = glm::radians(-kMaxFlapAngleDeg * t);
-                }
-            }
-
-
-            // Approach targets smoothly
-            const float tailStepMax = glm::radians(kTailMoveSpeedDeg) * timingState.deltaTime;
-            const float flapStepMax = glm::radians(kFlapMoveSpeedDeg) * timingState.deltaTime;
-
-            float newTailAngle = MoveTowards(planeState.tailAngle, tailTarget, tailStepMax);
-            float newFlapRAngle = MoveTowards(planeState.flapRAngle, flapRTarget, flapStepMax);
-            float newFlapLAngle = MoveTowards(planeState.flapLAngle, flapLTarget, flapStepMax);
-
-            // Apply deltas around X axis
-            plane->RotatePart(plane::app::Plane::Part::Tail,  glm::vec3(1.0f, 0.0f, 0.0f), newTailAngle - planeState.tailAngle);
-            plane->RotatePart(plane::app::Plane::Part::FlapR, glm::vec3(1.0f, 0.0f, 0.0f), newFlapRAngle - planeState.flapRAngle);
-            plane->RotatePart(plane::app::Plane::Part::FlapL, glm::vec3(1.0f, 0.0f, 0.0f), newFlapLAngle - planeState.flapLAngle);
-
-            // Update stored angles in planeState
-            planeState.tailAngle = newTailAngle;
-            planeState.flapRAngle = newFlapRAngle;
-            planeState.flapLAngle = newFlapLAngle;
-
-            // Always spin blade around Z
-            const float bladeStep = glm::radians(360.0f) * timingState.deltaTime * 1.5f;
-            plane->RotatePart(plane::app::Plane::Part::Blade, glm::vec3(0.0f, 0.0f, 1.0f), bladeStep);
+            input.hasController = true;
+            input.analogLeftY = payload->analogLeftY;
+            input.analogRightX = payload->analogRightX;
+            input.triggerLeft = payload->triggerLeft;
+            input.triggerRight = payload->triggerRight;
         }
-        if (planeState.baseSpeed < 25.0f) planeState.baseSpeed = 25.0f;
-        if (planeState.baseSpeed > 50.0f) planeState.baseSpeed = 50.0f;
 
-        planeState.boostHeld = (glfwGetKey(window, bindings.boost) == GLFW_PRESS);
-        if (payload != NULL) {
-            if (payload->triggerLeft > 0x7F) {
-                planeState.boostHeld = planeState.boostHeld || true;
-            }
-        }
+        return input;
     }
 
     void InputHandler::OnMouseMove(double xposIn, double yposIn, core::CameraRig& cameraRig) const
@@ -2,15 +2,10 @@
 
 #include <GLFW/glfw3.h>
 
+#include "PlayerInput.h"
 #include "core/CameraRig.h"
-#include "core/PlaneState.h"
-#include "core/Timing.h"
 #include "core/controller/Controller.hpp"
 
-namespace plane::app { class Plane; }
-
-namespace plane::app { class Plane; }
-
 namespace plane::input
 {
     struct InputBindings
@@ -34,7 +29,8 @@ namespace plane::input
     class InputHandler
     {
     public:
-        void ProcessInput(GLFWwindow* window, core::PlaneState& planeState, const core::TimingState& timingState, const InputBindings& bindings, plane::app::Plane* plane = nullptr, struct inputReportPayload* payload = nullptr, std::size_t playerIndex = 0) const;
+        // Poll the keyboard (and optional DualSense report) into a device-independent PlayerInput.
+        PlayerInput Sample(GLFWwindow* window, const InputBindings& bindings, const struct inputReportPayload* payload = nullptr) const;
         void OnMouseMove(double xposIn, double yposIn, core::CameraRig& cameraRig) const;
         void OnScroll(double yoffset, core::CameraRig& cameraRig) const;
     };
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstdint>
+
+namespace plane::input
+{
+    // One player's controls for a single simulation tick, independent of where they came from
+    // (keyboard, DualSense, a recording). The simulation only ever sees this struct.
+    struct PlayerInput
+    {
+        enum Button : std::uint16_t
+        {
+            PitchUp       = 1u << 0,
+            PitchDown     = 1u << 1,
+            RollLeft      = 1u << 2,
+            RollRight     = 1u << 3,
+            ThrottleUp    = 1u << 4,
+            ThrottleDown  = 1u << 5,
+            Boost         = 1u << 6,
+            Fire          = 1u << 7,
+            TailUp        = 1u << 8,
+            TailDown      = 1u << 9,
+            FlapRightDown = 1u << 10,
+            FlapLeftDown  = 1u << 11
+        };
+
+        std::uint16_t buttons { 0 };
+
+        // DualSense report fields the flight model consumes (valid when hasController is set).
+        bool hasController { false };
+        std::uint8_t analogLeftY { 0x80 };
+        std::uint8_t analogRightX { 0x80 };
+        std::uint8_t triggerLeft { 0 };
+        std::uint8_t triggerRight { 0 };
+
+        bool IsDown(Button button) const { return (buttons & button) != 0; }
+    };
+}
@@ -1,77 +1,88 @@
 #include "CollisionSystem.h"
 
-#include "core/PlaneState.h"
+#include "core/EntityRegistry.h"
 #include "world/IslandManager.h"
-#include "render/TerrainPlane.h"
+#include "world/HeightField.h"
+#include "core/Profiler.h"
 
 #include <algorithm>
 #include <cmath>
 
 namespace plane::physics
 {
-    void CollisionSystem::Initialize(const world::IslandManager& islandManager, const render::TerrainPlane* terrainPlane)
+    void CollisionSystem::Initialize(const world::IslandManager& islandManager, const world::HeightField* heightField)
     {
         // Store island positions for legacy compatibility (if terrain not provided).
         islandPositions_ = islandManager.GetPositions();
-        // Store terrain plane pointer for accurate heightmap-based collision.
-        terrainPlane_ = terrainPlane;
+        // Store height field pointer for accurate heightmap-based collision.
+        heightField_ = heightField;
         // TUNE: Plane collider radius affects how close plane can get to terrain.
         // Smaller = tighter collision, larger = more clearance. Default 3.0f is tighter than 5.0f.
         planeCollider_.radius = 3.0f;
     }
 
-    bool CollisionSystem::CheckAndResolveCollisions(core::PlaneState& planeState, float deltaTime)
+    std::size_t CollisionSystem::CheckAndResolveCollisions(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime,
+        std::vector<glm::vec3>* crashSites) const
     {
-        // Update plane collider position.
-        planeCollider_.center = planeState.position;
+        PLANE_PROFILE_SCOPE("CollisionSystem::CheckAndResolveCollisions");
+        std::size_t collisions = 0;
         
-        bool collisionDetected = false;
-        
-        // Check vertical ground collision via raycast.
-        if (CheckGroundCollision(planeState))
+        for (std::size_t i = begin; i < end; ++i)
         {
-            collisionDetected = true;
+            // Check vertical ground collision via raycast.
+            if (CheckGroundCollision(registry, i, crashSites))
+            {
+                ++collisions;
+            }
         }
         
-        return collisionDetected;
+        return collisions;
     }
 
-    bool CollisionSystem::CheckGroundCollision(core::PlaneState& planeState)
+    bool CollisionSystem::CheckGroundCollision(core::EntityRegistry& registry, std::size_t index, std::vector<glm::vec3>* crashSites) const
     {
+        glm::vec3& position = registry.Positions()[index];
+
         // Raycast vertically: sample terrain height at multiple points around the plane.
         // This prevents the plane from going under any geometry above it.
         // TUNE: The raycast radius (planeCollider_.radius + 2.0f) determines how far ahead to check.
         // - Increase to detect terrain further away (softer, early collision).
         // - Decrease for tighter, closer collision detection.
-        float maxTerrainHeight = GetMaxTerrainHeightAround(planeState.position.x, planeState.position.z, planeCollider_.radius + 2.0f);
+        float maxTerrainHeight = GetMaxTerrainHeightAround(position.x, position.z, planeCollider_.radius + 2.0f);
         
         // Check if plane is below minimum safe flight height.
         // minSafeY = terrain height + minimum clearance + plane radius
         // TUNE: kMinFlightHeight is the clearance above terrain. Increase for more buffer.
         float minSafeY = maxTerrainHeight;// +kMinFlightHeight + planeCollider_.radius;
         
-        if (planeState.position.y < minSafeY)
+        if (position.y < minSafeY)
         {
             // Collision detected - push plane up to safe height.
-            planeState.position.y = minSafeY;
+            position.y = minSafeY;
             
             // Reduce health by 30 on ground collision
-            planeState.health -= 0.1f;
-            if (planeState.health <= 0.0f)
+            core::Health& health = registry.Healths()[index];
+            health.points -= 0.1f;
+            if (health.points <= 0.0f)
             {
-                planeState.health = 0.0f;
-                planeState.isAlive = false;
+                // The contact that brings the plane down is the one that leaves a crater.
+                if (health.alive && crashSites)
+                    crashSites->push_back(position);
+                health.points = 0.0f;
+                health.alive = false;
             }
             
             // Adjust pitch by 20 degrees away from terrain (pull up)
-            planeState.pitch += 0.0f;
-            if (planeState.pitch > 90.0f)
-                planeState.pitch = 90.0f;
+            core::Orientation& orientation = registry.Orientations()[index];
+            orientation.pitch += 0.0f;
+            if (orientation.pitch > 90.0f)
+                orientation.pitch = 90.0f;
             
             // Reduce speed slightly from impact.
             // TUNE: 0.95f = lose 5% speed per collision. Increase (0.98f) for less penalty.
-            planeState.baseSpeed *= 0.95f;
-            planeState.speed *= 0.95f;
+            core::Speed& speed = registry.Speeds()[index];
+            speed.base *= 0.95f;
+            speed.current *= 0.95f;
             
             return true;
         }
@@ -79,18 +90,18 @@ namespace plane::physics
         return false;
     }
 
-    float CollisionSystem::GetGroundHeightAt(float x, float z)
+    float CollisionSystem::GetGroundHeightAt(float x, float z) const
     {
         // Simple flat water surface.
         return kGroundLevel;
     }
 
-    float CollisionSystem::GetTerrainHeightAt(float x, float z)
+    float CollisionSystem::GetTerrainHeightAt(float x, float z) const
     {
-        // If terrain plane available, use accurate heightmap query
-        if (terrainPlane_)
+        // If a height field is available, use accurate heightmap query
+        if (heightField_)
         {
-            float terrainHeight = terrainPlane_->GetHeightAt(x, z);
+            float terrainHeight = heightField_->GetHeightAt(x, z);
             // Only use terrain height if it's above water (ground level)
             // This allows underwater terrain to not block the plane
             float waterLevel = GetGroundHeightAt(x, z);
@@ -125,11 +136,17 @@ namespace plane::physics
         return maxHeight;
     }
 
-    float CollisionSystem::GetMaxTerrainHeightAround(float x, float z, float sampleRadius)
+    float CollisionSystem::GetMaxTerrainHeightAround(float x, float z, float sampleRadius) const
     {
         // Multi-point raycast: sample terrain at several points around the plane's footprint.
         // Returns the maximum terrain height found, ensuring plane avoids all geometry above.
         // TUNE: This provides early warning of terrain ahead. More samples = more accurate but slower.
+        // With a height field the whole ring is one neighbourhood query; water still floors it.
+        if (heightField_)
+        {
+            return (std::max)(heightField_->GetMaxHeightAround(x, z, sampleRadius, kRaycastSamples), GetGroundHeightAt(x, z));
+        }
+
         float maxHeight = GetTerrainHeightAt(x, z);
         
         // Sample at 8 points in a circle (kRaycastSamples = 8)
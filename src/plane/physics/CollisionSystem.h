@@ -2,24 +2,21 @@
 
 #include <glm/glm.hpp>
 
+#include <cstddef>
 #include <vector>
 
 namespace plane
 {
     namespace core
     {
-        struct PlaneState;
+        class EntityRegistry;
     }
 
     namespace world
     {
+        class HeightField;
         class IslandManager;
     }
-
-    namespace render
-    {
-        class TerrainPlane;
-    }
 }
 
 namespace plane::physics
@@ -34,29 +31,32 @@ namespace plane::physics
     class CollisionSystem
     {
     public:
-        void Initialize(const world::IslandManager& islandManager, const render::TerrainPlane* terrainPlane = nullptr);
+        void Initialize(const world::IslandManager& islandManager, const world::HeightField* heightField = nullptr);
 
-        // Check and resolve all collisions for the plane.
-        // Returns true if a collision occurred and was resolved.
-        bool CheckAndResolveCollisions(core::PlaneState& planeState, float deltaTime);
+        // Check and resolve all collisions for planes [begin, end) of the registry.
+        // Returns how many planes collided this call. Planes the ground destroys append
+        // their position to crashSites when one is given.
+        // Const so disjoint ranges can be resolved concurrently.
+        std::size_t CheckAndResolveCollisions(core::EntityRegistry& registry, std::size_t begin, std::size_t end, float deltaTime,
+            std::vector<glm::vec3>* crashSites = nullptr) const;
 
     private:
-        // Vertical collision: check if plane is too close to ground via raycast.
-        bool CheckGroundCollision(core::PlaneState& planeState);
+        // Vertical collision: check if plane 'index' is too close to ground via raycast.
+        bool CheckGroundCollision(core::EntityRegistry& registry, std::size_t index, std::vector<glm::vec3>* crashSites) const;
         
         // Vertical raycast: sample terrain height at multiple points around the plane.
         // Returns maximum terrain height within the plane's footprint.
-        float GetMaxTerrainHeightAround(float x, float z, float sampleRadius = 8.0f);
+        float GetMaxTerrainHeightAround(float x, float z, float sampleRadius = 8.0f) const;
         
         // Get ground height at the plane's XZ position (water surface).
-        float GetGroundHeightAt(float x, float z);
+        float GetGroundHeightAt(float x, float z) const;
         
         // Get the highest terrain point at XZ considering islands.
-        float GetTerrainHeightAt(float x, float z);
+        float GetTerrainHeightAt(float x, float z) const;
 
-        CircleCollider planeCollider_;
+        CircleCollider planeCollider_;  // Only the radius is used; the center is the plane position.
         std::vector<glm::vec3> islandPositions_;       // Legacy: kept for compatibility
-        const render::TerrainPlane* terrainPlane_;     // Heightmap terrain for accurate collision
+        const world::HeightField* heightField_ { nullptr };  // Heightmap terrain for accurate collision
         
         // === COLLISION TUNING PARAMETERS ===
         // kGroundLevel: Water surface Y position. Default is flat at Y=0.
@@ -13,8 +13,18 @@ in VS_OUT
 uniform sampler2D texture_diffuse1;
 uniform sampler2D shadowMap;
 
-uniform vec3 lightDir;
-uniform vec3 viewPos;
+layout (std140) uniform FrameBlock
+{
+    mat4 lightSpaceMatrix;
+    vec4 lightDir;
+};
+
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
 
 float ShadowCalculation(vec4 fragPosLightSpace, vec3 normal, vec3 lightDirection)
 {
@@ -43,8 +53,8 @@ void main()
 {
     vec3 color = texture(texture_diffuse1, fs_in.TexCoords).rgb;
     vec3 normal = normalize(fs_in.Normal);
-    vec3 lightDirection = normalize(lightDir);
-    vec3 viewDirection = normalize(viewPos - fs_in.FragPos);
+    vec3 lightDirection = lightDir.xyz;
+    vec3 viewDirection = normalize(viewPos.xyz - fs_in.FragPos);
 
     float diff = max(dot(normal, -lightDirection), 0.0);
     vec3 diffuse = diff * vec3(1.0);
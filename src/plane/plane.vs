@@ -13,9 +13,19 @@ out VS_OUT
 } vs_out;
 
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
-uniform mat4 lightSpaceMatrix;
+
+layout (std140) uniform FrameBlock
+{
+    mat4 lightSpaceMatrix;
+    vec4 lightDir;
+};
+
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
 
 void main()
 {
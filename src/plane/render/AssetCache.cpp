@@ -0,0 +1,144 @@
+#include "AssetCache.h"
+
+#include "BakedModel.h"
+#include "core/Profiler.h"
+
+#include <filesystem>
+#include <system_error>
+
+namespace plane::render
+{
+    std::shared_ptr<Model> AssetCache::LoadModel(const std::string& path)
+    {
+        PLANE_PROFILE_SCOPE("AssetCache::LoadModel");
+        const std::string key = CanonicalPath(path);
+        if (auto existing = models_[key].lock())
+        {
+            ++stats_.modelReuses;
+            return existing;
+        }
+
+        auto model = CreateModel(key, true);
+        models_[key] = model;
+        ++stats_.modelLoads;
+        return model;
+    }
+
+    TextureRef AssetCache::LoadTexture(const std::string& path, bool gamma)
+    {
+        PLANE_PROFILE_SCOPE("AssetCache::LoadTexture");
+        const std::string key = CanonicalPath(path);
+        if (auto existing = textures_[key].lock())
+        {
+            ++stats_.textureReuses;
+            return existing;
+        }
+
+        return AdoptTexture(DecodeImage(key));
+    }
+
+    void AssetCache::LoadModelAsync(AssetStreamer& streamer, const std::string& path, StreamPriority priority, ModelCallback onReady)
+    {
+        const std::string key = CanonicalPath(path);
+        if (auto existing = models_[key].lock())
+        {
+            ++stats_.modelReuses;
+            onReady(std::move(existing));
+            return;
+        }
+
+        auto pending = pendingModels_.find(key);
+        if (pending != pendingModels_.end())
+        {
+            ++stats_.modelReuses;
+            pending->second.push_back(std::move(onReady));
+            return;
+        }
+        pendingModels_[key].push_back(std::move(onReady));
+
+        streamer.Enqueue("AssetCache::LoadModelAsync", priority, [this, key]() -> AssetStreamer::UploadStep
+        {
+            // Loader thread: nothing here may touch GL or the cache's maps.
+            auto model = CreateModel(key, false);
+
+            std::vector<DecodedImage> images;
+            for (const auto& texturePath : model->GetTexturePaths())
+            {
+                images.push_back(DecodeImage(CanonicalPath(texturePath)));
+            }
+            return [this, key, model, images] { FinishModel(key, model, images); };
+        });
+    }
+
+    std::shared_ptr<Model> AssetCache::CreateModel(const std::string& key, bool uploadNow)
+    {
+        // Textures resolve through the cache either way; prefer the baked mesh over Assimp.
+        TextureProvider textureProvider = [this](const std::string& texturePath, bool gamma)
+        {
+            return LoadTexture(texturePath, gamma);
+        };
+        if (auto baked = LoadBakedModel(key, textureProvider, uploadNow))
+        {
+            return baked;
+        }
+        return std::make_shared<Model>(key, false, std::move(textureProvider), uploadNow);
+    }
+
+    void AssetCache::FinishModel(const std::string& key, const std::shared_ptr<Model>& model, const std::vector<DecodedImage>& images)
+    {
+        // Adopt the pre-decoded images first so Upload's texture lookups all hit the cache.
+        std::vector<TextureRef> adopted;
+        for (const auto& image : images)
+        {
+            adopted.push_back(AdoptTexture(image));
+        }
+        // Upload's lookups hit the textures adopted above; those are not reuses.
+        const std::size_t textureReuses = stats_.textureReuses;
+        model->Upload();
+        stats_.textureReuses = textureReuses;
+        models_[key] = model;
+        ++stats_.modelLoads;
+
+        auto callbacks = std::move(pendingModels_[key]);
+        pendingModels_.erase(key);
+        for (auto& onReady : callbacks)
+        {
+            onReady(model);
+        }
+    }
+
+    TextureRef AssetCache::AdoptTexture(const DecodedImage& image)
+    {
+        if (auto existing = textures_[image.path].lock())
+        {
+            ++stats_.textureReuses;
+            return existing;
+        }
+
+        // The deleter returns the texture to GL when the last model lets go of it.
+        TextureRef texture(new unsigned int(UploadTexture(image)), [](const unsigned int* id)
+        {
+            glDeleteTextures(1, id);
+            delete id;
+        });
+        textures_[image.path] = texture;
+        ++stats_.textureLoads;
+        return texture;
+    }
+
+    void AssetCache::Clear()
+    {
+        models_.clear();
+        textures_.clear();
+        pendingModels_.clear();
+    }
+
+    std::string AssetCache::CanonicalPath(const std::string& path)
+    {
+        // "a/b/../c.dae" and "a/c.dae" must share an entry; fall back to the raw path
+        // when the file system cannot resolve it (the loader reports the error).
+        std::error_code error;
+        const auto canonical = std::filesystem::weakly_canonical(std::filesystem::path(path), error);
+        return error ? path : canonical.generic_string();
+    }
+}
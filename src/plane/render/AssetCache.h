@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <learnopengl/model.h>
+
+#include "AssetStreamer.h"
+#include "TextureLoader.h"
+
+namespace plane::render
+{
+    // Reference-counted models and textures keyed by canonical file path. Asking for
+    // a file that is still held somewhere returns the existing instance instead of
+    // parsing and uploading it again; once the last handle is released the next
+    // request loads it fresh. Textures are shared across every model loaded here, so
+    // parts that use the same atlas upload it once. Main (GL) thread only.
+    class AssetCache
+    {
+    public:
+        struct Stats
+        {
+            std::size_t modelLoads { 0 };
+            std::size_t modelReuses { 0 };
+            std::size_t textureLoads { 0 };
+            std::size_t textureReuses { 0 };
+        };
+
+        using ModelCallback = std::function<void(std::shared_ptr<Model>)>;
+
+        std::shared_ptr<Model> LoadModel(const std::string& path);
+        TextureRef LoadTexture(const std::string& path, bool gamma = false);
+
+        // Parses the model and decodes its textures on the streamer's threads, then
+        // uploads and calls onReady on the main thread (immediately if already cached).
+        // Requests for a model that is still streaming wait for that same load.
+        void LoadModelAsync(AssetStreamer& streamer, const std::string& path, StreamPriority priority, ModelCallback onReady);
+
+        const Stats& GetStats() const { return stats_; }
+
+        // Forgets every entry. Handles already given out stay valid until released.
+        void Clear();
+
+    private:
+        static std::string CanonicalPath(const std::string& path);
+
+        // Baked mesh if one is up to date, Assimp otherwise. Any thread when !uploadNow.
+        std::shared_ptr<Model> CreateModel(const std::string& key, bool uploadNow);
+        // Upload half of LoadModelAsync.
+        void FinishModel(const std::string& key, const std::shared_ptr<Model>& model, const std::vector<DecodedImage>& images);
+        TextureRef AdoptTexture(const DecodedImage& image);
+
+        std::unordered_map<std::string, std::weak_ptr<Model>> models_;
+        std::unordered_map<std::string, std::weak_ptr<const unsigned int>> textures_;
+        // Models being streamed, with everyone waiting for them.
+        std::unordered_map<std::string, std::vector<ModelCallback>> pendingModels_;
+        Stats stats_;
+    };
+}
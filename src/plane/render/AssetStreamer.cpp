@@ -0,0 +1,139 @@
+#include "AssetStreamer.h"
+
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+namespace plane::render
+{
+    AssetStreamer::~AssetStreamer()
+    {
+        Stop();
+    }
+
+    unsigned AssetStreamer::DefaultThreadCount()
+    {
+        const unsigned hardwareThreads = std::thread::hardware_concurrency();
+        return (std::clamp)(hardwareThreads > 1 ? hardwareThreads - 1 : 1u, 1u, 4u);
+    }
+
+    void AssetStreamer::Start(unsigned threadCount)
+    {
+        Stop();
+        stopping_ = false;
+        for (unsigned i = 0; i < (std::max)(threadCount, 1u); ++i)
+        {
+            loaders_.emplace_back([this] { LoaderLoop(); });
+        }
+    }
+
+    void AssetStreamer::Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+            loads_ = {};
+        }
+        wakeCondition_.notify_all();
+        for (auto& loader : loaders_)
+        {
+            loader.join();
+        }
+        loaders_.clear();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        uploads_ = {};
+    }
+
+    void AssetStreamer::Enqueue(const char* name, StreamPriority priority, LoadStep load)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            Request request;
+            request.name = name;
+            request.priority = priority;
+            request.sequence = nextSequence_++;
+            request.load = std::move(load);
+            loads_.push(std::move(request));
+        }
+        wakeCondition_.notify_one();
+    }
+
+    std::size_t AssetStreamer::PumpUploads(double budgetSeconds)
+    {
+        PLANE_PROFILE_SCOPE("AssetStreamer::PumpUploads");
+        const auto start = std::chrono::steady_clock::now();
+        std::size_t uploaded = 0;
+        for (;;)
+        {
+            Request request;
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (uploads_.empty())
+                    break;
+                request = uploads_.top();
+                uploads_.pop();
+            }
+
+            {
+                PLANE_PROFILE_SCOPE(request.name);
+                request.upload();
+            }
+            ++uploaded;
+
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() >= budgetSeconds)
+                break;
+        }
+        return uploaded;
+    }
+
+    std::size_t AssetStreamer::GetPendingCount() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return loads_.size() + loadsInFlight_ + uploads_.size();
+    }
+
+    void AssetStreamer::LoaderLoop()
+    {
+        core::Profiler::SetThreadName("Asset Loader");
+
+        for (;;)
+        {
+            Request request;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                wakeCondition_.wait(lock, [this] { return stopping_ || !loads_.empty(); });
+                if (stopping_)
+                    return;
+                request = loads_.top();
+                loads_.pop();
+                ++loadsInFlight_;
+            }
+
+            try
+            {
+                PLANE_PROFILE_SCOPE(request.name);
+                request.upload = request.load();
+            }
+            catch (const std::exception& e)
+            {
+                std::cout << "Asset load '" << request.name << "' failed: " << e.what() << std::endl;
+            }
+            catch (...)
+            {
+                std::cout << "Asset load '" << request.name << "' failed" << std::endl;
+            }
+            request.load = nullptr;
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            --loadsInFlight_;
+            if (request.upload && !stopping_)
+                uploads_.push(std::move(request));
+        }
+    }
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace plane::render
+{
+    enum class StreamPriority : int
+    {
+        High = 0,   // Needed before the match can start (planes, terrain).
+        Normal,
+        Low         // Cosmetic; fine to arrive last.
+    };
+
+    // Background asset loading split in two halves. The load half (file I/O, image
+    // decode, Assimp parse, mesh build) runs on a small pool of loader threads in
+    // priority order; it returns an upload half that needs the GL context and is run
+    // later by PumpUploads on the main thread, a few per frame under a time budget.
+    class AssetStreamer
+    {
+    public:
+        using UploadStep = std::function<void()>;
+        using LoadStep = std::function<UploadStep()>;
+
+        AssetStreamer() = default;
+        ~AssetStreamer();
+
+        AssetStreamer(const AssetStreamer&) = delete;
+        AssetStreamer& operator=(const AssetStreamer&) = delete;
+
+        // Loaders do mostly blocking I/O and parsing, so a few threads are plenty.
+        static unsigned DefaultThreadCount();
+
+        void Start(unsigned threadCount = DefaultThreadCount());
+        // Drops queued loads, waits for running ones and discards every pending upload.
+        void Stop();
+
+        // name must be a string literal; it labels the load in profiler traces.
+        void Enqueue(const char* name, StreamPriority priority, LoadStep load);
+
+        // Main thread. Runs finished uploads in priority order until budgetSeconds has
+        // passed (at least one per call, so progress never stalls). Returns how many ran.
+        std::size_t PumpUploads(double budgetSeconds);
+
+        // Loads plus uploads not yet finished.
+        std::size_t GetPendingCount() const;
+        bool IsIdle() const { return GetPendingCount() == 0; }
+
+    private:
+        struct Request
+        {
+            const char* name { nullptr };
+            StreamPriority priority { StreamPriority::Normal };
+            std::uint64_t sequence { 0 };  // FIFO within a priority.
+            LoadStep load;
+            UploadStep upload;
+        };
+
+        struct LaterFirst
+        {
+            bool operator()(const Request& a, const Request& b) const
+            {
+                if (a.priority != b.priority)
+                    return a.priority > b.priority;
+                return a.sequence > b.sequence;
+            }
+        };
+
+        void LoaderLoop();
+
+        std::vector<std::thread> loaders_;
+        mutable std::mutex mutex_;
+        std::condition_variable wakeCondition_;
+        std::priority_queue<Request, std::vector<Request>, LaterFirst> loads_;
+        std::priority_queue<Request, std::vector<Request>, LaterFirst> uploads_;
+        std::size_t loadsInFlight_ { 0 };
+        std::uint64_t nextSequence_ { 0 };
+        bool stopping_ { false };
+    };
+}
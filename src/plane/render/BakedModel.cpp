@@ -0,0 +1,239 @@
+#include "BakedModel.h"
+
+#include "core/MappedFile.h"
+#include "core/Profiler.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+namespace plane::render
+{
+    namespace
+    {
+        constexpr char kMagic[4] = { 'P', 'M', 'S', 'H' };
+        constexpr std::uint32_t kFormatVersion = 1;
+        // Blobs start on this boundary so the mapped Vertex array is suitably aligned.
+        constexpr std::size_t kBlobAlignment = 16;
+
+        struct FileHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint32_t vertexStride;
+            std::uint32_t meshCount;
+            std::uint32_t textureCount;
+            std::uint32_t stringBytes;
+            core::FileStamp source;
+            std::uint64_t vertexCount;
+            std::uint64_t indexCount;
+        };
+
+        struct MeshRecord
+        {
+            std::uint32_t firstVertex;
+            std::uint32_t vertexCount;
+            std::uint32_t firstIndex;
+            std::uint32_t indexCount;
+            std::uint32_t firstTexture;
+            std::uint32_t textureCount;
+        };
+
+        // Offsets into the string table.
+        struct TextureRecord
+        {
+            std::uint32_t typeOffset;
+            std::uint32_t typeLength;
+            std::uint32_t pathOffset;
+            std::uint32_t pathLength;
+        };
+
+        std::size_t AlignUp(std::size_t offset)
+        {
+            return (offset + kBlobAlignment - 1) & ~(kBlobAlignment - 1);
+        }
+
+        template <typename T>
+        void Append(std::vector<std::uint8_t>& out, const T* data, std::size_t count)
+        {
+            const auto* bytes = reinterpret_cast<const std::uint8_t*>(data);
+            out.insert(out.end(), bytes, bytes + sizeof(T) * count);
+        }
+    }
+
+    std::string BakedModelPath(const std::string& sourcePath)
+    {
+        return sourcePath + ".pmesh";
+    }
+
+    bool BakeModel(const Model& model, const std::string& sourcePath)
+    {
+        FileHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.vertexStride = sizeof(Vertex);
+        header.meshCount = static_cast<std::uint32_t>(model.meshes.size());
+        if (!core::GetFileStamp(sourcePath, header.source))
+        {
+            return false;
+        }
+
+        std::vector<MeshRecord> meshRecords;
+        std::vector<TextureRecord> textureRecords;
+        std::string strings;
+        auto addString = [&strings](const std::string& value, std::uint32_t& offset, std::uint32_t& length)
+        {
+            offset = static_cast<std::uint32_t>(strings.size());
+            length = static_cast<std::uint32_t>(value.size());
+            strings += value;
+        };
+
+        for (const auto& mesh : model.meshes)
+        {
+            MeshRecord record {};
+            record.firstVertex = static_cast<std::uint32_t>(header.vertexCount);
+            record.vertexCount = static_cast<std::uint32_t>(mesh.vertices.size());
+            record.firstIndex = static_cast<std::uint32_t>(header.indexCount);
+            record.indexCount = static_cast<std::uint32_t>(mesh.indices.size());
+            record.firstTexture = static_cast<std::uint32_t>(textureRecords.size());
+            record.textureCount = static_cast<std::uint32_t>(mesh.textures.size());
+            meshRecords.push_back(record);
+
+            for (const auto& texture : mesh.textures)
+            {
+                TextureRecord textureRecord {};
+                addString(texture.type, textureRecord.typeOffset, textureRecord.typeLength);
+                addString(texture.path, textureRecord.pathOffset, textureRecord.pathLength);
+                textureRecords.push_back(textureRecord);
+            }
+
+            header.vertexCount += mesh.vertices.size();
+            header.indexCount += mesh.indices.size();
+        }
+        header.textureCount = static_cast<std::uint32_t>(textureRecords.size());
+        header.stringBytes = static_cast<std::uint32_t>(strings.size());
+
+        std::vector<std::uint8_t> bytes;
+        Append(bytes, &header, 1);
+        Append(bytes, meshRecords.data(), meshRecords.size());
+        Append(bytes, textureRecords.data(), textureRecords.size());
+        Append(bytes, strings.data(), strings.size());
+        bytes.resize(AlignUp(bytes.size()), 0);
+        for (const auto& mesh : model.meshes)
+        {
+            Append(bytes, mesh.vertices.data(), mesh.vertices.size());
+        }
+        bytes.resize(AlignUp(bytes.size()), 0);
+        for (const auto& mesh : model.meshes)
+        {
+            Append(bytes, mesh.indices.data(), mesh.indices.size());
+        }
+
+        // Write beside the target and rename, so an interrupted bake never leaves a torn file.
+        const std::string path = BakedModelPath(sourcePath);
+        const std::string tempPath = path + ".tmp";
+        std::error_code error;
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(tempPath, error);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    std::shared_ptr<Model> LoadBakedModel(const std::string& sourcePath, TextureProvider textureProvider, bool uploadNow)
+    {
+        PLANE_PROFILE_SCOPE("LoadBakedModel");
+        core::MappedFile file;
+        if (!file.Open(BakedModelPath(sourcePath)) || file.Size() < sizeof(FileHeader))
+        {
+            return nullptr;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0
+            || header.version != kFormatVersion
+            || header.vertexStride != sizeof(Vertex))
+        {
+            return nullptr;
+        }
+
+        core::FileStamp source;
+        if (core::GetFileStamp(sourcePath, source) && source != header.source)
+        {
+            std::cout << "Baked model is stale, parsing the source instead: " << sourcePath << std::endl;
+            return nullptr;
+        }
+
+        const std::size_t meshTable = sizeof(FileHeader);
+        const std::size_t textureTable = meshTable + sizeof(MeshRecord) * header.meshCount;
+        const std::size_t stringTable = textureTable + sizeof(TextureRecord) * header.textureCount;
+        const std::size_t vertexBlob = AlignUp(stringTable + header.stringBytes);
+        const std::size_t indexBlob = AlignUp(vertexBlob + sizeof(Vertex) * header.vertexCount);
+        if (indexBlob + sizeof(unsigned int) * header.indexCount > file.Size())
+        {
+            return nullptr;
+        }
+
+        const std::uint8_t* base = file.Data();
+        const auto* strings = reinterpret_cast<const char*>(base + stringTable);
+        const auto* vertices = reinterpret_cast<const Vertex*>(base + vertexBlob);
+        const auto* indices = reinterpret_cast<const unsigned int*>(base + indexBlob);
+
+        std::vector<Mesh> meshes;
+        meshes.reserve(header.meshCount);
+        for (std::uint32_t m = 0; m < header.meshCount; ++m)
+        {
+            MeshRecord record;
+            std::memcpy(&record, base + meshTable + sizeof(MeshRecord) * m, sizeof(record));
+            if (static_cast<std::uint64_t>(record.firstVertex) + record.vertexCount > header.vertexCount
+                || static_cast<std::uint64_t>(record.firstIndex) + record.indexCount > header.indexCount
+                || static_cast<std::uint64_t>(record.firstTexture) + record.textureCount > header.textureCount)
+            {
+                return nullptr;
+            }
+
+            std::vector<Texture> textures;
+            for (std::uint32_t t = 0; t < record.textureCount; ++t)
+            {
+                TextureRecord textureRecord;
+                std::memcpy(&textureRecord, base + textureTable + sizeof(TextureRecord) * (record.firstTexture + t), sizeof(textureRecord));
+                if (static_cast<std::uint64_t>(textureRecord.typeOffset) + textureRecord.typeLength > header.stringBytes
+                    || static_cast<std::uint64_t>(textureRecord.pathOffset) + textureRecord.pathLength > header.stringBytes)
+                {
+                    return nullptr;
+                }
+                Texture texture;
+                texture.id = 0;
+                texture.type.assign(strings + textureRecord.typeOffset, textureRecord.typeLength);
+                texture.path.assign(strings + textureRecord.pathOffset, textureRecord.pathLength);
+                textures.push_back(std::move(texture));
+            }
+
+            meshes.emplace_back(
+                std::vector<Vertex>(vertices + record.firstVertex, vertices + record.firstVertex + record.vertexCount),
+                std::vector<unsigned int>(indices + record.firstIndex, indices + record.firstIndex + record.indexCount),
+                std::move(textures),
+                false);
+        }
+
+        const std::string directory = sourcePath.substr(0, sourcePath.find_last_of('/'));
+        return std::make_shared<Model>(directory, std::move(meshes), false, std::move(textureProvider), uploadNow);
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include <learnopengl/model.h>
+
+namespace plane::render
+{
+    // Flat binary snapshot of what Assimp produces for a model file: a header, a mesh
+    // table, a material texture table, then one interleaved Vertex blob and one index
+    // blob laid out exactly as Mesh uploads them. Loading it maps the file and copies
+    // each mesh's range out in bulk; no parsing and no per-vertex work. The header
+    // records the source's size and timestamp so an edited source is not shadowed by
+    // an old bake. Files are native-endian and tied to sizeof(Vertex).
+
+    // "<source>.pmesh" next to the source file.
+    std::string BakedModelPath(const std::string& sourcePath);
+
+    // Writes the baked file for a model parsed from sourcePath. Returns false on I/O failure.
+    bool BakeModel(const Model& model, const std::string& sourcePath);
+
+    // Null if there is no baked file or it is stale, truncated or from another format
+    // version; the caller then falls back to parsing the source. Safe off the GL
+    // thread when uploadNow is false.
+    std::shared_ptr<Model> LoadBakedModel(const std::string& sourcePath, TextureProvider textureProvider, bool uploadNow);
+}
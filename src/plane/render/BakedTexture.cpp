@@ -0,0 +1,406 @@
+#include "BakedTexture.h"
+
+#include "core/MappedFile.h"
+#include "core/Profiler.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <system_error>
+#include <vector>
+
+namespace plane::render
+{
+    namespace
+    {
+        constexpr char kMagic[4] = { 'P', 'T', 'E', 'X' };
+        constexpr std::uint32_t kFormatVersion = 1;
+
+        // Beyond any GL implementation's texture limit; keeps level sizes far from overflow.
+        constexpr std::uint32_t kMaxSide = 1u << 16;
+
+        // EXT_texture_compression_s3tc; not part of the core profile glad was generated for.
+        constexpr unsigned int kGlCompressedRgbDxt1 = 0x83F0;
+        constexpr unsigned int kGlCompressedRgbaDxt5 = 0x83F3;
+
+        struct FileHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            BakedTextureFormat format;
+            std::uint32_t components;
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint32_t levelCount;
+            std::uint32_t reserved;
+            core::FileStamp source;
+        };
+
+        // Byte range of one mip level, relative to the start of the file.
+        struct LevelRecord
+        {
+            std::uint32_t width;
+            std::uint32_t height;
+            std::uint64_t offset;
+            std::uint64_t size;
+        };
+
+        struct Image
+        {
+            int width { 0 };
+            int height { 0 };
+            int components { 0 };
+            std::vector<unsigned char> pixels;
+        };
+
+        // 2x2 box filter, like glGenerateMipmap; an odd last row/column is clamped.
+        Image Downsample(const Image& source)
+        {
+            Image mip;
+            mip.width = (std::max)(source.width / 2, 1);
+            mip.height = (std::max)(source.height / 2, 1);
+            mip.components = source.components;
+            mip.pixels.resize(static_cast<std::size_t>(mip.width) * mip.height * mip.components);
+
+            for (int y = 0; y < mip.height; ++y)
+            {
+                const int y0 = (std::min)(y * 2, source.height - 1);
+                const int y1 = (std::min)(y * 2 + 1, source.height - 1);
+                for (int x = 0; x < mip.width; ++x)
+                {
+                    const int x0 = (std::min)(x * 2, source.width - 1);
+                    const int x1 = (std::min)(x * 2 + 1, source.width - 1);
+                    for (int c = 0; c < mip.components; ++c)
+                    {
+                        auto at = [&](int sx, int sy) { return source.pixels[(static_cast<std::size_t>(sy) * source.width + sx) * source.components + c]; };
+                        const int sum = at(x0, y0) + at(x1, y0) + at(x0, y1) + at(x1, y1);
+                        mip.pixels[(static_cast<std::size_t>(y) * mip.width + x) * mip.components + c] = static_cast<unsigned char>((sum + 2) / 4);
+                    }
+                }
+            }
+            return mip;
+        }
+
+        std::uint16_t PackRgb565(const unsigned char* rgb)
+        {
+            return static_cast<std::uint16_t>(((rgb[0] >> 3) << 11) | ((rgb[1] >> 2) << 5) | (rgb[2] >> 3));
+        }
+
+        void UnpackRgb565(std::uint16_t packed, int* rgb)
+        {
+            rgb[0] = ((packed >> 11) & 31) * 255 / 31;
+            rgb[1] = ((packed >> 5) & 63) * 255 / 63;
+            rgb[2] = (packed & 31) * 255 / 31;
+        }
+
+        // One 4x4 block as RGBA, edge pixels repeated when the image is smaller.
+        void FetchBlock(const Image& image, int blockX, int blockY, unsigned char block[16][4])
+        {
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    const int sx = (std::min)(blockX * 4 + x, image.width - 1);
+                    const int sy = (std::min)(blockY * 4 + y, image.height - 1);
+                    const unsigned char* pixel = &image.pixels[(static_cast<std::size_t>(sy) * image.width + sx) * image.components];
+                    unsigned char* out = block[y * 4 + x];
+                    for (int c = 0; c < 3; ++c)
+                        out[c] = pixel[(std::min)(c, image.components - 1)];
+                    out[3] = (image.components == 4) ? pixel[3] : 255;
+                }
+            }
+        }
+
+        // Bounding-box endpoints and nearest-palette indices; quick, not optimal.
+        void EncodeColorBlock(const unsigned char block[16][4], std::vector<unsigned char>& out)
+        {
+            unsigned char lo[3] = { 255, 255, 255 };
+            unsigned char hi[3] = { 0, 0, 0 };
+            for (int i = 0; i < 16; ++i)
+            {
+                for (int c = 0; c < 3; ++c)
+                {
+                    lo[c] = (std::min)(lo[c], block[i][c]);
+                    hi[c] = (std::max)(hi[c], block[i][c]);
+                }
+            }
+
+            std::uint16_t color0 = PackRgb565(hi);
+            std::uint16_t color1 = PackRgb565(lo);
+            std::uint32_t indices = 0;
+            if (color0 < color1)
+                std::swap(color0, color1);
+
+            if (color0 != color1)
+            {
+                // color0 > color1 selects the four-color palette.
+                int palette[4][3];
+                UnpackRgb565(color0, palette[0]);
+                UnpackRgb565(color1, palette[1]);
+                for (int c = 0; c < 3; ++c)
+                {
+                    palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+                    palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+                }
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    int best = 0;
+                    int bestDistance = 1 << 30;
+                    for (int p = 0; p < 4; ++p)
+                    {
+                        int distance = 0;
+                        for (int c = 0; c < 3; ++c)
+                        {
+                            const int delta = block[i][c] - palette[p][c];
+                            distance += delta * delta;
+                        }
+                        if (distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            best = p;
+                        }
+                    }
+                    indices |= static_cast<std::uint32_t>(best) << (2 * i);
+                }
+            }
+
+            const unsigned char bytes[8] = {
+                static_cast<unsigned char>(color0), static_cast<unsigned char>(color0 >> 8),
+                static_cast<unsigned char>(color1), static_cast<unsigned char>(color1 >> 8),
+                static_cast<unsigned char>(indices), static_cast<unsigned char>(indices >> 8),
+                static_cast<unsigned char>(indices >> 16), static_cast<unsigned char>(indices >> 24)
+            };
+            out.insert(out.end(), bytes, bytes + 8);
+        }
+
+        void EncodeAlphaBlock(const unsigned char block[16][4], std::vector<unsigned char>& out)
+        {
+            int alpha0 = 0;
+            int alpha1 = 255;
+            for (int i = 0; i < 16; ++i)
+            {
+                alpha0 = (std::max)(alpha0, static_cast<int>(block[i][3]));
+                alpha1 = (std::min)(alpha1, static_cast<int>(block[i][3]));
+            }
+
+            // alpha0 > alpha1 selects the eight-value palette.
+            std::uint64_t indices = 0;
+            if (alpha0 != alpha1)
+            {
+                int palette[8] = { alpha0, alpha1 };
+                for (int p = 1; p < 7; ++p)
+                    palette[p + 1] = ((7 - p) * alpha0 + p * alpha1) / 7;
+
+                for (int i = 0; i < 16; ++i)
+                {
+                    int best = 0;
+                    for (int p = 1; p < 8; ++p)
+                    {
+                        if (std::abs(block[i][3] - palette[p]) < std::abs(block[i][3] - palette[best]))
+                            best = p;
+                    }
+                    indices |= static_cast<std::uint64_t>(best) << (3 * i);
+                }
+            }
+
+            out.push_back(static_cast<unsigned char>(alpha0));
+            out.push_back(static_cast<unsigned char>(alpha1));
+            for (int b = 0; b < 6; ++b)
+                out.push_back(static_cast<unsigned char>(indices >> (8 * b)));
+        }
+
+        // Bytes of one width x height level: 8 (BC1) or 16 (BC3) per 4x4 block, else raw pixels.
+        std::uint64_t LevelByteSize(BakedTextureFormat format, std::uint32_t components, std::uint64_t width, std::uint64_t height)
+        {
+            const std::uint64_t blocks = ((width + 3) / 4) * ((height + 3) / 4);
+            if (format == BakedTextureFormat::BC1)
+                return blocks * 8;
+            if (format == BakedTextureFormat::BC3)
+                return blocks * 16;
+            return width * height * components;
+        }
+
+        std::vector<unsigned char> Compress(const Image& image, BakedTextureFormat format)
+        {
+            std::vector<unsigned char> blocks;
+            const int blocksX = (image.width + 3) / 4;
+            const int blocksY = (image.height + 3) / 4;
+            unsigned char block[16][4];
+            for (int by = 0; by < blocksY; ++by)
+            {
+                for (int bx = 0; bx < blocksX; ++bx)
+                {
+                    FetchBlock(image, bx, by, block);
+                    if (format == BakedTextureFormat::BC3)
+                        EncodeAlphaBlock(block, blocks);
+                    EncodeColorBlock(block, blocks);
+                }
+            }
+            return blocks;
+        }
+    }
+
+    std::string BakedTexturePath(const std::string& sourcePath)
+    {
+        return sourcePath + ".ptex";
+    }
+
+    bool BakeTexture(const std::string& sourcePath, BakedTextureFormat format)
+    {
+        Image image;
+        unsigned char* data = stbi_load(sourcePath.c_str(), &image.width, &image.height, &image.components, 0);
+        if (!data)
+        {
+            return false;
+        }
+        image.pixels.assign(data, data + static_cast<std::size_t>(image.width) * image.height * image.components);
+        stbi_image_free(data);
+
+        // Single-channel maps would only grow as BC1.
+        if (image.components == 1)
+            format = BakedTextureFormat::Uncompressed;
+
+        FileHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.format = format;
+        header.components = static_cast<std::uint32_t>(image.components);
+        header.width = static_cast<std::uint32_t>(image.width);
+        header.height = static_cast<std::uint32_t>(image.height);
+        if (!core::GetFileStamp(sourcePath, header.source))
+        {
+            return false;
+        }
+
+        std::vector<LevelRecord> levels;
+        std::vector<std::vector<unsigned char>> levelBytes;
+        for (;;)
+        {
+            levelBytes.push_back(format == BakedTextureFormat::Uncompressed ? image.pixels : Compress(image, format));
+            levels.push_back(LevelRecord { static_cast<std::uint32_t>(image.width), static_cast<std::uint32_t>(image.height), 0, levelBytes.back().size() });
+            if (image.width == 1 && image.height == 1)
+                break;
+            image = Downsample(image);
+        }
+        header.levelCount = static_cast<std::uint32_t>(levels.size());
+
+        std::uint64_t offset = sizeof(FileHeader) + sizeof(LevelRecord) * levels.size();
+        for (auto& level : levels)
+        {
+            level.offset = offset;
+            offset += level.size;
+        }
+
+        // Write beside the target and rename, so an interrupted cook never leaves a torn file.
+        const std::string path = BakedTexturePath(sourcePath);
+        const std::string tempPath = path + ".tmp";
+        std::error_code error;
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(levels.data()), static_cast<std::streamsize>(sizeof(LevelRecord) * levels.size()));
+            for (const auto& bytes : levelBytes)
+            {
+                file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+            }
+            if (!file)
+            {
+                file.close();
+                std::filesystem::remove(tempPath, error);
+                return false;
+            }
+        }
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool LoadBakedTexture(const std::string& sourcePath, bool allowCompressed, DecodedImage& image)
+    {
+        PLANE_PROFILE_SCOPE("LoadBakedTexture");
+        auto file = std::make_shared<core::MappedFile>();
+        if (!file->Open(BakedTexturePath(sourcePath)) || file->Size() < sizeof(FileHeader))
+        {
+            return false;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, file->Data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion
+            || header.levelCount == 0 || header.components < 1 || header.components > 4)
+        {
+            return false;
+        }
+
+        unsigned int compressedFormat = 0;
+        if (header.format == BakedTextureFormat::BC1)
+            compressedFormat = kGlCompressedRgbDxt1;
+        else if (header.format == BakedTextureFormat::BC3)
+            compressedFormat = kGlCompressedRgbaDxt5;
+        else if (header.format != BakedTextureFormat::Uncompressed)
+            return false;
+        if (compressedFormat != 0 && !allowCompressed)
+        {
+            return false;
+        }
+
+        core::FileStamp source;
+        if (core::GetFileStamp(sourcePath, source) && source != header.source)
+        {
+            return false;
+        }
+
+        if (header.width == 0 || header.height == 0 || header.width > kMaxSide || header.height > kMaxSide
+            || sizeof(FileHeader) + sizeof(LevelRecord) * static_cast<std::uint64_t>(header.levelCount) > file->Size())
+        {
+            return false;
+        }
+
+        DecodedImage baked;
+        baked.path = sourcePath;
+        baked.width = static_cast<int>(header.width);
+        baked.height = static_cast<int>(header.height);
+        baked.components = static_cast<int>(header.components);
+        baked.compressedFormat = compressedFormat;
+        // GL reads each level's size from its dimensions and format, not from the record,
+        // so a table that disagrees with the header would read past the mapping.
+        std::uint64_t width = header.width;
+        std::uint64_t height = header.height;
+        for (std::uint32_t i = 0; i < header.levelCount; ++i)
+        {
+            LevelRecord record;
+            std::memcpy(&record, file->Data() + sizeof(FileHeader) + sizeof(LevelRecord) * i, sizeof(record));
+            if (i > 0)
+            {
+                if (width == 1 && height == 1)
+                {
+                    return false;
+                }
+                width = (std::max)(width / 2, std::uint64_t { 1 });
+                height = (std::max)(height / 2, std::uint64_t { 1 });
+            }
+            if (record.width != width || record.height != height
+                || record.size != LevelByteSize(header.format, header.components, width, height)
+                || record.offset > file->Size() || record.size > file->Size() - record.offset)
+            {
+                return false;
+            }
+            baked.levels.push_back(DecodedImage::Level {
+                static_cast<int>(record.width), static_cast<int>(record.height), file->Data() + record.offset, static_cast<std::size_t>(record.size) });
+        }
+        baked.storage = std::move(file);
+
+        image = std::move(baked);
+        return true;
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "TextureLoader.h"
+
+namespace plane::render
+{
+    // How a baked texture stores its pixels; chosen at cook time.
+    enum class BakedTextureFormat : std::uint32_t
+    {
+        Uncompressed = 0,  // The source's own 8-bit channels (R, RGB or RGBA).
+        BC1,               // 4 bpp, opaque RGB (S3TC DXT1).
+        BC3                // 8 bpp, RGBA with smooth alpha (S3TC DXT5).
+    };
+
+    // Cooked image next to its source: a header, a mip table and the full mip chain
+    // (box-filtered down to 1x1), optionally block compressed. Loading maps the file
+    // and points the DecodedImage levels straight into the mapping, so there is no
+    // decode and no glGenerateMipmap at runtime. The header records the source's
+    // size and timestamp so an edited source is not shadowed by an old bake.
+
+    // "<source>.ptex" next to the source file.
+    std::string BakedTexturePath(const std::string& sourcePath);
+
+    // Decodes sourcePath and writes its baked form. Returns false if the source cannot
+    // be decoded or the file cannot be written.
+    bool BakeTexture(const std::string& sourcePath, BakedTextureFormat format);
+
+    // False if there is no baked file, or it is stale, truncated, from another format
+    // version, or block compressed while allowCompressed is false.
+    bool LoadBakedTexture(const std::string& sourcePath, bool allowCompressed, DecodedImage& image);
+}
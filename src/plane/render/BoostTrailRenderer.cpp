@@ -4,10 +4,10 @@
 
 #include <glm/gtc/type_ptr.hpp>
 
-#include "core/PlaneState.h"
+#include "FrameUniforms.h"
+#include "core/Profiler.h"
 
 #include <algorithm>
-#include <cmath>
 #include <iostream>
 
 namespace plane::render
@@ -49,6 +49,7 @@ namespace plane::render
     void BoostTrailRenderer::CreateShaders()
     {
         shaderProgram_ = std::make_unique<Shader>("boost_trail.vs", "boost_trail.fs");
+        FrameUniforms::BindBlocks(shaderProgram_->ID);
     }
 
     void BoostTrailRenderer::Shutdown()
@@ -66,131 +67,45 @@ namespace plane::render
         shaderProgram_.reset();
     }
 
-    float BoostTrailRenderer::NextFloat01(std::size_t planeIndex)
+    void BoostTrailRenderer::Render(const std::vector<features::movement::BoostParticle> &particles, const Frustum &frustum, GlStateCache &state) const
     {
-        std::uint32_t &state = rngState_[planeIndex % rngState_.size()];
-        state = 1664525u * state + 1013904223u;
-        const std::uint32_t mantissa = (state >> 8) & 0x00FFFFFFu;
-        return static_cast<float>(mantissa) / static_cast<float>(0x01000000u);
-    }
-
-    glm::vec3 BoostTrailRenderer::CalculateForwardVector(const core::PlaneState &planeState) const
-    {
-        float yawRad = glm::radians(planeState.yaw);
-        float pitchRad = glm::radians(planeState.pitch);
-
-        glm::vec3 forward(
-            std::sin(yawRad) * std::cos(pitchRad),
-            -std::sin(pitchRad),
-            std::cos(yawRad) * std::cos(pitchRad));
-
-        float len = glm::length(forward);
-        if (len <= 0.0001f)
-        {
-            return glm::vec3(0.0f, 0.0f, 1.0f);
-        }
-        return forward / len;
-    }
-
-    void BoostTrailRenderer::UpdateForPlane(const core::PlaneState &planeState, float deltaTime, std::size_t planeIndex)
-    {
-        const float dt = (std::max)(0.0f, deltaTime);
-        auto &particles = particles_[planeIndex % particles_.size()];
-
-        for (auto &p : particles)
-        {
-            p.position += p.velocity * dt;
-            p.remaining -= dt;
-        }
-
-        particles.erase(
-            std::remove_if(
-                particles.begin(),
-                particles.end(),
-                [](const Particle &p)
-                { return p.remaining <= 0.0f; }),
-            particles.end());
-
-        if (!planeState.isAlive)
+        PLANE_PROFILE_SCOPE("BoostTrailRenderer::Render");
+        if (vao_ == 0 || vbo_ == 0 || shaderProgram_ == 0)
         {
             return;
         }
 
-        // Emit particles while boosting.
-        if (planeState.isBoosting)
-        {
-            constexpr float emitRatePerSecond = 55.0f;
-            emitAccumulator_[planeIndex % emitAccumulator_.size()] += emitRatePerSecond * dt;
-            int toEmit = static_cast<int>(emitAccumulator_[planeIndex % emitAccumulator_.size()]);
-            emitAccumulator_[planeIndex % emitAccumulator_.size()] -= static_cast<float>(toEmit);
-
-            glm::vec3 forward = CalculateForwardVector(planeState);
-            glm::vec3 up(0.0f, 1.0f, 0.0f);
-            glm::vec3 right = glm::normalize(glm::cross(up, forward));
-            if (glm::length(right) < 0.001f)
-            {
-                right = glm::vec3(1.0f, 0.0f, 0.0f);
-            }
-
-            // Slightly behind the plane.
-            const glm::vec3 baseSpawn = planeState.position - forward * 2.4f + up * 0.2f;
-
-            for (int i = 0; i < toEmit; ++i)
-            {
-                Particle p;
-                float side = (NextFloat01(planeIndex) - 0.5f) * 0.9f;
-                float vertical = (NextFloat01(planeIndex) - 0.5f) * 0.4f;
-                p.position = baseSpawn + right * side + up * vertical;
-
-                float speed = (std::max)(20.0f, planeState.speed);
-                glm::vec3 jitter = right * ((NextFloat01(planeIndex) - 0.5f) * 3.0f) + up * (NextFloat01(planeIndex) * 1.5f);
-                p.velocity = (-forward * (speed * 0.6f)) + jitter;
-
-                p.lifetime = 0.25f + NextFloat01(planeIndex) * 0.20f;
-                p.remaining = p.lifetime;
-                p.size = 10.0f + NextFloat01(planeIndex) * 10.0f;
-
-                // Cool blue/white trail.
-                p.color = glm::vec3(0.3f, 0.8f, 1.0f);
-                particles.push_back(p);
-            }
-        }
-        else
-        {
-            // Keep accumulator stable when not boosting.
-            emitAccumulator_[planeIndex % emitAccumulator_.size()] = 0.0f;
-        }
-    }
-
-    void BoostTrailRenderer::Render(const glm::mat4 &projection, const glm::mat4 &view) const
-    {
-        if (vao_ == 0 || vbo_ == 0 || shaderProgram_ == 0)
+        // Points are clipped by their centers, so zero-radius spheres cull exactly.
+        std::vector<glm::vec4> centers;
+        centers.reserve(particles.size());
+        for (const auto &p : particles)
         {
-            return;
+            centers.push_back(glm::vec4(p.position, 0.0f));
         }
+        std::vector<std::uint32_t> visible;
+        frustum.CullSpheres(centers.data(), centers.size(), visible);
 
         std::vector<GpuParticle> gpuParticles;
         gpuParticles.reserve(1024);
 
-        for (const auto &perPlane : particles_)
+        for (std::uint32_t index : visible)
         {
-            for (const auto &p : perPlane)
+            if (gpuParticles.size() >= 1024)
             {
-                if (gpuParticles.size() >= 1024)
-                {
-                    break;
-                }
-
-                float alpha = (std::clamp)(p.remaining / (std::max)(0.001f, p.lifetime), 0.0f, 1.0f);
-                // Fade in quickly, then fade out.
-                alpha = (std::min)(1.0f, alpha * 1.6f);
-
-                GpuParticle gp;
-                gp.position = p.position;
-                gp.color = glm::vec4(p.color, alpha);
-                gp.size = p.size;
-                gpuParticles.push_back(gp);
+                break;
             }
+
+            const auto &p = particles[index];
+
+            float alpha = (std::clamp)(p.remaining / (std::max)(0.001f, p.lifetime), 0.0f, 1.0f);
+            // Fade in quickly, then fade out.
+            alpha = (std::min)(1.0f, alpha * 1.6f);
+
+            GpuParticle gp;
+            gp.position = p.position;
+            gp.color = glm::vec4(p.color, alpha);
+            gp.size = p.size;
+            gpuParticles.push_back(gp);
         }
 
         if (gpuParticles.empty())
@@ -198,27 +113,19 @@ namespace plane::render
             return;
         }
 
-        shaderProgram_->use();
-        shaderProgram_->setMat4("projection", projection);
-        shaderProgram_->setMat4("view", view);
-
-        glBindVertexArray(vao_);
+        state.UseProgram(shaderProgram_->ID);
+        state.BindVertexArray(vao_);
         glBindBuffer(GL_ARRAY_BUFFER, vbo_);
         glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(gpuParticles.size() * sizeof(GpuParticle)), gpuParticles.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
 
-        glEnable(GL_BLEND);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE);
-        glEnable(GL_PROGRAM_POINT_SIZE);
-
-        glEnable(GL_DEPTH_TEST);
-        glDepthMask(GL_FALSE);
+        // Additive and depth-tested but not depth-written; the caller restores defaults.
+        state.SetEnabled(GL_BLEND, true);
+        state.BlendFunc(GL_SRC_ALPHA, GL_ONE);
+        state.SetEnabled(GL_PROGRAM_POINT_SIZE, true);
+        state.SetEnabled(GL_DEPTH_TEST, true);
+        state.DepthMask(false);
 
         glDrawArrays(GL_POINTS, 0, static_cast<GLsizei>(gpuParticles.size()));
-
-        glDepthMask(GL_TRUE);
-        glDisable(GL_BLEND);
-
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glBindVertexArray(0);
     }
 }
@@ -0,0 +1,146 @@
+#include "BulletRenderer.h"
+#include "FrameUniforms.h"
+#include "core/Profiler.h"
+
+#include <learnopengl/filesystem.h>
+
+#include <algorithm>
+#include <cstddef>
+
+namespace plane::render
+{
+    namespace
+    {
+        // After the Mesh vertex layout (0-6).
+        constexpr GLuint kInstancePositionLocation = 7;
+        constexpr GLuint kInstanceDirectionLocation = 8;
+
+        constexpr std::size_t kInitialInstanceCapacity = 256;
+
+        // Must match kBulletScale in bullet.vs.
+        constexpr float kBulletScale = 0.25f;
+    }
+
+    void BulletRenderer::Initialize(AssetCache& assets, AssetStreamer& streamer)
+    {
+        // Lit and shadowed like the planes, with the model matrix built per instance.
+        shader_ = std::make_unique<Shader>("bullet.vs", "plane.fs");
+        FrameUniforms::BindBlocks(shader_->ID);
+        Mesh::BindSamplerUnits(*shader_);
+        shader_->setInt("shadowMap", 1);
+
+        instanceCapacity_ = kInitialInstanceCapacity;
+        glGenBuffers(1, &instanceVbo_);
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity_ * sizeof(Instance)), nullptr, GL_STREAM_DRAW);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // Load bullet model once; Submit queues nothing until it arrives.
+        assets.LoadModelAsync(streamer, FileSystem::getPath("resources/objects/bullet/Bullet.dae"), StreamPriority::Normal,
+            [this](std::shared_ptr<Model> model)
+            {
+                bulletModel_ = std::move(model);
+                AttachInstanceBuffer();
+            });
+    }
+
+    void BulletRenderer::AttachInstanceBuffer()
+    {
+        // Only this renderer loads the bullet model, so its VAOs can carry the extra attributes.
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+        for (const Mesh& mesh : bulletModel_->meshes)
+        {
+            glBindVertexArray(mesh.VAO);
+            glEnableVertexAttribArray(kInstancePositionLocation);
+            glVertexAttribPointer(kInstancePositionLocation, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, position));
+            glVertexAttribDivisor(kInstancePositionLocation, 1);
+            glEnableVertexAttribArray(kInstanceDirectionLocation);
+            glVertexAttribPointer(kInstanceDirectionLocation, 3, GL_FLOAT, GL_FALSE, sizeof(Instance), (void*)offsetof(Instance, direction));
+            glVertexAttribDivisor(kInstanceDirectionLocation, 1);
+        }
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+    }
+
+    void BulletRenderer::Shutdown()
+    {
+        if (instanceVbo_ != 0)
+        {
+            glDeleteBuffers(1, &instanceVbo_);
+            instanceVbo_ = 0;
+        }
+        shader_.reset();
+        bulletModel_.reset();
+    }
+
+    void BulletRenderer::Update(const std::vector<features::shooting::Bullet>& bullets)
+    {
+        PLANE_PROFILE_SCOPE("BulletRenderer::Update");
+        instances_.clear();
+        bounds_.clear();
+        if (!bulletModel_)
+        {
+            return;
+        }
+
+        // One sphere around every mesh of the model, scaled like bullet.vs does.
+        float radius = 0.0f;
+        for (const Mesh& mesh : bulletModel_->meshes)
+        {
+            radius = (std::max)(radius, glm::length(glm::max(glm::abs(mesh.boundsMin), glm::abs(mesh.boundsMax))));
+        }
+        radius *= kBulletScale;
+
+        for (const auto& bullet : bullets)
+        {
+            instances_.push_back(Instance { bullet.position, bullet.velocity });
+            bounds_.push_back(glm::vec4(bullet.position, radius));
+        }
+    }
+
+    void BulletRenderer::Submit(RenderQueue& queue, const Frustum& frustum, const glm::vec3& viewPos)
+    {
+        PLANE_PROFILE_SCOPE("BulletRenderer::Submit");
+        if (instances_.empty() || !bulletModel_)
+        {
+            return;
+        }
+
+        visible_.clear();
+        frustum.CullSpheres(bounds_.data(), bounds_.size(), visible_);
+        if (visible_.empty())
+        {
+            return;
+        }
+
+        visibleInstances_.clear();
+        for (std::uint32_t index : visible_)
+        {
+            visibleInstances_.push_back(instances_[index]);
+        }
+
+        glBindBuffer(GL_ARRAY_BUFFER, instanceVbo_);
+        while (instanceCapacity_ < visibleInstances_.size())
+        {
+            instanceCapacity_ *= 2;
+        }
+        // Orphan the previous view's storage so the upload never waits on its draws.
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(instanceCapacity_ * sizeof(Instance)), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, static_cast<GLsizeiptr>(visibleInstances_.size() * sizeof(Instance)), visibleInstances_.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        // One item per mesh; the instances spread everywhere, so depth orders by the first.
+        const float depth = glm::length(visibleInstances_.front().position - viewPos);
+        for (const Mesh& mesh : bulletModel_->meshes)
+        {
+            DrawItem item;
+            item.program = shader_->ID;
+            item.vao = mesh.VAO;
+            item.count = static_cast<GLsizei>(mesh.indices.size());
+            item.instanceCount = static_cast<GLsizei>(visibleInstances_.size());
+            item.textures = mesh.material.data();
+            item.textureCount = static_cast<std::uint32_t>(mesh.material.size());
+            queue.Submit(RenderPass::Opaque, item, depth);
+        }
+    }
+}
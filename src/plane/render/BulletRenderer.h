@@ -0,0 +1,50 @@
+#pragma once
+
+#include <learnopengl/model.h>
+#include <learnopengl/shader_m.h>
+
+#include <memory>
+#include <vector>
+
+#include "AssetCache.h"
+#include "Frustum.h"
+#include "RenderQueue.h"
+#include "features/shooting/ShootingSystem.h"
+
+namespace plane::render
+{
+    // Draws the shooting system's bullets; the simulation side never touches the model.
+    // Each view's visible bullets go out as one instanced draw per bullet mesh: positions
+    // and directions are streamed into an instance buffer and bullet.vs builds each one's basis.
+    class BulletRenderer
+    {
+    public:
+        void Initialize(AssetCache& assets, AssetStreamer& streamer);
+        void Shutdown();
+
+        // Gathers this frame's bullets; once per frame, before any Submit.
+        void Update(const std::vector<features::shooting::Bullet>& bullets);
+        // Streams the bullets inside the frustum to the GPU and queues their instanced
+        // draws. The queue must be executed before the next Submit reuses the buffer.
+        void Submit(RenderQueue& queue, const Frustum& frustum, const glm::vec3& viewPos);
+
+    private:
+        struct Instance
+        {
+            glm::vec3 position;
+            glm::vec3 direction;    // Velocity; normalized in the shader.
+        };
+
+        // Adds the instance attributes to every mesh VAO of the bullet model.
+        void AttachInstanceBuffer();
+
+        std::shared_ptr<Model> bulletModel_;
+        std::unique_ptr<Shader> shader_;
+        unsigned int instanceVbo_ { 0 };
+        std::size_t instanceCapacity_ { 0 };
+        std::vector<Instance> instances_;
+        std::vector<glm::vec4> bounds_;             // Bounding sphere per instance.
+        std::vector<std::uint32_t> visible_;
+        std::vector<Instance> visibleInstances_;
+    };
+}
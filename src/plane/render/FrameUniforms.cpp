@@ -0,0 +1,81 @@
+#include "FrameUniforms.h"
+
+#include <cassert>
+
+namespace plane::render
+{
+    namespace
+    {
+        GLintptr AlignUp(GLintptr size, GLintptr alignment)
+        {
+            return (size + alignment - 1) / alignment * alignment;
+        }
+
+        void BindBlock(GLuint program, const char* name, GLuint binding)
+        {
+            const GLuint index = glGetUniformBlockIndex(program, name);
+            if (index != GL_INVALID_INDEX)
+            {
+                glUniformBlockBinding(program, index, binding);
+            }
+        }
+    }
+
+    void FrameUniforms::Initialize(std::size_t viewCount)
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        alignment = (alignment > 0) ? alignment : 256;
+
+        viewCount_ = viewCount;
+        frameStride_ = AlignUp(sizeof(FrameBlock), alignment);
+        viewStride_ = AlignUp(sizeof(ViewBlock), alignment);
+
+        glGenBuffers(1, &ubo_);
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferData(GL_UNIFORM_BUFFER, ViewOffset(viewCount_), nullptr, GL_DYNAMIC_DRAW);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+
+    void FrameUniforms::Shutdown()
+    {
+        if (ubo_ != 0)
+        {
+            glDeleteBuffers(1, &ubo_);
+            ubo_ = 0;
+        }
+    }
+
+    void FrameUniforms::BindBlocks(GLuint program)
+    {
+        BindBlock(program, "FrameBlock", FrameBinding);
+        BindBlock(program, "ViewBlock", ViewBinding);
+    }
+
+    GLintptr FrameUniforms::ViewOffset(std::size_t viewIndex) const
+    {
+        return frameStride_ + static_cast<GLintptr>(viewIndex) * viewStride_;
+    }
+
+    void FrameUniforms::SetFrame(const glm::mat4& lightSpaceMatrix, const glm::vec3& lightDir)
+    {
+        const FrameBlock block { lightSpaceMatrix, glm::vec4(glm::normalize(lightDir), 0.0f) };
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(block), &block);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferRange(GL_UNIFORM_BUFFER, FrameBinding, ubo_, 0, sizeof(FrameBlock));
+    }
+
+    void FrameUniforms::SetView(std::size_t viewIndex, const glm::mat4& projection, const glm::mat4& view, const glm::vec3& viewPos)
+    {
+        assert(viewIndex < viewCount_);
+        // Each viewport owns a slot, so the second upload never waits on draws
+        // still reading the first.
+        const ViewBlock block { projection, view, glm::vec4(viewPos, 1.0f) };
+        const GLintptr offset = ViewOffset(viewIndex);
+        glBindBuffer(GL_UNIFORM_BUFFER, ubo_);
+        glBufferSubData(GL_UNIFORM_BUFFER, offset, sizeof(block), &block);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        glBindBufferRange(GL_UNIFORM_BUFFER, ViewBinding, ubo_, offset, sizeof(ViewBlock));
+    }
+}
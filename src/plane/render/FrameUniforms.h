@@ -0,0 +1,54 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+
+namespace plane::render
+{
+    // std140 uniform blocks shared by every program that declares them. The frame
+    // block changes once per frame, the view block once per viewport; programs pick
+    // both up from fixed binding points instead of each getting its own copies.
+    // Members mirror the GLSL declarations in the .vs/.fs files, vec3s padded to vec4.
+    struct FrameBlock
+    {
+        glm::mat4 lightSpaceMatrix;
+        glm::vec4 lightDir;     // xyz normalized, w unused.
+    };
+
+    struct ViewBlock
+    {
+        glm::mat4 projection;
+        glm::mat4 view;
+        glm::vec4 viewPos;      // xyz camera position, w unused.
+    };
+
+    class FrameUniforms
+    {
+    public:
+        static constexpr GLuint FrameBinding = 0;
+        static constexpr GLuint ViewBinding = 1;
+
+        // One buffer holding the frame block and viewCount view blocks.
+        void Initialize(std::size_t viewCount);
+        void Shutdown();
+
+        // Points the program's FrameBlock/ViewBlock (whichever it declares) at the
+        // shared binding points. Call once after linking.
+        static void BindBlocks(GLuint program);
+
+        void SetFrame(const glm::mat4& lightSpaceMatrix, const glm::vec3& lightDir);
+        // Uploads the view's block and binds it for the draws that follow.
+        void SetView(std::size_t viewIndex, const glm::mat4& projection, const glm::mat4& view, const glm::vec3& viewPos);
+
+    private:
+        GLintptr ViewOffset(std::size_t viewIndex) const;
+
+        GLuint ubo_ { 0 };
+        std::size_t viewCount_ { 0 };
+        // Block size rounded up to GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT.
+        GLintptr frameStride_ { 0 };
+        GLintptr viewStride_ { 0 };
+    };
+}
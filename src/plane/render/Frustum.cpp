@@ -0,0 +1,116 @@
+#include "Frustum.h"
+
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLANE_FRUSTUM_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace plane::render
+{
+    Aabb Aabb::Transformed(const glm::mat4& transform) const
+    {
+        // Center moves with the transform; extents grow by the absolute basis.
+        const glm::vec3 center = glm::vec3(transform * glm::vec4(0.5f * (min + max), 1.0f));
+        const glm::vec3 extent = 0.5f * (max - min);
+        const glm::mat3 basis(transform);
+        const glm::vec3 worldExtent(
+            std::abs(basis[0].x) * extent.x + std::abs(basis[1].x) * extent.y + std::abs(basis[2].x) * extent.z,
+            std::abs(basis[0].y) * extent.x + std::abs(basis[1].y) * extent.y + std::abs(basis[2].y) * extent.z,
+            std::abs(basis[0].z) * extent.x + std::abs(basis[1].z) * extent.y + std::abs(basis[2].z) * extent.z);
+        return Aabb { center - worldExtent, center + worldExtent };
+    }
+
+    Frustum Frustum::FromMatrix(const glm::mat4& m)
+    {
+        // Gribb-Hartmann: each plane is the last row of the matrix plus or minus another row.
+        const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+        const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+        const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+        const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+        Frustum frustum;
+        frustum.planes_ = { row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2 };
+        for (glm::vec4& plane : frustum.planes_)
+        {
+            const float length = glm::length(glm::vec3(plane));
+            if (length > 0.0f)
+            {
+                plane /= length;
+            }
+        }
+        return frustum;
+    }
+
+    bool Frustum::IntersectsSphere(const glm::vec3& center, float radius) const
+    {
+        for (const glm::vec4& plane : planes_)
+        {
+            if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::IntersectsBox(const Aabb& box) const
+    {
+        for (const glm::vec4& plane : planes_)
+        {
+            // Corner farthest along the plane normal.
+            const glm::vec3 corner(
+                plane.x >= 0.0f ? box.max.x : box.min.x,
+                plane.y >= 0.0f ? box.max.y : box.min.y,
+                plane.z >= 0.0f ? box.max.z : box.min.z);
+            if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    void Frustum::CullSpheres(const glm::vec4* spheres, std::size_t count, std::vector<std::uint32_t>& visible) const
+    {
+        std::size_t i = 0;
+#ifdef PLANE_FRUSTUM_SSE
+        for (; i + 4 <= count; i += 4)
+        {
+            // Transpose four xyzr spheres into x, y, z and r lanes.
+            __m128 x = _mm_loadu_ps(&spheres[i].x);
+            __m128 y = _mm_loadu_ps(&spheres[i + 1].x);
+            __m128 z = _mm_loadu_ps(&spheres[i + 2].x);
+            __m128 r = _mm_loadu_ps(&spheres[i + 3].x);
+            _MM_TRANSPOSE4_PS(x, y, z, r);
+            const __m128 negativeRadius = _mm_sub_ps(_mm_setzero_ps(), r);
+
+            __m128 outside = _mm_setzero_ps();
+            for (const glm::vec4& plane : planes_)
+            {
+                __m128 distance = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_set1_ps(plane.w));
+                distance = _mm_add_ps(distance, _mm_mul_ps(y, _mm_set1_ps(plane.y)));
+                distance = _mm_add_ps(distance, _mm_mul_ps(z, _mm_set1_ps(plane.z)));
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(distance, negativeRadius));
+            }
+
+            const int outsideMask = _mm_movemask_ps(outside);
+            for (int lane = 0; lane < 4; ++lane)
+            {
+                if ((outsideMask & (1 << lane)) == 0)
+                {
+                    visible.push_back(static_cast<std::uint32_t>(i + lane));
+                }
+            }
+        }
+#endif
+        for (; i < count; ++i)
+        {
+            if (IntersectsSphere(glm::vec3(spheres[i]), spheres[i].w))
+            {
+                visible.push_back(static_cast<std::uint32_t>(i));
+            }
+        }
+    }
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace plane::render
+{
+    struct Aabb
+    {
+        glm::vec3 min { 0.0f };
+        glm::vec3 max { 0.0f };
+
+        // Box around this one after an affine transform.
+        Aabb Transformed(const glm::mat4& transform) const;
+    };
+
+    // The six clip planes of a view-projection matrix, normals pointing inward. Tests
+    // are conservative: anything touching the frustum counts as visible.
+    class Frustum
+    {
+    public:
+        // Works for perspective and orthographic (light-space) matrices alike.
+        static Frustum FromMatrix(const glm::mat4& viewProjection);
+
+        bool IntersectsSphere(const glm::vec3& center, float radius) const;
+        bool IntersectsBox(const Aabb& box) const;
+
+        // Appends the index of every sphere (xyz center, w radius) inside the frustum,
+        // in order. Tests four spheres per step where SSE is available.
+        void CullSpheres(const glm::vec4* spheres, std::size_t count, std::vector<std::uint32_t>& visible) const;
+
+    private:
+        // xyz normal, w distance: a point p is inside when dot(xyz, p) + w >= 0.
+        std::array<glm::vec4, 6> planes_;
+    };
+}
@@ -0,0 +1,137 @@
+#include "GlStateCache.h"
+
+namespace plane::render
+{
+    namespace
+    {
+        // Slot of a tracked cap in caps_, or -1.
+        int CapSlot(GLenum cap)
+        {
+            switch (cap)
+            {
+            case GL_BLEND: return 0;
+            case GL_DEPTH_TEST: return 1;
+            case GL_CULL_FACE: return 2;
+            case GL_PROGRAM_POINT_SIZE: return 3;
+            default: return -1;
+            }
+        }
+    }
+
+    void GlStateCache::Invalidate()
+    {
+        program_ = kUnknown;
+        vao_ = kUnknown;
+        activeUnit_ = kUnknown;
+        textures_.fill(kUnknown);
+        textureArrays_.fill(kUnknown);
+        caps_.fill(TriState::Unknown);
+        depthMask_ = TriState::Unknown;
+        blendSource_ = 0;
+        blendDestination_ = 0;
+    }
+
+    void GlStateCache::RestoreDefaults()
+    {
+        SetEnabled(GL_BLEND, false);
+        DepthMask(true);
+        BindVertexArray(0);
+        if (activeUnit_ != 0)
+        {
+            glActiveTexture(GL_TEXTURE0);
+            activeUnit_ = 0;
+        }
+    }
+
+    void GlStateCache::UseProgram(GLuint program)
+    {
+        if (program_ != program)
+        {
+            glUseProgram(program);
+            program_ = program;
+        }
+    }
+
+    void GlStateCache::BindVertexArray(GLuint vao)
+    {
+        if (vao_ != vao)
+        {
+            glBindVertexArray(vao);
+            vao_ = vao;
+        }
+    }
+
+    void GlStateCache::BindTexture2D(GLuint unit, GLuint texture)
+    {
+        if (unit < kTextureUnits && textures_[unit] == texture)
+        {
+            return;
+        }
+        if (activeUnit_ != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            activeUnit_ = unit;
+        }
+        glBindTexture(GL_TEXTURE_2D, texture);
+        if (unit < kTextureUnits)
+        {
+            textures_[unit] = texture;
+        }
+    }
+
+    void GlStateCache::BindTexture2DArray(GLuint unit, GLuint texture)
+    {
+        if (unit < kTextureUnits && textureArrays_[unit] == texture)
+        {
+            return;
+        }
+        if (activeUnit_ != unit)
+        {
+            glActiveTexture(GL_TEXTURE0 + unit);
+            activeUnit_ = unit;
+        }
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        if (unit < kTextureUnits)
+        {
+            textureArrays_[unit] = texture;
+        }
+    }
+
+    void GlStateCache::SetEnabled(GLenum cap, bool enabled)
+    {
+        const TriState wanted = enabled ? TriState::On : TriState::Off;
+        const int slot = CapSlot(cap);
+        if (slot >= 0 && caps_[slot] == wanted)
+        {
+            return;
+        }
+        if (enabled)
+            glEnable(cap);
+        else
+            glDisable(cap);
+        if (slot >= 0)
+        {
+            caps_[slot] = wanted;
+        }
+    }
+
+    void GlStateCache::DepthMask(bool enabled)
+    {
+        const TriState wanted = enabled ? TriState::On : TriState::Off;
+        if (depthMask_ != wanted)
+        {
+            glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+            depthMask_ = wanted;
+        }
+    }
+
+    void GlStateCache::BlendFunc(GLenum source, GLenum destination)
+    {
+        if (blendSource_ != source || blendDestination_ != destination)
+        {
+            glBlendFunc(source, destination);
+            blendSource_ = source;
+            blendDestination_ = destination;
+        }
+    }
+}
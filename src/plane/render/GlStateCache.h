@@ -0,0 +1,51 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <array>
+#include <cstddef>
+
+namespace plane::render
+{
+    // Shadows the bits of GL state the render queue touches and drops calls that
+    // would set what is already set. It only knows about changes made through it:
+    // call Invalidate before using it after any code that talks to GL directly.
+    class GlStateCache
+    {
+    public:
+        GlStateCache() { Invalidate(); }
+
+        // Forgets everything, so the next call of each kind reaches GL.
+        void Invalidate();
+        // Blend off, depth writes on, no VAO, texture unit 0 active.
+        void RestoreDefaults();
+
+        void UseProgram(GLuint program);
+        void BindVertexArray(GLuint vao);
+        void BindTexture2D(GLuint unit, GLuint texture);
+        // Array bindings are tracked apart from 2D ones; a unit holds one of each.
+        void BindTexture2DArray(GLuint unit, GLuint texture);
+        // GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE and GL_PROGRAM_POINT_SIZE are tracked;
+        // other caps always reach GL.
+        void SetEnabled(GLenum cap, bool enabled);
+        void DepthMask(bool enabled);
+        void BlendFunc(GLenum source, GLenum destination);
+
+    private:
+        static constexpr GLuint kUnknown = ~0u;
+        static constexpr std::size_t kTextureUnits = 16;
+        static constexpr std::size_t kTrackedCaps = 4;
+
+        enum class TriState : unsigned char { Unknown, Off, On };
+
+        GLuint program_ { kUnknown };
+        GLuint vao_ { kUnknown };
+        GLuint activeUnit_ { kUnknown };
+        std::array<GLuint, kTextureUnits> textures_;
+        std::array<GLuint, kTextureUnits> textureArrays_;
+        std::array<TriState, kTrackedCaps> caps_;
+        TriState depthMask_ { TriState::Unknown };
+        GLenum blendSource_ { 0 };
+        GLenum blendDestination_ { 0 };
+    };
+}
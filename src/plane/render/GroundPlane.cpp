@@ -2,7 +2,10 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
+#include <cmath>
+
 #include "TextureLoader.h"
+#include "core/Profiler.h"
 
 namespace plane::render
 {
@@ -12,9 +15,10 @@ namespace plane::render
         constexpr float kGroundSize = 1500.0f;  // 5x larger
     }
 
-    bool GroundPlane::Initialize(const std::string& texturePath)
+    bool GroundPlane::Initialize(const DecodedImage& texture)
     {
-        texture_ = LoadTexture(texturePath);
+        texture_ = UploadTexture(texture);
+        textureBinding_ = TextureBinding { 0, texture_ };
 
         // Large tiled quad that the world hovers over.
         float groundVertices[] = {
@@ -48,26 +52,26 @@ namespace plane::render
         return true;
     }
 
-    void GroundPlane::Draw(Shader& shader, bool bindTexture) const
+    void GroundPlane::Submit(RenderQueue& queue, GLuint program, const Frustum& frustum, const glm::vec3& viewPos) const
     {
-        glm::mat4 groundModel = glm::mat4(1.0f);
-        shader.setMat4("model", groundModel);
-
-        if (bindTexture && texture_ != 0)
+        // Snapped to whole texture repeats, so the water does not swim as the quad follows.
+        const float period = 2.0f * kGroundSize / kTileRepeat;
+        const glm::vec3 center(std::floor(viewPos.x / period) * period, 0.0f, std::floor(viewPos.z / period) * period);
+        const Aabb bounds { center - glm::vec3(kGroundSize, 0.0f, kGroundSize), center + glm::vec3(kGroundSize, 0.0f, kGroundSize) };
+        if (vao_ == 0 || !frustum.IntersectsBox(bounds))
         {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, texture_);
-            shader.setInt("texture_diffuse1", 0);
+            return;
         }
 
-        glBindVertexArray(vao_);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        glBindVertexArray(0);
-
-        if (bindTexture)
-        {
-            glBindTexture(GL_TEXTURE_2D, 0);
-        }
+        DrawItem item;
+        item.program = program;
+        item.vao = vao_;
+        item.count = 6;
+        item.indexed = false;
+        item.textures = &textureBinding_;
+        item.textureCount = (texture_ != 0) ? 1 : 0;
+        item.model = glm::translate(glm::mat4(1.0f), center);
+        queue.Submit(RenderPass::Background, item, 0.0f);
     }
 
     void GroundPlane::Shutdown()
@@ -5,21 +5,26 @@
 
 #include <learnopengl/shader_m.h>
 
-#include <string>
+#include "Frustum.h"
+#include "RenderQueue.h"
+#include "TextureLoader.h"
 
 namespace plane::render
 {
     class GroundPlane
     {
     public:
-        bool Initialize(const std::string& texturePath);
-        void Draw(Shader& shader, bool bindTexture = true) const;
+        bool Initialize(const DecodedImage& texture);
+        // Queues the quad for the given program, ahead of everything else, if it is in view.
+        // It is centred under viewPos, so the water reaches the far plane wherever the view is.
+        void Submit(RenderQueue& queue, GLuint program, const Frustum& frustum, const glm::vec3& viewPos) const;
         void Shutdown();
 
     private:
         unsigned int vao_ { 0 };
         unsigned int vbo_ { 0 };
         unsigned int texture_ { 0 };
+        TextureBinding textureBinding_ { 0, 0 };
     };
 }
 
@@ -1,4 +1,5 @@
 #include "HealthBarRenderer.h"
+#include "FrameUniforms.h"
 
 #include <glad/glad.h>
 #include <glm/gtc/constants.hpp>
@@ -9,6 +10,7 @@
 
 #include "core/PlaneState.h"
 #include "core/CameraRig.h"
+#include "core/Profiler.h"
 
 namespace plane::render
 {
@@ -62,6 +64,7 @@ namespace plane::render
     {
         uiShaderProgram_ = std::make_unique<Shader>("ui.vs", "ui.fs");
         billboardShaderProgram_ = std::make_unique<Shader>("billboard.vs", "billboard.fs");
+        FrameUniforms::BindBlocks(billboardShaderProgram_->ID);
         enemyGuideShaderProgram_ = std::make_unique<Shader>("enemy_target_guide.vs", "enemy_target_guide.fs");
     }
 
@@ -96,6 +99,7 @@ namespace plane::render
                                                    int viewportX, int viewportY,
                                                    int viewportWidth, int viewportHeight) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderPlayerHealthBar");
         if (!playerState.isAlive || barVao_ == 0 || uiShaderProgram_ == 0)
         {
             return;
@@ -147,10 +151,10 @@ namespace plane::render
     }
 
     void HealthBarRenderer::RenderEnemyHealthBar(const core::PlaneState& enemyState,
-                                                 const glm::mat4& projection,
                                                  const glm::mat4& view,
                                                  const glm::vec3& cameraPos) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderEnemyHealthBar");
         if (!enemyState.isAlive || barVao_ == 0 || billboardShaderProgram_ == 0)
         {
             return;
@@ -173,8 +177,6 @@ namespace plane::render
         glDisable(GL_DEPTH_TEST);
 
         // Draw background (dark red)
-        billboardShaderProgram_->setMat4("projection", projection);
-        billboardShaderProgram_->setMat4("view", view);
         billboardShaderProgram_->setVec3("worldPos", barWorldPos);
         billboardShaderProgram_->setVec3("cameraRight", cameraRight);
         billboardShaderProgram_->setVec3("cameraUp", cameraUp);
@@ -194,12 +196,12 @@ namespace plane::render
     }
     
     void HealthBarRenderer::RenderPlayerHealthBillboard(const core::PlaneState& playerState,
-                                                        const glm::mat4& projection,
                                                         const glm::mat4& view,
                                                         const glm::vec3& cameraPos,
                                                         const glm::vec3& cameraFront,
                                                         const glm::vec3& cameraUp) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderPlayerHealthBillboard");
         if (!playerState.isAlive || barVao_ == 0 || billboardShaderProgram_ == 0)
         {
             return;
@@ -220,8 +222,6 @@ namespace plane::render
         glDisable(GL_DEPTH_TEST);
 
         // Background
-        billboardShaderProgram_->setMat4("projection", projection);
-        billboardShaderProgram_->setMat4("view", view);
         billboardShaderProgram_->setVec3("worldPos", barWorldPos);
         billboardShaderProgram_->setVec3("cameraRight", camRight);
         billboardShaderProgram_->setVec3("cameraUp", camUp);
@@ -241,12 +241,12 @@ namespace plane::render
     }
 
     void HealthBarRenderer::RenderPlayerBoosterBillboard(const core::PlaneState& playerState,
-                                                         const glm::mat4& projection,
                                                          const glm::mat4& view,
                                                          const glm::vec3& cameraPos,
                                                          const glm::vec3& cameraFront,
                                                          const glm::vec3& cameraUp) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderPlayerBoosterBillboard");
         if (!playerState.isAlive || barVao_ == 0 || billboardShaderProgram_ == 0)
         {
             return;
@@ -266,8 +266,6 @@ namespace plane::render
         glBindVertexArray(barVao_);
         glDisable(GL_DEPTH_TEST);
 
-        billboardShaderProgram_->setMat4("projection", projection);
-        billboardShaderProgram_->setMat4("view", view);
         billboardShaderProgram_->setVec3("worldPos", barWorldPos);
         billboardShaderProgram_->setVec3("cameraRight", camRight);
         billboardShaderProgram_->setVec3("cameraUp", camUp);
@@ -292,9 +290,9 @@ namespace plane::render
     }
 
     void HealthBarRenderer::RenderAimingReticle(const core::PlaneState& planeState,
-                                                const glm::mat4& projection,
                                                 const glm::mat4& view) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderAimingReticle");
         if (barVao_ == 0 || billboardShaderProgram_ == 0)
         {
             return;
@@ -324,8 +322,6 @@ namespace plane::render
 
         // Small square reticle (shrunk to 1/4 size)
         const float reticleSize = 0.1f;
-        billboardShaderProgram_->setMat4("projection", projection);
-        billboardShaderProgram_->setMat4("view", view);
         billboardShaderProgram_->setVec3("worldPos", reticlePos);
         billboardShaderProgram_->setVec3("cameraRight", camRight);
         billboardShaderProgram_->setVec3("cameraUp", camUp);
@@ -341,6 +337,7 @@ namespace plane::render
                                                    const glm::mat4& projection,
                                                    const glm::mat4& view) const
     {
+        PLANE_PROFILE_SCOPE("HealthBarRenderer::RenderEnemyTargetGuide");
         if (!enemyState.isAlive || guideVao_ == 0 || enemyGuideShaderProgram_ == 0)
         {
             return;
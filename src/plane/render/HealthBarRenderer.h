@@ -13,6 +13,8 @@ namespace plane::core
 
 namespace plane::render
 {
+    // World-space billboards take the camera from the shared ViewBlock; view is only
+    // passed where the CPU still needs the camera axes.
     class HealthBarRenderer
     {
     public:
@@ -26,7 +28,6 @@ namespace plane::render
 
         // Render player's own health bar as a camera-anchored billboard in world space
         void RenderPlayerHealthBillboard(const core::PlaneState& playerState,
-                         const glm::mat4& projection,
                          const glm::mat4& view,
                          const glm::vec3& cameraPos,
                          const glm::vec3& cameraFront,
@@ -34,7 +35,6 @@ namespace plane::render
 
         // Render player's booster fuel bar under the health billboard.
         void RenderPlayerBoosterBillboard(const core::PlaneState& playerState,
-                         const glm::mat4& projection,
                          const glm::mat4& view,
                          const glm::vec3& cameraPos,
                          const glm::vec3& cameraFront,
@@ -42,13 +42,11 @@ namespace plane::render
         
         // Render enemy health bar above enemy plane (3D billboard)
         void RenderEnemyHealthBar(const core::PlaneState& enemyState,
-                                 const glm::mat4& projection,
                                  const glm::mat4& view,
                                  const glm::vec3& cameraPos) const;
 
         // Render a simple plane-anchored aiming reticle
         void RenderAimingReticle(const core::PlaneState& planeState,
-                     const glm::mat4& projection,
                      const glm::mat4& view) const;
 
         // Render an on-screen/off-screen enemy target guide arrow
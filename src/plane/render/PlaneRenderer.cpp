@@ -1,12 +1,14 @@
 #include "PlaneRenderer.h"
 #include "../app/Plane.h"
+#include "core/Profiler.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
 namespace plane::render
 {
-    void PlaneRenderer::Draw(app::Plane& plane, Shader& shader, const core::PlaneState& planeState) const
+    void PlaneRenderer::Submit(app::Plane& plane, RenderQueue& queue, GLuint program, const Frustum& frustum, const core::PlaneState& planeState, const glm::vec3& viewPos) const
     {
+        PLANE_PROFILE_SCOPE("PlaneRenderer::Submit");
         glm::mat4 base = glm::mat4(1.0f);
         base = glm::translate(base, planeState.position);
         base = glm::rotate(base, glm::radians(planeState.yaw), glm::vec3(0.0f, 1.0f, 0.0f));
@@ -14,7 +16,8 @@ namespace plane::render
         base = glm::rotate(base, glm::radians(planeState.roll), glm::vec3(0.0f, 0.0f, 1.0f));
         base = glm::scale(base, glm::vec3(0.006f, 0.006f, 0.006f));
 
-        plane.Draw(shader, base);
+        plane.ApplyControlSurfaces(planeState);
+        plane.Submit(queue, program, frustum, base, glm::length(planeState.position - viewPos));
     }
 }
 
@@ -3,6 +3,8 @@
 #include <glm/glm.hpp>
 #include <learnopengl/shader_m.h>
 
+#include "Frustum.h"
+#include "RenderQueue.h"
 #include "core/PlaneState.h"
 
 namespace plane::app { class Plane; }
@@ -12,7 +14,8 @@ namespace plane::render
     class PlaneRenderer
     {
     public:
-        void Draw(app::Plane& plane, Shader& shader, const core::PlaneState& planeState) const;
+        // Poses the plane's control surfaces from planeState, then queues every part in view.
+        void Submit(app::Plane& plane, RenderQueue& queue, GLuint program, const Frustum& frustum, const core::PlaneState& planeState, const glm::vec3& viewPos) const;
     };
 }
 
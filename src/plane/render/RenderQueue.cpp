@@ -0,0 +1,154 @@
+#include "RenderQueue.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <array>
+
+namespace plane::render
+{
+    namespace
+    {
+        constexpr int kPassShift = 60;
+        constexpr int kProgramShift = 48;
+        constexpr int kMaterialShift = 24;
+        constexpr std::uint64_t kProgramMask = 0xFFF;
+        constexpr std::uint64_t kMaterialMask = 0xFFFFFF;
+        constexpr std::uint64_t kDepthMask = 0xFFFFFF;
+
+        // Anything farther sorts as if at this distance; beyond the far plane anyway.
+        constexpr float kMaxSortDepth = 4096.0f;
+
+        void ApplyPassState(RenderPass pass, GlStateCache& state)
+        {
+            state.SetEnabled(GL_DEPTH_TEST, true);
+            if (pass == RenderPass::Transparent)
+            {
+                state.SetEnabled(GL_BLEND, true);
+                state.BlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                state.DepthMask(false);
+            }
+            else
+            {
+                state.SetEnabled(GL_BLEND, false);
+                state.DepthMask(true);
+            }
+        }
+    }
+
+    std::uint64_t RenderQueue::MakeSortKey(RenderPass pass, GLuint program, GLuint material, float depth)
+    {
+        const float normalized = std::clamp(depth / kMaxSortDepth, 0.0f, 1.0f);
+        std::uint64_t depthBits = static_cast<std::uint64_t>(normalized * static_cast<float>(kDepthMask));
+        if (pass == RenderPass::Transparent)
+        {
+            depthBits = kDepthMask - depthBits;
+        }
+        return (static_cast<std::uint64_t>(pass) << kPassShift)
+            | ((program & kProgramMask) << kProgramShift)
+            | ((material & kMaterialMask) << kMaterialShift)
+            | (depthBits & kDepthMask);
+    }
+
+    void RenderQueue::Clear()
+    {
+        items_.clear();
+        order_.clear();
+    }
+
+    void RenderQueue::Submit(RenderPass pass, const DrawItem& item, float depth)
+    {
+        const GLuint material = (item.textureCount > 0) ? item.textures[0].id : 0;
+        order_.push_back(SortEntry { MakeSortKey(pass, item.program, material, depth), static_cast<std::uint32_t>(items_.size()) });
+        items_.push_back(item);
+    }
+
+    void RenderQueue::Sort()
+    {
+        PLANE_PROFILE_SCOPE("RenderQueue::Sort");
+        // LSD radix sort, one byte per pass. Bytes every key shares (usually pass and
+        // program) are skipped, so a typical view costs three or four passes.
+        scratch_.resize(order_.size());
+        for (int shift = 0; shift < 64; shift += 8)
+        {
+            std::array<std::uint32_t, 256> counts {};
+            for (const SortEntry& entry : order_)
+            {
+                ++counts[(entry.key >> shift) & 0xFF];
+            }
+            if (std::find(counts.begin(), counts.end(), order_.size()) != counts.end())
+            {
+                continue;
+            }
+
+            std::uint32_t offset = 0;
+            for (auto& count : counts)
+            {
+                const std::uint32_t bucketSize = count;
+                count = offset;
+                offset += bucketSize;
+            }
+            for (const SortEntry& entry : order_)
+            {
+                scratch_[counts[(entry.key >> shift) & 0xFF]++] = entry;
+            }
+            order_.swap(scratch_);
+        }
+    }
+
+    GLint RenderQueue::GetModelLocation(GLuint program) const
+    {
+        // A handful of programs, and only consulted when the program changes.
+        for (const ModelLocation& entry : modelLocations_)
+        {
+            if (entry.program == program)
+            {
+                return entry.location;
+            }
+        }
+        const GLint location = glGetUniformLocation(program, "model");
+        modelLocations_.push_back(ModelLocation { program, location });
+        return location;
+    }
+
+    void RenderQueue::Execute(GlStateCache& state, bool bindTextures) const
+    {
+        PLANE_PROFILE_SCOPE("RenderQueue::Execute");
+        GLuint program = 0;
+        GLint modelLocation = -1;
+        int pass = -1;
+        for (const SortEntry& entry : order_)
+        {
+            const DrawItem& item = items_[entry.index];
+
+            const int itemPass = static_cast<int>(entry.key >> kPassShift);
+            if (itemPass != pass)
+            {
+                pass = itemPass;
+                ApplyPassState(static_cast<RenderPass>(pass), state);
+            }
+            if (item.program != program)
+            {
+                program = item.program;
+                state.UseProgram(program);
+                modelLocation = GetModelLocation(program);
+            }
+            if (bindTextures)
+            {
+                for (std::uint32_t t = 0; t < item.textureCount; ++t)
+                {
+                    state.BindTexture2D(item.textures[t].unit, item.textures[t].id);
+                }
+            }
+
+            glUniformMatrix4fv(modelLocation, 1, GL_FALSE, &item.model[0][0]);
+            state.BindVertexArray(item.vao);
+            const void* indexOffset = reinterpret_cast<const void*>(static_cast<std::uintptr_t>(item.firstIndex) * sizeof(GLuint));
+            if (item.instanceCount > 0)
+                glDrawElementsInstanced(item.mode, item.count, GL_UNSIGNED_INT, indexOffset, item.instanceCount);
+            else if (item.indexed)
+                glDrawElements(item.mode, item.count, GL_UNSIGNED_INT, indexOffset);
+            else
+                glDrawArrays(item.mode, item.firstIndex, item.count);
+        }
+    }
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/mesh.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "GlStateCache.h"
+
+namespace plane::render
+{
+    // Passes run in this order; each sets its own blend/depth-write state.
+    enum class RenderPass : std::uint8_t
+    {
+        Background,     // Large ground geometry, first so depth testing against it is stable.
+        Opaque,
+        Transparent     // Alpha blended, depth writes off, back to front.
+    };
+
+    // One draw of one mesh. The program must have Mesh::BindSamplerUnits applied and
+    // take its transform as "model"; everything per view comes from the uniform blocks.
+    struct DrawItem
+    {
+        GLuint program { 0 };
+        GLuint vao { 0 };
+        GLenum mode { GL_TRIANGLES };
+        GLsizei count { 0 };
+        // First index (or vertex, for glDrawArrays) of the range drawn.
+        GLsizei firstIndex { 0 };
+        // GL_UNSIGNED_INT indices from the VAO's element buffer, else glDrawArrays.
+        bool indexed { true };
+        // > 0 draws that many instances of an indexed item; the VAO carries the per-instance data.
+        GLsizei instanceCount { 0 };
+        // Must outlive the queue's Execute (mesh materials, renderer members).
+        const TextureBinding* textures { nullptr };
+        std::uint32_t textureCount { 0 };
+        glm::mat4 model { 1.0f };
+    };
+
+    // Collects a view's draws, orders them by a 64-bit key and issues them through a
+    // GlStateCache, so GL calls scale with distinct state rather than object count.
+    // Key, high to low: pass (4 bits) | program (12) | material (24) | depth (24).
+    // Material is the first texture bound; depth is front to back, or back to front
+    // in the transparent pass.
+    class RenderQueue
+    {
+    public:
+        static std::uint64_t MakeSortKey(RenderPass pass, GLuint program, GLuint material, float depth);
+
+        void Clear();
+        // depth: distance from the view, used only for ordering.
+        void Submit(RenderPass pass, const DrawItem& item, float depth);
+        void Sort();
+        // bindTextures = false for depth-only passes.
+        void Execute(GlStateCache& state, bool bindTextures) const;
+
+        std::size_t Size() const { return items_.size(); }
+
+    private:
+        struct SortEntry
+        {
+            std::uint64_t key;
+            std::uint32_t index;
+        };
+
+        struct ModelLocation
+        {
+            GLuint program;
+            GLint location;
+        };
+
+        // "model" of each program seen so far, looked up once; programs are never deleted.
+        GLint GetModelLocation(GLuint program) const;
+
+        std::vector<DrawItem> items_;
+        std::vector<SortEntry> order_;
+        std::vector<SortEntry> scratch_;
+        mutable std::vector<ModelLocation> modelLocations_;
+    };
+}
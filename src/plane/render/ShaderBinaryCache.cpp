@@ -0,0 +1,218 @@
+#include "ShaderBinaryCache.h"
+#include "core/Profiler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <vector>
+
+namespace plane::render
+{
+    namespace
+    {
+        constexpr char kMagic[4] = { 'P', 'S', 'H', 'B' };
+        constexpr std::uint32_t kFormatVersion = 1;
+
+        struct EntryHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint64_t key;
+            std::uint32_t binaryFormat;
+            std::uint32_t binaryLength;
+        };
+
+        constexpr std::uint64_t kFnvOffset = 14695981039346656037ull;
+
+        std::uint64_t Fnv1a(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        std::uint64_t HashString(std::uint64_t hash, const std::string& text)
+        {
+            // Length first so "ab"+"c" and "a"+"bc" differ.
+            const std::uint64_t length = text.size();
+            hash = Fnv1a(hash, &length, sizeof(length));
+            return Fnv1a(hash, text.data(), text.size());
+        }
+
+        std::string GlString(GLenum name)
+        {
+            const auto* value = reinterpret_cast<const char*>(glGetString(name));
+            return value ? value : "";
+        }
+    }
+
+    void ShaderBinaryCache::Initialize(const std::string& directory, GLADloadproc loadProc)
+    {
+        directory_ = directory;
+        enabled_ = false;
+
+        // Core since 4.1; older drivers may still expose GL_ARB_get_program_binary,
+        // which GLAD's core-only loader skips.
+        if (!glad_glGetProgramBinary && loadProc)
+        {
+            glad_glGetProgramBinary = reinterpret_cast<PFNGLGETPROGRAMBINARYPROC>(loadProc("glGetProgramBinary"));
+            glad_glProgramBinary = reinterpret_cast<PFNGLPROGRAMBINARYPROC>(loadProc("glProgramBinary"));
+            glad_glProgramParameteri = reinterpret_cast<PFNGLPROGRAMPARAMETERIPROC>(loadProc("glProgramParameteri"));
+        }
+        if (!glad_glGetProgramBinary || !glad_glProgramBinary || !glad_glProgramParameteri)
+        {
+            return;
+        }
+
+        GLint formatCount = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formatCount);
+        if (glGetError() != GL_NO_ERROR || formatCount <= 0)
+        {
+            return;
+        }
+
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+        if (error)
+        {
+            std::cout << "Shader cache disabled, cannot create " << directory_ << ": " << error.message() << std::endl;
+            return;
+        }
+
+        driverHash_ = HashString(kFnvOffset, GlString(GL_VENDOR));
+        driverHash_ = HashString(driverHash_, GlString(GL_RENDERER));
+        driverHash_ = HashString(driverHash_, GlString(GL_VERSION));
+        enabled_ = true;
+    }
+
+    std::uint64_t ShaderBinaryCache::Key(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) const
+    {
+        return HashString(HashString(HashString(driverHash_, vertexCode), fragmentCode), geometryCode);
+    }
+
+    std::string ShaderBinaryCache::EntryPath(std::uint64_t key) const
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.bin", static_cast<unsigned long long>(key));
+        return (std::filesystem::path(directory_) / name).string();
+    }
+
+    unsigned int ShaderBinaryCache::Load(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+    {
+        if (!enabled_)
+        {
+            return 0;
+        }
+        PLANE_PROFILE_SCOPE("ShaderBinaryCache::Load");
+
+        const std::uint64_t key = Key(vertexCode, fragmentCode, geometryCode);
+        const std::string path = EntryPath(key);
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return 0;
+        }
+
+        EntryHeader header {};
+        std::vector<char> binary;
+        file.read(reinterpret_cast<char*>(&header), sizeof(header));
+        const bool headerValid = file
+            && std::memcmp(header.magic, kMagic, sizeof(kMagic)) == 0
+            && header.version == kFormatVersion
+            && header.key == key
+            && header.binaryLength > 0;
+        if (headerValid)
+        {
+            binary.resize(header.binaryLength);
+            file.read(binary.data(), static_cast<std::streamsize>(binary.size()));
+        }
+        file.close();
+
+        unsigned int program = 0;
+        GLint linked = GL_FALSE;
+        if (headerValid && file.gcount() == static_cast<std::streamsize>(binary.size()))
+        {
+            program = glCreateProgram();
+            glProgramBinary(program, header.binaryFormat, binary.data(), static_cast<GLsizei>(binary.size()));
+            glGetProgramiv(program, GL_LINK_STATUS, &linked);
+        }
+
+        if (linked != GL_TRUE)
+        {
+            // Truncated, foreign or rejected by the driver: rebuild from source.
+            if (program != 0)
+            {
+                glDeleteProgram(program);
+            }
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            return 0;
+        }
+        return program;
+    }
+
+    void ShaderBinaryCache::PrepareLink(unsigned int program)
+    {
+        if (enabled_)
+        {
+            glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+    }
+
+    void ShaderBinaryCache::Store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode)
+    {
+        if (!enabled_)
+        {
+            return;
+        }
+        PLANE_PROFILE_SCOPE("ShaderBinaryCache::Store");
+
+        GLint length = 0;
+        glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+        if (length <= 0)
+        {
+            return;
+        }
+
+        std::vector<char> binary(static_cast<std::size_t>(length));
+        GLenum binaryFormat = 0;
+        GLsizei written = 0;
+        glGetProgramBinary(program, length, &written, &binaryFormat, binary.data());
+        if (written <= 0)
+        {
+            return;
+        }
+
+        EntryHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.key = Key(vertexCode, fragmentCode, geometryCode);
+        header.binaryFormat = binaryFormat;
+        header.binaryLength = static_cast<std::uint32_t>(written);
+
+        // Write beside the entry and rename, so a crash mid-write never leaves a torn file.
+        const std::string path = EntryPath(header.key);
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(binary.data(), written);
+            if (!file)
+            {
+                return;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+        }
+    }
+}
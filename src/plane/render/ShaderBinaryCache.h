@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/shader_cache.h>
+
+#include <cstdint>
+#include <string>
+
+namespace plane::render
+{
+    // Keeps the driver's linked program binaries on disk so later runs skip GLSL
+    // compilation. Entries are keyed by the shader sources plus the GL vendor,
+    // renderer and version strings; a driver update or edited shader simply misses,
+    // and a binary the driver refuses is deleted and rebuilt from source.
+    // Main (GL) thread only.
+    class ShaderBinaryCache : public ShaderProgramCache
+    {
+    public:
+        // Call once GLAD is loaded. Leaves the cache disabled (every program compiles
+        // from source) when the driver offers no program binary formats.
+        void Initialize(const std::string& directory, GLADloadproc loadProc);
+        bool IsEnabled() const { return enabled_; }
+
+        unsigned int Load(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) override;
+        void PrepareLink(unsigned int program) override;
+        void Store(unsigned int program, const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) override;
+
+    private:
+        std::uint64_t Key(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) const;
+        std::string EntryPath(std::uint64_t key) const;
+
+        std::string directory_;
+        // Hash of GL_VENDOR, GL_RENDERER and GL_VERSION; seeds every key.
+        std::uint64_t driverHash_ { 0 };
+        bool enabled_ { false };
+    };
+}
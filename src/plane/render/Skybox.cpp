@@ -1,6 +1,5 @@
 #include "Skybox.h"
-
-#include <stb_image.h>
+#include "core/Profiler.h"
 
 #include <glm/gtc/matrix_transform.hpp>
 
@@ -57,7 +56,19 @@ namespace plane::render
         };
     }
 
-    bool Skybox::Initialize(const std::string& texturePath)
+    std::vector<DecodedImage> Skybox::DecodeFaces(const std::string& texturePath)
+    {
+        // Standard face order expected by OpenGL.
+        const char* faceNames[] = { "right", "left", "top", "bottom", "front", "back" };
+        std::vector<DecodedImage> faces;
+        for (const char* face : faceNames)
+        {
+            faces.push_back(DecodeImage(texturePath + "/" + face + ".jpg"));
+        }
+        return faces;
+    }
+
+    bool Skybox::Initialize(const std::vector<DecodedImage>& faces)
     {
         // Prepare geometry
         glGenVertexArrays(1, &vao_);
@@ -69,38 +80,30 @@ namespace plane::render
         glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), (void*)0);
         glBindVertexArray(0);
 
-        // Load cubemap faces in the standard order expected by OpenGL.
-        std::vector<std::string> faces = {
-            texturePath + "/right.jpg",
-            texturePath + "/left.jpg",
-            texturePath + "/top.jpg",
-            texturePath + "/bottom.jpg",
-            texturePath + "/front.jpg",
-            texturePath + "/back.jpg"
-        };
-
         glGenTextures(1, &texture_);
         glBindTexture(GL_TEXTURE_CUBE_MAP, texture_);
 
-        int width, height, nrChannels;
         for (unsigned int i = 0; i < faces.size(); ++i)
         {
-            unsigned char* data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-            if (data)
+            const DecodedImage& face = faces[i];
+            if (face.IsValid())
             {
                 GLenum format = GL_RGB;
-                if (nrChannels == 1)
+                if (face.components == 1)
                     format = GL_RED;
-                else if (nrChannels == 4)
+                else if (face.components == 4)
                     format = GL_RGBA;
 
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-                stbi_image_free(data);
+                // The sky is sampled without mips, so a baked face only needs its top level.
+                const auto& top = face.levels.front();
+                if (face.compressedFormat != 0)
+                    glCompressedTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, face.compressedFormat, top.width, top.height, 0, static_cast<GLsizei>(top.size), top.data);
+                else
+                    glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, format, top.width, top.height, 0, format, GL_UNSIGNED_BYTE, top.data);
             }
             else
             {
-                std::cout << "Failed to load skybox face: " << faces[i] << std::endl;
-                stbi_image_free(data);
+                std::cout << "Failed to load skybox face: " << face.path << std::endl;
                 glBindTexture(GL_TEXTURE_CUBE_MAP, 0);
                 return false;
             }
@@ -116,14 +119,11 @@ namespace plane::render
         return true;
     }
 
-    void Skybox::Draw(const glm::mat4& projection, const glm::mat4& view, Shader& shader, bool bindTexture) const
+    void Skybox::Draw(Shader& shader, bool bindTexture) const
     {
-        // Remove translation from the view matrix so the skybox stays centered on the camera.
-        glm::mat4 viewNoTranslation = glm::mat4(glm::mat3(view));
-
+        PLANE_PROFILE_SCOPE("Skybox::Draw");
+        // skybox.vs strips the view translation itself.
         shader.use();
-        shader.setMat4("projection", projection);
-        shader.setMat4("view", viewNoTranslation);
 
         glDepthFunc(GL_LEQUAL);
         glDepthMask(GL_FALSE);
@@ -132,7 +132,6 @@ namespace plane::render
         {
             glActiveTexture(GL_TEXTURE0);
             glBindTexture(GL_TEXTURE_CUBE_MAP, texture_);
-            shader.setInt("skybox", 0);
         }
 
         glBindVertexArray(vao_);
@@ -6,14 +6,20 @@
 #include <learnopengl/shader_m.h>
 
 #include <string>
+#include <vector>
+
+#include "TextureLoader.h"
 
 namespace plane::render
 {
     class Skybox
     {
     public:
-        bool Initialize(const std::string& texturePath);
-        void Draw(const glm::mat4& projection, const glm::mat4& view, Shader& shader, bool bindTexture = true) const;
+        // Decodes the six cube faces (right, left, top, bottom, front, back); any thread.
+        static std::vector<DecodedImage> DecodeFaces(const std::string& texturePath);
+        bool Initialize(const std::vector<DecodedImage>& faces);
+        // Camera comes from the shared ViewBlock.
+        void Draw(Shader& shader, bool bindTexture = true) const;
         void Shutdown();
 
     private:
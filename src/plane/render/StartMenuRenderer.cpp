@@ -1,5 +1,7 @@
 #include "StartMenuRenderer.h"
+#include "core/Profiler.h"
 
+#include <learnopengl/shader_m.h>
 #include <stb_image.h>
 #include <iostream>
 
@@ -68,50 +70,8 @@ namespace plane::render
             }
         )";
 
-        // Compile vertex shader
-        unsigned int vertexShader = glCreateShader(GL_VERTEX_SHADER);
-        glShaderSource(vertexShader, 1, &vertexShaderSource, NULL);
-        glCompileShader(vertexShader);
-
-        // Check for vertex shader compile errors
-        int success;
-        char infoLog[512];
-        glGetShaderiv(vertexShader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(vertexShader, 512, NULL, infoLog);
-            std::cerr << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-        }
-
-        // Compile fragment shader
-        unsigned int fragmentShader = glCreateShader(GL_FRAGMENT_SHADER);
-        glShaderSource(fragmentShader, 1, &fragmentShaderSource, NULL);
-        glCompileShader(fragmentShader);
-
-        // Check for fragment shader compile errors
-        glGetShaderiv(fragmentShader, GL_COMPILE_STATUS, &success);
-        if (!success)
-        {
-            glGetShaderInfoLog(fragmentShader, 512, NULL, infoLog);
-            std::cerr << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-        }
-
-        // Link shaders
-        shaderProgram_ = glCreateProgram();
-        glAttachShader(shaderProgram_, vertexShader);
-        glAttachShader(shaderProgram_, fragmentShader);
-        glLinkProgram(shaderProgram_);
-
-        // Check for linking errors
-        glGetProgramiv(shaderProgram_, GL_LINK_STATUS, &success);
-        if (!success)
-        {
-            glGetProgramInfoLog(shaderProgram_, 512, NULL, infoLog);
-            std::cerr << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
-        }
-
-        glDeleteShader(vertexShader);
-        glDeleteShader(fragmentShader);
+        // Built through Shader so the program binary cache covers it too.
+        shaderProgram_ = Shader::FromSource(vertexShaderSource, fragmentShaderSource).ID;
     }
 
     void StartMenuRenderer::LoadTexture(const std::string& imagePath)
@@ -174,6 +134,7 @@ namespace plane::render
 
     void StartMenuRenderer::Render(int screenWidth, int screenHeight) const
     {
+        PLANE_PROFILE_SCOPE("StartMenuRenderer::Render");
         if (vao_ == 0 || shaderProgram_ == 0 || texture_ == 0)
         {
             return;
@@ -2,288 +2,730 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 
-#include "TextureLoader.h"
-
+#include <algorithm>
+#include <array>
 #include <cmath>
-#include <random>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <type_traits>
+
+#include "FrameUniforms.h"
+#include "TextureLoader.h"
+#include "world/HeightField.h"
+#include "core/MappedFile.h"
+#include "core/Profiler.h"
 
 namespace plane::render
 {
     namespace
     {
-        // Simple pseudo-random hash function for noise generation
-        float Hash(float x, float z)
+        // Reserved texture units, after the Mesh material units (0-8).
+        constexpr GLint kHeightUnit = 9;
+        constexpr GLint kNormalUnit = 10;
+
+        constexpr int kPatchSide = TerrainPlane::ChunkCells + 1;
+        static_assert(TerrainPlane::ChunkCells == world::HeightField::DeformBlockCells,
+            "craters must stay within the chunks TerrainPlane draws");
+        constexpr std::size_t kPatchVertexBytes = 4;
+        constexpr unsigned int kNoSkirt = 0xFFFFFFFFu;
+
+        // Grid coordinates sampled along one chunk side at the given step. The far edge
+        // is always included, so chunks that do not divide evenly still close up.
+        std::vector<int> SampleLine(int begin, int end, int step)
         {
-            float n = std::sin(x * 12.9898f + z * 78.233f) * 43758.5453f;
-            return n - std::floor(n);
+            std::vector<int> line;
+            for (int i = begin; i < end; i += step)
+            {
+                line.push_back(i);
+            }
+            line.push_back(end);
+            return line;
         }
 
-        // Smooth interpolation
-        float Lerp(float a, float b, float t)
+        // Height of the triangulated LOD grid (xs by zs samples, every 2^level-th vertex
+        // from the chunk corner) at vertex (x, z) of a row-major height block, split along
+        // the same diagonal as the index buffer.
+        float InterpolateLod(const float* heights, int stride, const std::vector<int>& xs, const std::vector<int>& zs,
+            int level, int x, int z)
         {
-            return a + t * (b - a);
+            const std::size_t cellX = (std::min)(static_cast<std::size_t>((x - xs.front()) >> level), xs.size() - 2);
+            const std::size_t cellZ = (std::min)(static_cast<std::size_t>((z - zs.front()) >> level), zs.size() - 2);
+            const int x0 = xs[cellX], x1 = xs[cellX + 1];
+            const int z0 = zs[cellZ], z1 = zs[cellZ + 1];
+            const float u = static_cast<float>(x - x0) / static_cast<float>(x1 - x0);
+            const float v = static_cast<float>(z - z0) / static_cast<float>(z1 - z0);
+
+            const float topLeft = heights[z0 * stride + x0];
+            const float topRight = heights[z0 * stride + x1];
+            const float bottomLeft = heights[z1 * stride + x0];
+            const float bottomRight = heights[z1 * stride + x1];
+            if (u + v <= 1.0f)
+            {
+                return topLeft + u * (topRight - topLeft) + v * (bottomLeft - topLeft);
+            }
+            return bottomRight + (1.0f - u) * (bottomLeft - bottomRight) + (1.0f - v) * (topRight - bottomRight);
         }
 
-        float SmoothStep(float t)
+        // Fills the shared patch: a kPatchSide^2 grid plus one skirt vertex per outline
+        // vertex, and an index range per LOD.
+        void BuildPatch(TerrainPlane::MeshData& mesh)
         {
-            return t * t * (3.0f - 2.0f * t);
-        }
-    }
+            std::vector<std::uint8_t>& vertices = mesh.patchVertices;
+            std::vector<unsigned int>& indices = mesh.patchIndices;
+            auto addVertex = [&vertices](int x, int z, bool skirt)
+            {
+                vertices.push_back(static_cast<std::uint8_t>(x));
+                vertices.push_back(static_cast<std::uint8_t>(z));
+                vertices.push_back(skirt ? 1 : 0);
+                vertices.push_back(0);
+                return static_cast<unsigned int>(vertices.size() / kPatchVertexBytes - 1);
+            };
+
+            for (int z = 0; z < kPatchSide; ++z)
+            {
+                for (int x = 0; x < kPatchSide; ++x)
+                {
+                    addVertex(x, z, false);
+                }
+            }
+            std::vector<unsigned int> skirtOf(kPatchSide * kPatchSide, kNoSkirt);
+            auto skirtVertex = [&](unsigned int source)
+            {
+                if (skirtOf[source] == kNoSkirt)
+                {
+                    skirtOf[source] = addVertex(static_cast<int>(source) % kPatchSide, static_cast<int>(source) / kPatchSide, true);
+                }
+                return skirtOf[source];
+            };
 
-    bool TerrainPlane::Initialize(const std::string& texturePath, float size, int gridResolution)
-    {
-        size_ = size;
-        gridResolution_ = gridResolution;
+            for (int level = 0; level < TerrainPlane::LodCount; ++level)
+            {
+                const std::vector<int> line = SampleLine(0, TerrainPlane::ChunkCells, 1 << level);
+                TerrainPlane::PatchLod& lod = mesh.patchLods[level];
+                lod.firstIndex = static_cast<unsigned int>(indices.size());
 
-        texture_ = LoadTexture(texturePath);
+                for (std::size_t row = 0; row + 1 < line.size(); ++row)
+                {
+                    for (std::size_t column = 0; column + 1 < line.size(); ++column)
+                    {
+                        unsigned int topLeft = line[row] * kPatchSide + line[column];
+                        unsigned int topRight = line[row] * kPatchSide + line[column + 1];
+                        unsigned int bottomLeft = line[row + 1] * kPatchSide + line[column];
+                        unsigned int bottomRight = line[row + 1] * kPatchSide + line[column + 1];
+
+                        // Two triangles per quad
+                        indices.push_back(topLeft);
+                        indices.push_back(bottomLeft);
+                        indices.push_back(topRight);
+
+                        indices.push_back(topRight);
+                        indices.push_back(bottomLeft);
+                        indices.push_back(bottomRight);
+                    }
+                }
 
-        // Generate heightmap first
-        GenerateHeightmap();
+                // A skirt hangs below the outline, walked north, east, south, west so every
+                // strip faces outward. It covers cracks against coarser neighbours.
+                const int last = TerrainPlane::ChunkCells;
+                std::vector<unsigned int> outline;
+                for (std::size_t i = 0; i + 1 < line.size(); ++i) outline.push_back(line[i]);
+                for (std::size_t i = 0; i + 1 < line.size(); ++i) outline.push_back(line[i] * kPatchSide + last);
+                for (std::size_t i = line.size() - 1; i > 0; --i) outline.push_back(last * kPatchSide + line[i]);
+                for (std::size_t i = line.size() - 1; i > 0; --i) outline.push_back(line[i] * kPatchSide);
+                for (std::size_t i = 0; i < outline.size(); ++i)
+                {
+                    const unsigned int a = outline[i];
+                    const unsigned int b = outline[(i + 1) % outline.size()];
+                    const unsigned int skirtA = skirtVertex(a);
+                    const unsigned int skirtB = skirtVertex(b);
+                    indices.push_back(a);
+                    indices.push_back(b);
+                    indices.push_back(skirtA);
+
+                    indices.push_back(b);
+                    indices.push_back(skirtB);
+                    indices.push_back(skirtA);
+                }
 
-        // Build vertex data: position (x,y,z), normal (nx,ny,nz), texcoord (u,v)
-        std::vector<float> vertices;
-        std::vector<unsigned int> indices;
+                lod.indexCount = static_cast<unsigned int>(indices.size()) - lod.firstIndex;
+            }
+        }
 
-        float halfSize = size_ * 0.5f;
-        float cellSize = size_ / gridResolution_;
+        // One-layer array, as terrain.vs samples tile arrays; see TerrainPlane::CreateGridArray.
+        unsigned int UploadGridTexture(GLint internalFormat, GLenum format, GLenum type, int side, const void* texels)
+        {
+            const unsigned int texture = TerrainPlane::CreateGridArray(internalFormat, format, type, side, 1);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, 0, side, side, 1, format, type, texels);
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+            glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+            return texture;
+        }
 
-        // Generate vertices
-        for (int z = 0; z <= gridResolution_; ++z)
+        Aabb Union(const Aabb& a, const Aabb& b)
         {
-            for (int x = 0; x <= gridResolution_; ++x)
-            {
-                float worldX = -halfSize + x * cellSize;
-                float worldZ = -halfSize + z * cellSize;
-                float height = SampleHeight(x, z);
-
-                // Position
-                vertices.push_back(worldX);
-                vertices.push_back(height);
-                vertices.push_back(worldZ);
-
-                // Normal (approximate using neighbors)
-                float heightL = (x > 0) ? SampleHeight(x - 1, z) : height;
-                float heightR = (x < gridResolution_) ? SampleHeight(x + 1, z) : height;
-                float heightD = (z > 0) ? SampleHeight(x, z - 1) : height;
-                float heightU = (z < gridResolution_) ? SampleHeight(x, z + 1) : height;
-
-                glm::vec3 normal = glm::normalize(glm::vec3(heightL - heightR, 2.0f * cellSize, heightD - heightU));
-                vertices.push_back(normal.x);
-                vertices.push_back(normal.y);
-                vertices.push_back(normal.z);
-
-                // Texture coordinates
-                float u = static_cast<float>(x) / gridResolution_;
-                float v = static_cast<float>(z) / gridResolution_;
-                vertices.push_back(u);
-                vertices.push_back(v);
-            }
+            return Aabb { glm::min(a.min, b.min), glm::max(a.max, b.max) };
         }
 
-        // Generate indices for triangle strips
-        for (int z = 0; z < gridResolution_; ++z)
+        // Fills nodes[nodeIndex] with the chunk rectangle [x0, x1) x [z0, z1), splitting it
+        // in half along each axis until a node holds a single chunk. Siblings are contiguous.
+        void BuildQuadtree(std::vector<TerrainPlane::QuadNode>& nodes, std::uint32_t nodeIndex, const std::vector<TerrainPlane::Chunk>& chunks,
+            int chunksPerRow, int x0, int z0, int x1, int z1)
         {
-            for (int x = 0; x < gridResolution_; ++x)
+            if (x1 - x0 == 1 && z1 - z0 == 1)
             {
-                int topLeft = z * (gridResolution_ + 1) + x;
-                int topRight = topLeft + 1;
-                int bottomLeft = (z + 1) * (gridResolution_ + 1) + x;
-                int bottomRight = bottomLeft + 1;
-
-                // Two triangles per quad
-                indices.push_back(topLeft);
-                indices.push_back(bottomLeft);
-                indices.push_back(topRight);
-
-                indices.push_back(topRight);
-                indices.push_back(bottomLeft);
-                indices.push_back(bottomRight);
+                const int chunk = z0 * chunksPerRow + x0;
+                nodes[nodeIndex].chunk = chunk;
+                nodes[nodeIndex].bounds = chunks[chunk].bounds;
+                return;
             }
-        }
 
-        // Create OpenGL buffers
-        glGenVertexArrays(1, &vao_);
-        glGenBuffers(1, &vbo_);
-        glGenBuffers(1, &ebo_);
+            const int midX = (x1 - x0 > 1) ? (x0 + x1) / 2 : x1;
+            const int midZ = (z1 - z0 > 1) ? (z0 + z1) / 2 : z1;
+            const int rects[4][4] = {
+                { x0, z0, midX, midZ }, { midX, z0, x1, midZ },
+                { x0, midZ, midX, z1 }, { midX, midZ, x1, z1 }
+            };
 
-        glBindVertexArray(vao_);
+            const auto firstChild = static_cast<std::uint32_t>(nodes.size());
+            std::uint32_t childCount = 0;
+            for (const auto& rect : rects)
+            {
+                if (rect[0] < rect[2] && rect[1] < rect[3])
+                {
+                    nodes.emplace_back();
+                    ++childCount;
+                }
+            }
+            nodes[nodeIndex].firstChild = firstChild;
+            nodes[nodeIndex].childCount = childCount;
 
-        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
-        glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(float), vertices.data(), GL_STATIC_DRAW);
+            std::uint32_t child = firstChild;
+            for (const auto& rect : rects)
+            {
+                if (rect[0] < rect[2] && rect[1] < rect[3])
+                {
+                    BuildQuadtree(nodes, child, chunks, chunksPerRow, rect[0], rect[1], rect[2], rect[3]);
+                    nodes[nodeIndex].bounds = (child == firstChild) ? nodes[child].bounds : Union(nodes[nodeIndex].bounds, nodes[child].bounds);
+                    ++child;
+                }
+            }
+        }
 
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), indices.data(), GL_STATIC_DRAW);
+        constexpr char kCacheMagic[4] = { 'P', 'T', 'M', 'C' };
+        // Bump when BuildMesh changes what it derives; old entries then miss.
+        // 2: only whole chunks; terrain tiles draw the ragged edge.
+        // 3: heights quantized over the height field's grid range, crater headroom included.
+        constexpr std::uint32_t kCacheFormatVersion = 3;
 
-        // Position attribute
-        glEnableVertexAttribArray(0);
-        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
+        static_assert(std::is_trivially_copyable_v<TerrainPlane::Chunk>, "chunks are cached as raw bytes");
+        static_assert(std::is_trivially_copyable_v<TerrainPlane::QuadNode>, "nodes are cached as raw bytes");
 
-        // Normal attribute
-        glEnableVertexAttribArray(1);
-        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
+        // Followed by the heights, chunks and nodes as raw arrays.
+        struct CacheHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint64_t key;
+            std::int32_t gridResolution;
+            float heightMin;
+            float heightRange;
+            float skirtDepth;
+            std::uint32_t chunkCount;
+            std::uint32_t nodeCount;
+        };
+
+        std::uint64_t CacheKey(const world::HeightField& heightField)
+        {
+            std::uint64_t key = heightField.GetContentKey();
+            const auto* bytes = reinterpret_cast<const unsigned char*>(&kCacheFormatVersion);
+            for (std::size_t i = 0; i < sizeof(kCacheFormatVersion); ++i)
+            {
+                key = (key ^ bytes[i]) * 1099511628211ull;
+            }
+            return key;
+        }
+
+        // Fills everything but the normals and the patch, which are cheap to redo.
+        bool LoadCachedMesh(const std::string& path, std::uint64_t key, TerrainPlane::MeshData& mesh)
+        {
+            PLANE_PROFILE_SCOPE("TerrainPlane::LoadCachedMesh");
+            core::MappedFile file;
+            if (!file.Open(path) || file.Size() < sizeof(CacheHeader))
+            {
+                return false;
+            }
 
-        // Texture coordinate attribute
-        glEnableVertexAttribArray(2);
-        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
+            CacheHeader header {};
+            std::memcpy(&header, file.Data(), sizeof(header));
+            const std::size_t heightBytes = static_cast<std::size_t>(mesh.gridResolution + 1) * (mesh.gridResolution + 1) * sizeof(std::uint16_t);
+            const std::size_t chunkBytes = static_cast<std::size_t>(header.chunkCount) * sizeof(TerrainPlane::Chunk);
+            const std::size_t nodeBytes = static_cast<std::size_t>(header.nodeCount) * sizeof(TerrainPlane::QuadNode);
+            if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0
+                || header.version != kCacheFormatVersion
+                || header.key != key
+                || header.gridResolution != mesh.gridResolution
+                || file.Size() != sizeof(header) + heightBytes + chunkBytes + nodeBytes)
+            {
+                return false;
+            }
 
-        glBindVertexArray(0);
+            const std::uint8_t* data = file.Data() + sizeof(header);
+            mesh.heightMin = header.heightMin;
+            mesh.heightRange = header.heightRange;
+            mesh.skirtDepth = header.skirtDepth;
+            mesh.heights.resize(heightBytes / sizeof(std::uint16_t));
+            mesh.chunks.resize(header.chunkCount);
+            mesh.nodes.resize(header.nodeCount);
+            std::memcpy(mesh.heights.data(), data, heightBytes);
+            std::memcpy(mesh.chunks.data(), data + heightBytes, chunkBytes);
+            std::memcpy(mesh.nodes.data(), data + heightBytes + chunkBytes, nodeBytes);
+            return true;
+        }
 
-        return true;
+        void SaveCachedMesh(const std::string& directory, const std::string& path, std::uint64_t key, const TerrainPlane::MeshData& mesh)
+        {
+            std::error_code error;
+            std::filesystem::create_directories(directory, error);
+            if (error)
+            {
+                std::cout << "Terrain mesh not cached, cannot create " << directory << ": " << error.message() << std::endl;
+                return;
+            }
+
+            CacheHeader header {};
+            std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+            header.version = kCacheFormatVersion;
+            header.key = key;
+            header.gridResolution = mesh.gridResolution;
+            header.heightMin = mesh.heightMin;
+            header.heightRange = mesh.heightRange;
+            header.skirtDepth = mesh.skirtDepth;
+            header.chunkCount = static_cast<std::uint32_t>(mesh.chunks.size());
+            header.nodeCount = static_cast<std::uint32_t>(mesh.nodes.size());
+
+            const std::string tempPath = path + ".tmp";
+            {
+                std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+                file.write(reinterpret_cast<const char*>(mesh.heights.data()), static_cast<std::streamsize>(mesh.heights.size() * sizeof(std::uint16_t)));
+                file.write(reinterpret_cast<const char*>(mesh.chunks.data()), static_cast<std::streamsize>(mesh.chunks.size() * sizeof(TerrainPlane::Chunk)));
+                file.write(reinterpret_cast<const char*>(mesh.nodes.data()), static_cast<std::streamsize>(mesh.nodes.size() * sizeof(TerrainPlane::QuadNode)));
+                if (!file)
+                {
+                    return;
+                }
+            }
+            std::filesystem::rename(tempPath, path, error);
+            if (error)
+            {
+                std::filesystem::remove(tempPath, error);
+            }
+        }
     }
 
-    void TerrainPlane::Draw(Shader& shader, bool bindTexture) const
+    TerrainPlane::MeshData TerrainPlane::BuildMesh(const world::HeightField& heightField, const std::string& cacheDirectory)
     {
-        glm::mat4 terrainModel = glm::mat4(1.0f);
-        shader.setMat4("model", terrainModel);
-
-        if (bindTexture && texture_ != 0)
+        PLANE_PROFILE_SCOPE("TerrainPlane::BuildMesh");
+        MeshData mesh;
+        mesh.size = heightField.GetSize();
+        mesh.gridResolution = heightField.GetGridResolution();
+
+        const std::uint64_t cacheKey = CacheKey(heightField);
+        std::string cachePath;
+        if (!cacheDirectory.empty())
         {
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, texture_);
-            shader.setInt("texture_diffuse1", 0);
+            char name[32];
+            std::snprintf(name, sizeof(name), "%016llx.mesh", static_cast<unsigned long long>(cacheKey));
+            cachePath = (std::filesystem::path(cacheDirectory) / name).string();
+            if (LoadCachedMesh(cachePath, cacheKey, mesh))
+            {
+                mesh.normals = heightField.GetPackedNormals();
+                BuildPatch(mesh);
+                return mesh;
+            }
         }
 
-        glBindVertexArray(vao_);
-        int indexCount = gridResolution_ * gridResolution_ * 6;
-        glDrawElements(GL_TRIANGLES, indexCount, GL_UNSIGNED_INT, 0);
-        glBindVertexArray(0);
+        const int gridResolution = mesh.gridResolution;
+        const int stride = gridResolution + 1;
+        const float cellSize = mesh.size / gridResolution;
+        const float halfSize = mesh.size * 0.5f;
+
+        // The grid's own range, so craters dug below the original terrain still show.
+        mesh.heightMin = heightField.GetGridMinHeight();
+        mesh.heightRange = (std::max)(heightField.GetGridMaxHeight() - mesh.heightMin, 1e-3f);
 
-        if (bindTexture)
+        // Normals come packed from the height field, in texture layout already.
+        mesh.heights.reserve(static_cast<std::size_t>(stride) * stride);
+        for (int z = 0; z <= gridResolution; ++z)
         {
-            glBindTexture(GL_TEXTURE_2D, 0);
+            for (int x = 0; x <= gridResolution; ++x)
+            {
+                const float height = heightField.SampleHeight(x, z);
+                mesh.heights.push_back(static_cast<std::uint16_t>(std::lround((height - mesh.heightMin) / mesh.heightRange * 65535.0f)));
+            }
         }
-    }
-
-    void TerrainPlane::Shutdown()
-    {
-        if (vao_ != 0)
+        mesh.normals = heightField.GetPackedNormals();
+
+        BuildPatch(mesh);
+
+        // Bounds and per-LOD errors come from the exact heights. Only whole chunks are
+        // kept; the rest of the last row and column is left to the terrain tiles.
+        const int chunksPerRow = gridResolution / ChunkCells;
+        std::vector<float> gridHeights;
+        heightField.CopyHeights(gridHeights);
+        const float* heights = gridHeights.data();
+        mesh.skirtDepth = cellSize;
+        for (int chunkZ = 0; chunkZ < chunksPerRow; ++chunkZ)
         {
-            glDeleteVertexArrays(1, &vao_);
-            vao_ = 0;
+            for (int chunkX = 0; chunkX < chunksPerRow; ++chunkX)
+            {
+                const Chunk chunk = MeasureChunk(heights, stride, chunkX * ChunkCells, chunkZ * ChunkCells, glm::vec2(-halfSize), cellSize);
+                mesh.skirtDepth = (std::max)(mesh.skirtDepth, chunk.geometricError[LodCount - 1] + cellSize);
+                mesh.chunks.push_back(chunk);
+            }
         }
-        if (vbo_ != 0)
+
+        for (Chunk& chunk : mesh.chunks)
         {
-            glDeleteBuffers(1, &vbo_);
-            vbo_ = 0;
+            chunk.bounds.min.y -= mesh.skirtDepth;
         }
-        if (ebo_ != 0)
+
+        if (!mesh.chunks.empty())
         {
-            glDeleteBuffers(1, &ebo_);
-            ebo_ = 0;
+            mesh.nodes.emplace_back();
+            BuildQuadtree(mesh.nodes, 0, mesh.chunks, chunksPerRow, 0, 0, chunksPerRow, chunksPerRow);
         }
-        if (texture_ != 0)
+
+        if (!cachePath.empty())
         {
-            glDeleteTextures(1, &texture_);
-            texture_ = 0;
+            SaveCachedMesh(cacheDirectory, cachePath, cacheKey, mesh);
         }
+        return mesh;
     }
 
-    void TerrainPlane::GenerateHeightmap()
+    TerrainPlane::Chunk TerrainPlane::MeasureChunk(const float* heights, int stride, int firstX, int firstZ, const glm::vec2& origin, float cellSize)
     {
-        // Initialize heightmap array
-        int vertexCount = (gridResolution_ + 1) * (gridResolution_ + 1);
-        heightmap_.resize(vertexCount);
-
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_real_distribution<float> dist(0.0f, 1.0f);
+        const int endX = firstX + ChunkCells;
+        const int endZ = firstZ + ChunkCells;
 
-        // Generate base heights using layered noise
-        for (int z = 0; z <= gridResolution_; ++z)
+        Chunk chunk;
+        float chunkMin = heights[firstZ * stride + firstX];
+        float chunkMax = chunkMin;
+        for (int z = firstZ; z <= endZ; ++z)
         {
-            for (int x = 0; x <= gridResolution_; ++x)
+            for (int x = firstX; x <= endX; ++x)
             {
-                float worldX = (float)x / gridResolution_;
-                float worldZ = (float)z / gridResolution_;
-
-                // Multi-octave Perlin-like noise for natural terrain
-                float height = 0.0f;
-                float amplitude = 150.0f;  // INCREASED: Max height variation 
-                float frequency = 2.5f;   // Slightly lower frequency for larger features
+                const float height = heights[z * stride + x];
+                chunkMin = (std::min)(chunkMin, height);
+                chunkMax = (std::max)(chunkMax, height);
+            }
+        }
+        chunk.bounds.min = glm::vec3(origin.x + firstX * cellSize, chunkMin, origin.y + firstZ * cellSize);
+        chunk.bounds.max = glm::vec3(origin.x + endX * cellSize, chunkMax, origin.y + endZ * cellSize);
 
-                // Layer multiple noise octaves for more varied terrain
-                for (int octave = 0; octave < 5; ++octave)  // INCREASED: 5 octaves (was 4)
+        // Largest height the dropped vertices are off the coarser surface; never
+        // less than the finer level's, so errors grow with the level.
+        for (int level = 1; level < LodCount; ++level)
+        {
+            const std::vector<int> xs = SampleLine(firstX, endX, 1 << level);
+            const std::vector<int> zs = SampleLine(firstZ, endZ, 1 << level);
+            float error = chunk.geometricError[level - 1];
+            for (int z = firstZ; z <= endZ; ++z)
+            {
+                for (int x = firstX; x <= endX; ++x)
                 {
-                    height += PerlinNoise(worldX * frequency, worldZ * frequency) * amplitude;
-                    amplitude *= 0.5f;
-                    frequency *= 2.0f;
+                    error = (std::max)(error, std::abs(heights[z * stride + x] - InterpolateLod(heights, stride, xs, zs, level, x, z)));
                 }
-
-                // CHANGED: Base offset adjusted to allow underwater areas
-                // Some areas will be below water (0.0), some above
-                // Range approximately: -30 to +90 units
-                height += 10.0f;  // Reduced from 15.0f to allow more underwater terrain
-
-                int index = z * (gridResolution_ + 1) + x;
-                heightmap_[index] = height;
             }
+            chunk.geometricError[level] = error;
+        }
+        return chunk;
+    }
+
+    int TerrainPlane::SelectLod(const Chunk& chunk, const glm::vec3& viewPos, float lodScale)
+    {
+        // Coarsest LOD whose error projects to at most the allowed pixels at this distance.
+        const glm::vec3 outside = glm::max(glm::max(chunk.bounds.min - viewPos, viewPos - chunk.bounds.max), glm::vec3(0.0f));
+        const float distance = glm::length(outside);
+        int level = LodCount - 1;
+        while (level > 0 && chunk.geometricError[level] * lodScale > distance)
+        {
+            --level;
         }
+        return level;
+    }
+
+    unsigned int TerrainPlane::CreateGridArray(GLint internalFormat, GLenum format, GLenum type, int side, int layers)
+    {
+        unsigned int texture = 0;
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, internalFormat, side, side, layers, 0, format, type, nullptr);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+        return texture;
     }
 
-    float TerrainPlane::PerlinNoise(float x, float z) const
+    bool TerrainPlane::Initialize(const DecodedImage& texture, const MeshData& mesh)
     {
-        // Simple grid-based noise
-        int xi = static_cast<int>(std::floor(x));
-        int zi = static_cast<int>(std::floor(z));
+        size_ = mesh.size;
+        gridResolution_ = mesh.gridResolution;
+        patchLods_ = mesh.patchLods;
+        chunks_ = mesh.chunks;
+        nodes_ = mesh.nodes;
+        heights_ = mesh.heights;
+        heightMin_ = mesh.heightMin;
+        heightRange_ = mesh.heightRange;
+        skirtDepth_ = mesh.skirtDepth;
+
+        texture_ = UploadTexture(texture);
+        textureBinding_ = TextureBinding { 0, texture_ };
+        heightTexture_ = UploadGridTexture(GL_R16, GL_RED, GL_UNSIGNED_SHORT, gridResolution_ + 1, mesh.heights.data());
+        normalTexture_ = UploadGridTexture(GL_RG8_SNORM, GL_RG, GL_BYTE, gridResolution_ + 1, mesh.normals.data());
+
+        // Both programs share terrain.vs; shadowPass switches it to light space.
+        shader_ = std::make_unique<Shader>("terrain.vs", "plane.fs");
+        depthShader_ = std::make_unique<Shader>("terrain.vs", "shadow_depth.fs");
+        for (Shader* shader : { shader_.get(), depthShader_.get() })
+        {
+            FrameUniforms::BindBlocks(shader->ID);
+            shader->use();
+            shader->setBool("shadowPass", shader == depthShader_.get());
+            shader->setInt("terrainHeights", kHeightUnit);
+            shader->setInt("terrainNormals", kNormalUnit);
+            shader->setVec2("terrainOrigin", glm::vec2(-0.5f * size_));
+            shader->setFloat("terrainCellSize", size_ / gridResolution_);
+            shader->setInt("terrainResolution", gridResolution_);
+            // The whole grid is one tile on layer 0.
+            shader->setInt("terrainTileCells", gridResolution_ + 1);
+            shader->setInt("terrainTextureCells", gridResolution_);
+            shader->setVec2("terrainHeightRange", mesh.heightMin, mesh.heightRange);
+            shader->setFloat("terrainSkirtDepth", mesh.skirtDepth);
+        }
+        Mesh::BindSamplerUnits(*shader_);
+        shader_->setInt("shadowMap", 1);
+
+        // Create OpenGL buffers
+        glGenVertexArrays(1, &vao_);
+        glGenBuffers(1, &vbo_);
+        glGenBuffers(1, &ebo_);
 
-        float xf = x - xi;
-        float zf = z - zi;
+        glBindVertexArray(vao_);
+
+        glBindBuffer(GL_ARRAY_BUFFER, vbo_);
+        glBufferData(GL_ARRAY_BUFFER, mesh.patchVertices.size(), mesh.patchVertices.data(), GL_STATIC_DRAW);
 
-        // Get corner values using hash
-        float n00 = Hash(static_cast<float>(xi), static_cast<float>(zi));
-        float n10 = Hash(static_cast<float>(xi + 1), static_cast<float>(zi));
-        float n01 = Hash(static_cast<float>(xi), static_cast<float>(zi + 1));
-        float n11 = Hash(static_cast<float>(xi + 1), static_cast<float>(zi + 1));
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo_);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh.patchIndices.size() * sizeof(unsigned int), mesh.patchIndices.data(), GL_STATIC_DRAW);
+
+        // Patch attribute: x, z within the chunk and the skirt flag
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 3, GL_UNSIGNED_BYTE, GL_FALSE, static_cast<GLsizei>(kPatchVertexBytes), (void*)0);
 
-        // Smooth interpolation
-        float sx = SmoothStep(xf);
-        float sz = SmoothStep(zf);
+        glBindVertexArray(0);
 
-        float nx0 = Lerp(n00, n10, sx);
-        float nx1 = Lerp(n01, n11, sx);
+        return true;
+    }
 
-        return Lerp(nx0, nx1, sz) * 2.0f - 1.0f;  // Map to [-1, 1]
+    float TerrainPlane::LodScale(float viewportHeight, float fovY, float maxPixelError)
+    {
+        return viewportHeight / (2.0f * std::tan(0.5f * fovY) * maxPixelError);
     }
 
-    float TerrainPlane::SampleHeight(int gridX, int gridZ) const
+    void TerrainPlane::Submit(RenderQueue& queue, bool shadowPass, const Frustum& frustum, const glm::vec3& viewPos, float lodScale) const
     {
-        if (gridX < 0 || gridX > gridResolution_ || gridZ < 0 || gridZ > gridResolution_)
-            return 0.0f;
+        PLANE_PROFILE_SCOPE("TerrainPlane::Submit");
+        if (vao_ == 0 || nodes_.empty())
+        {
+            return;
+        }
 
-        int index = gridZ * (gridResolution_ + 1) + gridX;
-        return heightmap_[index];
+        const float cellSize = size_ / gridResolution_;
+        DrawItem item;
+        item.program = shadowPass ? depthShader_->ID : shader_->ID;
+        item.vao = vao_;
+        item.textures = &textureBinding_;
+        item.textureCount = (texture_ != 0) ? 1 : 0;
+
+        // Depth-first walk; a node outside the frustum drops its whole subtree.
+        std::array<std::uint32_t, 64> stack;
+        std::size_t top = 0;
+        stack[top++] = 0;
+        while (top > 0)
+        {
+            const QuadNode& node = nodes_[stack[--top]];
+            if (!frustum.IntersectsBox(node.bounds))
+            {
+                continue;
+            }
+            if (node.chunk < 0)
+            {
+                for (std::uint32_t child = 0; child < node.childCount; ++child)
+                {
+                    stack[top++] = node.firstChild + child;
+                }
+                continue;
+            }
+
+            const Chunk& chunk = chunks_[node.chunk];
+            const int level = SelectLod(chunk, viewPos, lodScale);
+
+            // One patch unit per grid cell, starting at the chunk's corner.
+            item.model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(chunk.bounds.min.x, 0.0f, chunk.bounds.min.z)),
+                glm::vec3(cellSize, 1.0f, cellSize));
+            item.firstIndex = static_cast<GLsizei>(patchLods_[level].firstIndex);
+            item.count = static_cast<GLsizei>(patchLods_[level].indexCount);
+            const glm::vec3 center = 0.5f * (chunk.bounds.min + chunk.bounds.max);
+            queue.Submit(RenderPass::Opaque, item, glm::length(center - viewPos));
+        }
     }
 
-    float TerrainPlane::GetHeightAt(float x, float z) const
+    void TerrainPlane::ApplyPatch(const world::HeightField::Patch& patch)
     {
-        // Convert world coordinates to grid coordinates
-        float halfSize = size_ * 0.5f;
-        float cellSize = size_ / gridResolution_;
+        PLANE_PROFILE_SCOPE("TerrainPlane::ApplyPatch");
+        const world::HeightField::GridRect& rect = patch.rect;
+        if (heightTexture_ == 0 || rect.IsEmpty())
+        {
+            return;
+        }
 
-        float gridX = (x + halfSize) / cellSize;
-        float gridZ = (z + halfSize) / cellSize;
+        const int stride = gridResolution_ + 1;
+        const int width = rect.endX - rect.firstX;
+        const int depth = rect.endZ - rect.firstZ;
+        std::vector<std::uint16_t> texels(patch.heights.size());
+        for (int z = 0; z < depth; ++z)
+        {
+            for (int x = 0; x < width; ++x)
+            {
+                const std::size_t index = static_cast<std::size_t>(z) * width + x;
+                const float unorm = (std::clamp)((patch.heights[index] - heightMin_) / heightRange_, 0.0f, 1.0f);
+                texels[index] = static_cast<std::uint16_t>(std::lround(unorm * 65535.0f));
+                heights_[static_cast<std::size_t>(rect.firstZ + z) * stride + rect.firstX + x] = texels[index];
+            }
+        }
 
-        // Clamp to grid bounds
-        if (gridX < 0.0f || gridX >= gridResolution_ || gridZ < 0.0f || gridZ >= gridResolution_)
-            return 0.0f;  // Outside terrain, return water level
+        // Only the edited block goes over the bus.
+        glBindTexture(GL_TEXTURE_2D_ARRAY, heightTexture_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, rect.firstX, rect.firstZ, 0, width, depth, 1, GL_RED, GL_UNSIGNED_SHORT, texels.data());
+        glBindTexture(GL_TEXTURE_2D_ARRAY, normalTexture_);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, rect.firstX, rect.firstZ, 0, width, depth, 1, GL_RG, GL_BYTE, patch.normals.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        // Chunks share their edge vertices, so a block can reach one chunk further back.
+        const int chunksPerRow = gridResolution_ / ChunkCells;
+        const int firstChunkX = (std::max)(rect.firstX - 1, 0) / ChunkCells;
+        const int firstChunkZ = (std::max)(rect.firstZ - 1, 0) / ChunkCells;
+        const int lastChunkX = (std::min)((rect.endX - 1) / ChunkCells, chunksPerRow - 1);
+        const int lastChunkZ = (std::min)((rect.endZ - 1) / ChunkCells, chunksPerRow - 1);
+        if (firstChunkX > lastChunkX || firstChunkZ > lastChunkZ)
+        {
+            return;
+        }
 
-        // Bilinear interpolation
-        int x0 = static_cast<int>(std::floor(gridX));
-        int z0 = static_cast<int>(std::floor(gridZ));
-        int x1 = (std::min)(x0 + 1, gridResolution_);
-        int z1 = (std::min)(z0 + 1, gridResolution_);
+        // Measure the touched chunks again from the heights the GPU now has.
+        const float cellSize = size_ / gridResolution_;
+        const glm::vec2 origin(-0.5f * size_);
+        constexpr int kBlockSide = ChunkCells + 1;
+        std::array<float, kBlockSide * kBlockSide> block;
+        float skirtDepth = skirtDepth_;
+        for (int chunkZ = firstChunkZ; chunkZ <= lastChunkZ; ++chunkZ)
+        {
+            for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX)
+            {
+                const int firstX = chunkX * ChunkCells;
+                const int firstZ = chunkZ * ChunkCells;
+                for (int z = 0; z < kBlockSide; ++z)
+                {
+                    for (int x = 0; x < kBlockSide; ++x)
+                    {
+                        const std::uint16_t texel = heights_[static_cast<std::size_t>(firstZ + z) * stride + firstX + x];
+                        block[z * kBlockSide + x] = heightMin_ + texel / 65535.0f * heightRange_;
+                    }
+                }
+                const glm::vec2 blockOrigin = origin + glm::vec2(firstX, firstZ) * cellSize;
+                Chunk& chunk = chunks_[chunkZ * chunksPerRow + chunkX];
+                chunk = MeasureChunk(block.data(), kBlockSide, 0, 0, blockOrigin, cellSize);
+                chunk.bounds.min.y -= skirtDepth_;
+                skirtDepth = (std::max)(skirtDepth, chunk.geometricError[LodCount - 1] + cellSize);
+            }
+        }
 
-        float fx = gridX - x0;
-        float fz = gridZ - z0;
+        // A deeper crater can outgrow the skirts; lengthen them everywhere.
+        if (skirtDepth > skirtDepth_)
+        {
+            for (Chunk& chunk : chunks_)
+            {
+                chunk.bounds.min.y -= skirtDepth - skirtDepth_;
+            }
+            skirtDepth_ = skirtDepth;
+            for (Shader* shader : { shader_.get(), depthShader_.get() })
+            {
+                shader->use();
+                shader->setFloat("terrainSkirtDepth", skirtDepth_);
+            }
+        }
 
-        float h00 = SampleHeight(x0, z0);
-        float h10 = SampleHeight(x1, z0);
-        float h01 = SampleHeight(x0, z1);
-        float h11 = SampleHeight(x1, z1);
+        // Children always follow their parent, so one backward pass refits the quadtree.
+        for (std::size_t i = nodes_.size(); i-- > 0;)
+        {
+            QuadNode& node = nodes_[i];
+            if (node.chunk >= 0)
+            {
+                node.bounds = chunks_[node.chunk].bounds;
+                continue;
+            }
+            node.bounds = nodes_[node.firstChild].bounds;
+            for (std::uint32_t child = 1; child < node.childCount; ++child)
+            {
+                node.bounds = Union(node.bounds, nodes_[node.firstChild + child].bounds);
+            }
+        }
+    }
 
-        float h0 = Lerp(h00, h10, fx);
-        float h1 = Lerp(h01, h11, fx);
+    void TerrainPlane::BindHeightTextures(GlStateCache& state) const
+    {
+        state.BindTexture2DArray(kHeightUnit, heightTexture_);
+        state.BindTexture2DArray(kNormalUnit, normalTexture_);
+    }
 
-        return Lerp(h0, h1, fz);
+    void TerrainPlane::Shutdown()
+    {
+        if (vao_ != 0)
+        {
+            glDeleteVertexArrays(1, &vao_);
+            vao_ = 0;
+        }
+        if (vbo_ != 0)
+        {
+            glDeleteBuffers(1, &vbo_);
+            vbo_ = 0;
+        }
+        if (ebo_ != 0)
+        {
+            glDeleteBuffers(1, &ebo_);
+            ebo_ = 0;
+        }
+        for (unsigned int* texture : { &texture_, &heightTexture_, &normalTexture_ })
+        {
+            if (*texture != 0)
+            {
+                glDeleteTextures(1, texture);
+                *texture = 0;
+            }
+        }
+        shader_.reset();
+        depthShader_.reset();
     }
 }
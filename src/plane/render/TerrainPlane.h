@@ -5,34 +5,133 @@
 
 #include <learnopengl/shader_m.h>
 
+#include <array>
+#include <cstdint>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "Frustum.h"
+#include "GlStateCache.h"
+#include "RenderQueue.h"
+#include "TextureLoader.h"
+#include "world/HeightField.h"
+
 namespace plane::render
 {
-    // Grid-based heightmap terrain with collision support.
+    // GPU mesh for a world::HeightField; collision queries go to the height field itself.
+    // Only heights (16-bit) and octahedral normals (2x8-bit) are stored per grid vertex,
+    // as textures. Every chunk draws the same small patch template and terrain.vs
+    // rebuilds X/Z/UV from the chunk's transform and the texel under each vertex.
+    // Whole chunks only; TerrainTileStreamer draws the remainder and everything beyond.
     class TerrainPlane
     {
     public:
-        bool Initialize(const std::string& texturePath, float size = 2000.0f, int gridResolution = 100);
-        void Draw(Shader& shader, bool bindTexture = true) const;
+        // Detail levels per chunk; level n samples every 2^n-th grid vertex.
+        static constexpr int LodCount = 5;
+        // Grid cells per chunk side at full detail.
+        static constexpr int ChunkCells = 1 << (LodCount - 1);
+
+        // A square block of grid cells, drawn with the template LOD its distance allows.
+        struct Chunk
+        {
+            Aabb bounds;
+            // Worst height difference of each LOD from the full grid.
+            std::array<float, LodCount> geometricError {};
+        };
+
+        // Quadtree over the chunks for culling; leaves point at one chunk, and the
+        // children of a node are stored contiguously.
+        struct QuadNode
+        {
+            Aabb bounds;
+            std::uint32_t firstChild { 0 };
+            std::uint32_t childCount { 0 };
+            std::int32_t chunk { -1 };
+        };
+
+        // Index range of one LOD in the patch template, surface plus skirt.
+        struct PatchLod
+        {
+            unsigned int firstIndex { 0 };
+            unsigned int indexCount { 0 };
+        };
+
+        // Everything the GPU needs, built on any thread and uploaded by Initialize.
+        struct MeshData
+        {
+            float size { 0.0f };
+            int gridResolution { 0 };
+            // (gridResolution + 1)^2 texels each, row by row.
+            std::vector<std::uint16_t> heights;     // Unorm over [heightMin, heightMin + heightRange].
+            std::vector<std::int8_t> normals;       // HeightField::GetPackedNormals.
+            float heightMin { 0.0f };
+            float heightRange { 1.0f };
+            float skirtDepth { 0.0f };
+            // Patch template: x, z within the chunk and a skirt flag, one byte each plus padding.
+            std::vector<std::uint8_t> patchVertices;
+            std::vector<unsigned int> patchIndices;
+            std::array<PatchLod, LodCount> patchLods {};
+            std::vector<Chunk> chunks;
+            std::vector<QuadNode> nodes;            // Root first; empty for an empty grid.
+        };
+
+        // Heights, bounds, errors and the quadtree are kept in cacheDirectory under the
+        // height field's content key and mapped back in on a repeat; empty skips the cache.
+        static MeshData BuildMesh(const world::HeightField& heightField, const std::string& cacheDirectory = {});
+        bool Initialize(const DecodedImage& texture, const MeshData& mesh);
+
+        // Bounds and per-LOD errors of the chunk whose first vertex is (firstX, firstZ) in a
+        // row-major block of heights stride wide; origin is the world XZ of the block's first vertex.
+        static Chunk MeasureChunk(const float* heights, int stride, int firstX, int firstZ, const glm::vec2& origin, float cellSize);
+
+        // Multiplier from geometric error to the distance at which it projects to
+        // maxPixelError pixels on a viewport of the given height and vertical fov.
+        static float LodScale(float viewportHeight, float fovY, float maxPixelError);
+        // Coarsest LOD whose error stays within what lodScale allows at the chunk's distance.
+        static int SelectLod(const Chunk& chunk, const glm::vec3& viewPos, float lodScale);
+
+        // Empty, nearest-filtered side x side x layers texture array for texelFetch.
+        static unsigned int CreateGridArray(GLint internalFormat, GLenum format, GLenum type, int side, int layers);
+
+        // Queues the chunks inside the frustum, each at the coarsest LOD that stays within
+        // the error lodScale allows at its distance from viewPos. shadowPass selects the
+        // depth-only program.
+        void Submit(RenderQueue& queue, bool shadowPass, const Frustum& frustum, const glm::vec3& viewPos, float lodScale) const;
+        // Uploads one edited block of the height field into the textures and refits the
+        // chunks it touches. Heights below the range the mesh was built with clamp to it.
+        void ApplyPatch(const world::HeightField::Patch& patch);
+        // The height and normal textures sit on reserved units; bind them before executing
+        // a queue holding terrain, like the shadow map.
+        void BindHeightTextures(GlStateCache& state) const;
         void Shutdown();
 
-        // Query terrain height at any XZ world position using bilinear interpolation.
-        float GetHeightAt(float x, float z) const;
+        // Patch template and colour texture, for the tiles drawn around the grid; the VAO
+        // is 0 until Initialize.
+        GLuint GetPatchVao() const { return vao_; }
+        const PatchLod& GetPatchLod(int level) const { return patchLods_[level]; }
+        const TextureBinding& GetTextureBinding() const { return textureBinding_; }
 
     private:
-        void GenerateHeightmap();
-        float PerlinNoise(float x, float z) const;
-        float SampleHeight(int gridX, int gridZ) const;
-
         unsigned int vao_ { 0 };
         unsigned int vbo_ { 0 };
         unsigned int ebo_ { 0 };
         unsigned int texture_ { 0 };
+        unsigned int heightTexture_ { 0 };
+        unsigned int normalTexture_ { 0 };
+        TextureBinding textureBinding_ { 0, 0 };
+        std::unique_ptr<Shader> shader_;
+        std::unique_ptr<Shader> depthShader_;
+        std::array<PatchLod, LodCount> patchLods_ {};
+        std::vector<Chunk> chunks_;
+        std::vector<QuadNode> nodes_;
+        // Copy of the height texture, so edited chunks can be measured again.
+        std::vector<std::uint16_t> heights_;
+        float heightMin_ { 0.0f };
+        float heightRange_ { 1.0f };
+        float skirtDepth_ { 0.0f };
 
         float size_ { 2000.0f };           // Total world size (e.g., 2000x2000 units to match ground plane)
         int gridResolution_ { 100 };       // Number of grid cells per side (100x100 = 10000 vertices)
-        std::vector<float> heightmap_;     // Stores height values for each vertex
     };
 }
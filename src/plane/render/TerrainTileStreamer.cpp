@@ -0,0 +1,357 @@
+#include "TerrainTileStreamer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <iostream>
+
+#include "FrameUniforms.h"
+#include "world/HeightField.h"
+#include "core/Profiler.h"
+
+namespace plane::render
+{
+    namespace
+    {
+        // Reserved texture units, after TerrainPlane's (9, 10).
+        constexpr GLint kHeightUnit = 11;
+        constexpr GLint kNormalUnit = 12;
+
+        // Caps the loader queue, so flying fast never piles up tiles that are out of
+        // reach by the time they load.
+        constexpr std::size_t kMaxLoadsInFlight = 8;
+
+        constexpr int kTileSide = TerrainTileStreamer::TileCells + 1;
+
+        struct Candidate
+        {
+            float distance;
+            int tileX;
+            int tileZ;
+        };
+    }
+
+    bool TerrainTileStreamer::Initialize(const world::HeightField& heightField, int ringCount, int poolSize)
+    {
+        heightField_ = &heightField;
+        ringCount_ = ringCount;
+        origin_ = glm::vec2(-0.5f * heightField.GetSize());
+        cellSize_ = heightField.GetCellSize();
+        coveredCells_ = (heightField.GetGridResolution() / TerrainPlane::ChunkCells) * TerrainPlane::ChunkCells;
+        layerOwners_.assign(poolSize, 0);
+        layerUsed_.assign(poolSize, false);
+        skirtDepth_ = cellSize_;
+
+        heightArray_ = TerrainPlane::CreateGridArray(GL_R16, GL_RED, GL_UNSIGNED_SHORT, kTileSide, poolSize);
+        normalArray_ = TerrainPlane::CreateGridArray(GL_RG8_SNORM, GL_RG, GL_BYTE, kTileSide, poolSize);
+
+        // Same programs as TerrainPlane's, with one tile per layer.
+        const float heightMin = heightField.GetMinHeight();
+        const float heightRange = (std::max)(heightField.GetMaxHeight() - heightMin, 1e-3f);
+        shader_ = std::make_unique<Shader>("terrain.vs", "plane.fs");
+        depthShader_ = std::make_unique<Shader>("terrain.vs", "shadow_depth.fs");
+        for (Shader* shader : { shader_.get(), depthShader_.get() })
+        {
+            FrameUniforms::BindBlocks(shader->ID);
+            shader->use();
+            shader->setBool("shadowPass", shader == depthShader_.get());
+            shader->setInt("terrainHeights", kHeightUnit);
+            shader->setInt("terrainNormals", kNormalUnit);
+            shader->setVec2("terrainOrigin", origin_);
+            shader->setFloat("terrainCellSize", cellSize_);
+            shader->setInt("terrainResolution", TileCells);
+            shader->setInt("terrainTileCells", TileCells);
+            shader->setInt("terrainTextureCells", heightField.GetGridResolution());
+            shader->setVec2("terrainHeightRange", heightMin, heightRange);
+            shader->setFloat("terrainSkirtDepth", skirtDepth_);
+        }
+        Mesh::BindSamplerUnits(*shader_);
+        shader_->setInt("shadowMap", 1);
+        return true;
+    }
+
+    std::uint64_t TerrainTileStreamer::TileKey(int tileX, int tileZ)
+    {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(tileX)) << 32) | static_cast<std::uint32_t>(tileZ);
+    }
+
+    std::uint32_t TerrainTileStreamer::ChunkMask(int tileX, int tileZ) const
+    {
+        std::uint32_t mask = 0;
+        for (int chunkZ = 0; chunkZ < ChunksPerTile; ++chunkZ)
+        {
+            for (int chunkX = 0; chunkX < ChunksPerTile; ++chunkX)
+            {
+                const int firstX = tileX * TileCells + chunkX * TerrainPlane::ChunkCells;
+                const int firstZ = tileZ * TileCells + chunkZ * TerrainPlane::ChunkCells;
+                const bool covered = firstX >= 0 && firstX + TerrainPlane::ChunkCells <= coveredCells_
+                    && firstZ >= 0 && firstZ + TerrainPlane::ChunkCells <= coveredCells_;
+                if (!covered)
+                {
+                    mask |= 1u << (chunkZ * ChunksPerTile + chunkX);
+                }
+            }
+        }
+        return mask;
+    }
+
+    void TerrainTileStreamer::Update(const std::vector<glm::vec3>& focusPoints, AssetStreamer& streamer)
+    {
+        PLANE_PROFILE_SCOPE("TerrainTileStreamer::Update");
+        if (!heightField_)
+        {
+            return;
+        }
+        ++frame_;
+
+        const float tileSize = TileCells * cellSize_;
+        std::vector<Candidate> candidates;
+        for (const glm::vec3& focus : focusPoints)
+        {
+            const int centerX = static_cast<int>(std::floor((focus.x - origin_.x) / tileSize));
+            const int centerZ = static_cast<int>(std::floor((focus.z - origin_.y) / tileSize));
+            for (int tileZ = centerZ - ringCount_; tileZ <= centerZ + ringCount_; ++tileZ)
+            {
+                for (int tileX = centerX - ringCount_; tileX <= centerX + ringCount_; ++tileX)
+                {
+                    const glm::vec2 center = origin_ + (glm::vec2(tileX, tileZ) + 0.5f) * tileSize;
+                    candidates.push_back({ glm::length(center - glm::vec2(focus.x, focus.z)), tileX, tileZ });
+                }
+            }
+        }
+        std::sort(candidates.begin(), candidates.end(),
+            [](const Candidate& a, const Candidate& b) { return a.distance < b.distance; });
+
+        for (const Candidate& candidate : candidates)
+        {
+            const std::uint64_t key = TileKey(candidate.tileX, candidate.tileZ);
+            auto found = tiles_.find(key);
+            if (found != tiles_.end())
+            {
+                found->second.lastWanted = frame_;
+                continue;
+            }
+
+            const std::uint32_t chunkMask = ChunkMask(candidate.tileX, candidate.tileZ);
+            if (chunkMask == 0 || loadsInFlight_ >= kMaxLoadsInFlight)
+            {
+                continue;
+            }
+
+            Tile& tile = tiles_[key];
+            tile.lastWanted = frame_;
+            tile.chunkMask = chunkMask;
+            ++loadsInFlight_;
+
+            // The loader only reads the generator, which craters never change.
+            const world::HeightField* heightField = heightField_;
+            const int firstX = candidate.tileX * TileCells;
+            const int firstZ = candidate.tileZ * TileCells;
+            const glm::vec2 tileOrigin = origin_ + glm::vec2(firstX, firstZ) * cellSize_;
+            const float cellSize = cellSize_;
+            streamer.Enqueue("Load Terrain Tile", StreamPriority::Normal, [this, heightField, key, firstX, firstZ, tileOrigin, cellSize]
+            {
+                try
+                {
+                    auto data = std::make_shared<TileData>();
+                    std::vector<float> heights;
+                    heightField->GenerateTile(firstX, firstZ, TileCells, heights, data->normals);
+
+                    data->skirtDepth = cellSize;
+                    for (int chunkZ = 0; chunkZ < ChunksPerTile; ++chunkZ)
+                    {
+                        for (int chunkX = 0; chunkX < ChunksPerTile; ++chunkX)
+                        {
+                            TerrainPlane::Chunk& chunk = data->chunks[chunkZ * ChunksPerTile + chunkX];
+                            chunk = TerrainPlane::MeasureChunk(heights.data(), kTileSide,
+                                chunkX * TerrainPlane::ChunkCells, chunkZ * TerrainPlane::ChunkCells, tileOrigin, cellSize);
+                            data->skirtDepth = (std::max)(data->skirtDepth, chunk.geometricError[TerrainPlane::LodCount - 1] + cellSize);
+                        }
+                    }
+
+                    // One fixed range for every tile, so the programs need no per-tile uniforms.
+                    const float heightMin = heightField->GetMinHeight();
+                    const float heightRange = (std::max)(heightField->GetMaxHeight() - heightMin, 1e-3f);
+                    data->heights.reserve(heights.size());
+                    for (float height : heights)
+                    {
+                        data->heights.push_back(static_cast<std::uint16_t>(std::lround((height - heightMin) / heightRange * 65535.0f)));
+                    }
+                    return AssetStreamer::UploadStep([this, key, data] { FinishLoad(key, *data); });
+                }
+                catch (const std::exception& e)
+                {
+                    // The streamer would drop a throwing load without an upload step, leaving
+                    // the tile loading forever; hand it back so it can be asked for again.
+                    std::cout << "Terrain tile load failed: " << e.what() << std::endl;
+                    return AssetStreamer::UploadStep([this, key] { CancelLoad(key); });
+                }
+            });
+        }
+    }
+
+    int TerrainTileStreamer::AcquireLayer()
+    {
+        int oldest = -1;
+        std::uint64_t oldestWanted = frame_;
+        for (std::size_t layer = 0; layer < layerOwners_.size(); ++layer)
+        {
+            if (!layerUsed_[layer])
+            {
+                return static_cast<int>(layer);
+            }
+            const Tile& owner = tiles_.at(layerOwners_[layer]);
+            if (owner.lastWanted < oldestWanted)
+            {
+                oldest = static_cast<int>(layer);
+                oldestWanted = owner.lastWanted;
+            }
+        }
+        if (oldest >= 0)
+        {
+            tiles_.erase(layerOwners_[oldest]);
+            layerUsed_[oldest] = false;
+        }
+        return oldest;
+    }
+
+    void TerrainTileStreamer::CancelLoad(std::uint64_t key)
+    {
+        --loadsInFlight_;
+        auto found = tiles_.find(key);
+        if (found != tiles_.end() && found->second.layer < 0)
+        {
+            tiles_.erase(found);
+        }
+    }
+
+    void TerrainTileStreamer::FinishLoad(std::uint64_t key, const TileData& data)
+    {
+        PLANE_PROFILE_SCOPE("TerrainTileStreamer::FinishLoad");
+        --loadsInFlight_;
+        auto found = tiles_.find(key);
+        if (found == tiles_.end())
+        {
+            return;
+        }
+
+        // Out of reach by now, or no layer to spare: drop it; it is requested again if needed.
+        const int layer = (found->second.lastWanted == frame_) ? AcquireLayer() : -1;
+        if (layer < 0)
+        {
+            tiles_.erase(found);
+            return;
+        }
+
+        Tile& tile = found->second;
+        tile.layer = layer;
+        tile.chunks = data.chunks;
+        layerOwners_[layer] = key;
+        layerUsed_[layer] = true;
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, heightArray_);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, kTileSide, kTileSide, 1, GL_RED, GL_UNSIGNED_SHORT, data.heights.data());
+        glBindTexture(GL_TEXTURE_2D_ARRAY, normalArray_);
+        glTexSubImage3D(GL_TEXTURE_2D_ARRAY, 0, 0, 0, layer, kTileSide, kTileSide, 1, GL_RG, GL_BYTE, data.normals.data());
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, 0);
+
+        // Skirts hang as deep as the roughest tile so far needs; one depth serves them all.
+        for (std::size_t i = 0; i < tile.chunks.size(); ++i)
+        {
+            const TerrainPlane::Chunk& chunk = tile.chunks[i];
+            tile.bounds = (i == 0) ? chunk.bounds : Aabb { glm::min(tile.bounds.min, chunk.bounds.min), glm::max(tile.bounds.max, chunk.bounds.max) };
+        }
+        if (data.skirtDepth > skirtDepth_)
+        {
+            skirtDepth_ = data.skirtDepth;
+            for (Shader* shader : { shader_.get(), depthShader_.get() })
+            {
+                shader->use();
+                shader->setFloat("terrainSkirtDepth", skirtDepth_);
+            }
+        }
+    }
+
+    void TerrainTileStreamer::Submit(RenderQueue& queue, bool shadowPass, const Frustum& frustum, const glm::vec3& viewPos, float lodScale,
+        const TerrainPlane& terrain) const
+    {
+        PLANE_PROFILE_SCOPE("TerrainTileStreamer::Submit");
+        if (terrain.GetPatchVao() == 0 || !shader_)
+        {
+            return;
+        }
+
+        DrawItem item;
+        item.program = shadowPass ? depthShader_->ID : shader_->ID;
+        item.vao = terrain.GetPatchVao();
+        item.textures = &terrain.GetTextureBinding();
+        item.textureCount = (terrain.GetTextureBinding().id != 0) ? 1 : 0;
+
+        for (const auto& entry : tiles_)
+        {
+            const Tile& tile = entry.second;
+            if (tile.layer < 0)
+            {
+                continue;
+            }
+            // Skirts reach below the chunk bounds.
+            Aabb tileBounds = tile.bounds;
+            tileBounds.min.y -= skirtDepth_;
+            if (!frustum.IntersectsBox(tileBounds))
+            {
+                continue;
+            }
+
+            for (std::size_t i = 0; i < tile.chunks.size(); ++i)
+            {
+                if ((tile.chunkMask & (1u << i)) == 0)
+                {
+                    continue;
+                }
+                Aabb bounds = tile.chunks[i].bounds;
+                bounds.min.y -= skirtDepth_;
+                if (!frustum.IntersectsBox(bounds))
+                {
+                    continue;
+                }
+
+                const int level = TerrainPlane::SelectLod(tile.chunks[i], viewPos, lodScale);
+                // The layer rides in the Y translation; see terrain.vs.
+                item.model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(bounds.min.x, static_cast<float>(tile.layer), bounds.min.z)),
+                    glm::vec3(cellSize_, 1.0f, cellSize_));
+                item.firstIndex = static_cast<GLsizei>(terrain.GetPatchLod(level).firstIndex);
+                item.count = static_cast<GLsizei>(terrain.GetPatchLod(level).indexCount);
+                const glm::vec3 center = 0.5f * (bounds.min + bounds.max);
+                queue.Submit(RenderPass::Opaque, item, glm::length(center - viewPos));
+            }
+        }
+    }
+
+    void TerrainTileStreamer::BindHeightTextures(GlStateCache& state) const
+    {
+        state.BindTexture2DArray(kHeightUnit, heightArray_);
+        state.BindTexture2DArray(kNormalUnit, normalArray_);
+    }
+
+    void TerrainTileStreamer::Shutdown()
+    {
+        for (unsigned int* texture : { &heightArray_, &normalArray_ })
+        {
+            if (*texture != 0)
+            {
+                glDeleteTextures(1, texture);
+                *texture = 0;
+            }
+        }
+        tiles_.clear();
+        layerUsed_.assign(layerUsed_.size(), false);
+        loadsInFlight_ = 0;
+        heightField_ = nullptr;
+        shader_.reset();
+        depthShader_.reset();
+    }
+}
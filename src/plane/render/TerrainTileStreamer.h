@@ -0,0 +1,100 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include <learnopengl/shader_m.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include "AssetStreamer.h"
+#include "Frustum.h"
+#include "GlStateCache.h"
+#include "RenderQueue.h"
+#include "TerrainPlane.h"
+
+namespace plane::world { class HeightField; }
+
+namespace plane::render
+{
+    // Endless terrain around TerrainPlane: square tiles of the height field's lattice, kept
+    // within a few tiles of every focus point (the players). Tiles are generated on the
+    // AssetStreamer's loader threads and uploaded under its per-frame budget into a fixed
+    // pool of texture-array layers. When the pool is full the least recently wanted tile
+    // gives up its layer, so memory stays the same however far anyone flies.
+    class TerrainTileStreamer
+    {
+    public:
+        static constexpr int ChunksPerTile = 4;
+        static constexpr int TileCells = ChunksPerTile * TerrainPlane::ChunkCells;
+
+        // Keeps ringCount tiles around each focus in poolSize layers; the pool should hold
+        // every focus's rings at once, or the surplus tiles keep reloading.
+        bool Initialize(const world::HeightField& heightField, int ringCount, int poolSize);
+
+        // Main thread, once per frame. Marks the tiles around the focus points as wanted
+        // and requests the missing ones, nearest first.
+        void Update(const std::vector<glm::vec3>& focusPoints, AssetStreamer& streamer);
+
+        // Queues the chunks of resident tiles inside the frustum, like TerrainPlane::Submit.
+        // Tiles draw with terrain's patch and colour texture, so nothing shows before it
+        // is initialized.
+        void Submit(RenderQueue& queue, bool shadowPass, const Frustum& frustum, const glm::vec3& viewPos, float lodScale,
+            const TerrainPlane& terrain) const;
+        // Tile textures sit on their own reserved units; bind them with TerrainPlane's.
+        void BindHeightTextures(GlStateCache& state) const;
+        void Shutdown();
+
+    private:
+        using ChunkArray = std::array<TerrainPlane::Chunk, ChunksPerTile * ChunksPerTile>;
+
+        // Built on a loader thread, uploaded into a layer on the main thread.
+        struct TileData
+        {
+            std::vector<std::uint16_t> heights;     // Unorm over the generator's height range.
+            std::vector<std::int8_t> normals;
+            ChunkArray chunks {};
+            float skirtDepth { 0.0f };
+        };
+
+        struct Tile
+        {
+            int layer { -1 };                   // -1 while loading.
+            std::uint64_t lastWanted { 0 };     // Frame a focus last had it in reach.
+            std::uint32_t chunkMask { 0 };      // Chunks TerrainPlane does not draw.
+            ChunkArray chunks {};
+            Aabb bounds;
+        };
+
+        static std::uint64_t TileKey(int tileX, int tileZ);
+        std::uint32_t ChunkMask(int tileX, int tileZ) const;
+        void FinishLoad(std::uint64_t key, const TileData& data);
+        // Undoes a load that failed on the loader thread.
+        void CancelLoad(std::uint64_t key);
+        // A free layer, else the least recently wanted one not wanted this frame; -1 if none.
+        int AcquireLayer();
+
+        const world::HeightField* heightField_ { nullptr };
+        int ringCount_ { 0 };
+        glm::vec2 origin_ { 0.0f };             // World XZ of lattice vertex (0, 0).
+        float cellSize_ { 1.0f };
+        int coveredCells_ { 0 };                // TerrainPlane draws lattice cells [0, this)^2.
+
+        std::unordered_map<std::uint64_t, Tile> tiles_;
+        std::vector<std::uint64_t> layerOwners_;    // Tile key per layer.
+        std::vector<bool> layerUsed_;
+        std::uint64_t frame_ { 0 };
+        std::size_t loadsInFlight_ { 0 };
+        float skirtDepth_ { 0.0f };
+
+        unsigned int heightArray_ { 0 };
+        unsigned int normalArray_ { 0 };
+        std::unique_ptr<Shader> shader_;
+        std::unique_ptr<Shader> depthShader_;
+    };
+}
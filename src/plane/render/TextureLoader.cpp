@@ -1,48 +1,112 @@
 #include "TextureLoader.h"
 
+#include "BakedTexture.h"
+
 #include <glad/glad.h>
 #include <stb_image.h>
 
+#include <atomic>
+#include <cstring>
 #include <iostream>
 
 namespace plane::render
 {
-    unsigned int LoadTexture(const std::string& path)
+    namespace
+    {
+        std::atomic<bool> blockCompressionSupported { false };
+
+        GLenum ChannelFormat(int components)
+        {
+            if (components == 1)
+                return GL_RED;
+            if (components == 4)
+                return GL_RGBA;
+            return GL_RGB;
+        }
+    }
+
+    void DetectTextureSupport()
+    {
+        GLint extensionCount = 0;
+        glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+        for (GLint i = 0; i < extensionCount; ++i)
+        {
+            const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (name && std::strcmp(name, "GL_EXT_texture_compression_s3tc") == 0)
+            {
+                blockCompressionSupported.store(true, std::memory_order_relaxed);
+                return;
+            }
+        }
+    }
+
+    bool IsBlockCompressionSupported()
+    {
+        return blockCompressionSupported.load(std::memory_order_relaxed);
+    }
+
+    DecodedImage DecodeImage(const std::string& path)
+    {
+        DecodedImage image;
+        if (LoadBakedTexture(path, IsBlockCompressionSupported(), image))
+        {
+            return image;
+        }
+
+        image.path = path;
+        unsigned char* data = stbi_load(path.c_str(), &image.width, &image.height, &image.components, 0);
+        if (data)
+        {
+            image.storage.reset(data, [](unsigned char* pixels) { stbi_image_free(pixels); });
+            const std::size_t size = static_cast<std::size_t>(image.width) * image.height * image.components;
+            image.levels.push_back(DecodedImage::Level { image.width, image.height, data, size });
+        }
+        else
+        {
+            std::cout << "Texture failed to load at path: " << path << std::endl;
+        }
+        return image;
+    }
+
+    unsigned int UploadTexture(const DecodedImage& image)
     {
         // Mirrors LearnOpenGL helper so assets can reuse diffuse maps.
         unsigned int textureID;
         glGenTextures(1, &textureID);
 
-        int width, height, nrComponents;
-        unsigned char* data = stbi_load(path.c_str(), &width, &height, &nrComponents, 0);
-        if (data)
+        if (image.IsValid())
         {
-            GLenum format = GL_RGB;
-            if (nrComponents == 1)
-                format = GL_RED;
-            else if (nrComponents == 3)
-                format = GL_RGB;
-            else if (nrComponents == 4)
-                format = GL_RGBA;
+            const GLenum format = ChannelFormat(image.components);
 
             glBindTexture(GL_TEXTURE_2D, textureID);
-            glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-            glGenerateMipmap(GL_TEXTURE_2D);
+            // Baked mips of odd width are tightly packed.
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+            for (std::size_t level = 0; level < image.levels.size(); ++level)
+            {
+                const auto& mip = image.levels[level];
+                if (image.compressedFormat != 0)
+                    glCompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.compressedFormat, mip.width, mip.height, 0, static_cast<GLsizei>(mip.size), mip.data);
+                else
+                    glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), format, mip.width, mip.height, 0, format, GL_UNSIGNED_BYTE, mip.data);
+            }
+            glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+            if (image.levels.size() > 1)
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(image.levels.size() - 1));
+            else
+                glGenerateMipmap(GL_TEXTURE_2D);
 
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
             glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-            stbi_image_free(data);
-        }
-        else
-        {
-            std::cout << "Texture failed to load at path: " << path << std::endl;
-            stbi_image_free(data);
         }
 
         return textureID;
     }
-}
 
+    unsigned int LoadTexture(const std::string& path)
+    {
+        return UploadTexture(DecodeImage(path));
+    }
+}
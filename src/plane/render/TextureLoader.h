@@ -1,9 +1,49 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <string>
+#include <vector>
 
 namespace plane::render
 {
+    // Pixels decoded (or mapped from a baked file) on any thread, waiting for a GL upload.
+    struct DecodedImage
+    {
+        struct Level
+        {
+            int width { 0 };
+            int height { 0 };
+            const unsigned char* data { nullptr };
+            std::size_t size { 0 };
+        };
+
+        std::string path;
+        int width { 0 };
+        int height { 0 };
+        int components { 0 };
+        // GL block-compression format of every level; 0 for plain 8-bit channels.
+        unsigned int compressedFormat { 0 };
+        // Baked images carry their whole mip chain; decoded ones only level 0, and
+        // the upload generates the rest.
+        std::vector<Level> levels;
+        // Owns the bytes the levels point into (stb buffer or file mapping).
+        std::shared_ptr<const void> storage;
+
+        bool IsValid() const { return !levels.empty(); }
+    };
+
+    // GL thread, once, after the context exists. Baked block-compressed textures are
+    // only used when the driver can sample them.
+    void DetectTextureSupport();
+    bool IsBlockCompressionSupported();
+
+    // Thread-safe. Prefers an up-to-date baked texture next to the file, else decodes
+    // the file with stb_image.
+    DecodedImage DecodeImage(const std::string& path);
+
+    // GL thread only. Repeat-wrapped and mipmapped; an invalid image yields an empty texture.
+    unsigned int UploadTexture(const DecodedImage& image);
+
     unsigned int LoadTexture(const std::string& path);
 }
-
@@ -3,7 +3,11 @@
 layout (location = 0) in vec3 aPos;
 
 uniform mat4 model;
-uniform mat4 lightSpaceMatrix;
+layout (std140) uniform FrameBlock
+{
+    mat4 lightSpaceMatrix;
+    vec4 lightDir;
+};
 
 void main()
 {
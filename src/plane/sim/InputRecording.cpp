@@ -0,0 +1,335 @@
+#include "InputRecording.h"
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+namespace plane::sim
+{
+    namespace
+    {
+        constexpr char kMagic[4] = { 'P', 'L', 'R', 'C' };
+        // 2: terrain noise hashes integers; version 1 recordings were made on another world.
+        // 3: terrain heights follow the world seed.
+        // 4: terrain continues past the grid instead of dropping to water.
+        // 5: bullets stop at the ground and leave craters.
+        // 6: grid heights are quantized to 16 bits.
+        // 7: craters stay out of the grid's border, which the streamed tiles draw.
+        // 8: the header names the DEM the match was flown over.
+        constexpr std::uint32_t kFormatVersion = 8;
+
+        // Per-tick flags byte: one "changed" bit per player, plus a round reset.
+        constexpr std::uint8_t kResetFlag = 0x80;
+        static_assert(Simulation::PlayerCount <= 7, "player bits share a byte with kResetFlag");
+
+        // Per-player field mask.
+        constexpr std::uint8_t kButtonsChanged = 0x01;
+        constexpr std::uint8_t kControllerToggled = 0x02;
+        constexpr std::uint8_t kAnalogLeftYChanged = 0x04;
+        constexpr std::uint8_t kAnalogRightXChanged = 0x08;
+        constexpr std::uint8_t kTriggerLeftChanged = 0x10;
+        constexpr std::uint8_t kTriggerRightChanged = 0x20;
+
+        std::uint8_t ChangedFields(const input::PlayerInput& previous, const input::PlayerInput& current)
+        {
+            std::uint8_t mask = 0;
+            if (current.buttons != previous.buttons) mask |= kButtonsChanged;
+            if (current.hasController != previous.hasController) mask |= kControllerToggled;
+            if (current.analogLeftY != previous.analogLeftY) mask |= kAnalogLeftYChanged;
+            if (current.analogRightX != previous.analogRightX) mask |= kAnalogRightXChanged;
+            if (current.triggerLeft != previous.triggerLeft) mask |= kTriggerLeftChanged;
+            if (current.triggerRight != previous.triggerRight) mask |= kTriggerRightChanged;
+            return mask;
+        }
+
+        void WriteVarint(std::vector<std::uint8_t>& out, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                out.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            out.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        bool ReadVarint(const std::vector<std::uint8_t>& in, std::size_t& cursor, std::uint64_t& value)
+        {
+            value = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                if (cursor >= in.size())
+                {
+                    return false;
+                }
+                const std::uint8_t byte = in[cursor++];
+                value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        // Fixed-width little-endian fields for the header.
+        template <typename T>
+        void WriteFixed(std::vector<std::uint8_t>& out, T value)
+        {
+            static_assert(sizeof(T) == 4 || sizeof(T) == 8, "header fields are 32 or 64 bit");
+            std::uint64_t bits = 0;
+            std::memcpy(&bits, &value, sizeof(T));
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                out.push_back(static_cast<std::uint8_t>(bits >> (8 * i)));
+            }
+        }
+
+        template <typename T>
+        bool ReadFixed(const std::vector<std::uint8_t>& in, std::size_t& cursor, T& value)
+        {
+            if (in.size() - cursor < sizeof(T))
+            {
+                return false;
+            }
+            std::uint64_t bits = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                bits |= static_cast<std::uint64_t>(in[cursor++]) << (8 * i);
+            }
+            std::memcpy(&value, &bits, sizeof(T));
+            return true;
+        }
+    }
+
+    void InputRecorder::Begin(const Simulation& simulation, float simulationHz)
+    {
+        header_ = RecordingHeader{};
+        header_.config = simulation.GetConfig();
+        header_.terrainDemKey = simulation.GetHeightField().GetDemKey();
+        header_.simulationHz = simulationHz;
+        stream_.clear();
+        previous_ = Simulation::PlayerInputs{};
+        repeatRun_ = 0;
+        resetPending_ = false;
+    }
+
+    void InputRecorder::MarkReset()
+    {
+        resetPending_ = true;
+    }
+
+    void InputRecorder::Record(const Simulation::PlayerInputs& inputs)
+    {
+        ++header_.tickCount;
+
+        std::uint8_t flags = resetPending_ ? kResetFlag : 0;
+        std::uint8_t fieldMasks[Simulation::PlayerCount] = {};
+        for (std::size_t p = 0; p < Simulation::PlayerCount; ++p)
+        {
+            fieldMasks[p] = ChangedFields(previous_[p], inputs[p]);
+            if (fieldMasks[p] != 0)
+            {
+                flags |= static_cast<std::uint8_t>(1u << p);
+            }
+        }
+
+        if (flags == 0)
+        {
+            ++repeatRun_;
+            return;
+        }
+
+        WriteVarint(stream_, repeatRun_);
+        repeatRun_ = 0;
+        stream_.push_back(flags);
+
+        for (std::size_t p = 0; p < Simulation::PlayerCount; ++p)
+        {
+            const std::uint8_t mask = fieldMasks[p];
+            if (mask == 0)
+            {
+                continue;
+            }
+
+            const auto& input = inputs[p];
+            stream_.push_back(mask);
+            if (mask & kButtonsChanged) WriteVarint(stream_, static_cast<std::uint16_t>(input.buttons ^ previous_[p].buttons));
+            if (mask & kAnalogLeftYChanged) stream_.push_back(input.analogLeftY);
+            if (mask & kAnalogRightXChanged) stream_.push_back(input.analogRightX);
+            if (mask & kTriggerLeftChanged) stream_.push_back(input.triggerLeft);
+            if (mask & kTriggerRightChanged) stream_.push_back(input.triggerRight);
+        }
+
+        previous_ = inputs;
+        resetPending_ = false;
+    }
+
+    bool InputRecorder::Save(const std::string& path, std::uint64_t finalStateHash) const
+    {
+        std::vector<std::uint8_t> bytes(std::begin(kMagic), std::end(kMagic));
+        WriteFixed(bytes, kFormatVersion);
+        WriteFixed(bytes, static_cast<std::uint32_t>(Simulation::PlayerCount));
+        WriteFixed(bytes, header_.simulationHz);
+        WriteFixed(bytes, header_.config.worldSeed);
+        WriteFixed(bytes, header_.config.terrainSize);
+        WriteFixed(bytes, static_cast<std::int32_t>(header_.config.terrainResolution));
+        WriteFixed(bytes, static_cast<std::uint64_t>(header_.config.aiPlaneCount));
+        WriteFixed(bytes, header_.terrainDemKey);
+        WriteFixed(bytes, header_.tickCount);
+        WriteFixed(bytes, finalStateHash);
+
+        bytes.insert(bytes.end(), stream_.begin(), stream_.end());
+        // Trailing run of unchanged ticks, with no change tick after it.
+        if (repeatRun_ > 0)
+        {
+            WriteVarint(bytes, repeatRun_);
+        }
+
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        return static_cast<bool>(file);
+    }
+
+    bool InputReplay::Load(const std::string& path, std::uint64_t terrainDemKey)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file)
+        {
+            return false;
+        }
+        stream_.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+
+        if (stream_.size() < sizeof(kMagic) || std::memcmp(stream_.data(), kMagic, sizeof(kMagic)) != 0)
+        {
+            return false;
+        }
+        cursor_ = sizeof(kMagic);
+
+        std::uint32_t version = 0;
+        std::uint32_t playerCount = 0;
+        std::int32_t terrainResolution = 0;
+        std::uint64_t aiPlaneCount = 0;
+        header_ = RecordingHeader{};
+        if (!ReadFixed(stream_, cursor_, version) || version != kFormatVersion
+            || !ReadFixed(stream_, cursor_, playerCount) || playerCount != Simulation::PlayerCount
+            || !ReadFixed(stream_, cursor_, header_.simulationHz)
+            || !ReadFixed(stream_, cursor_, header_.config.worldSeed)
+            || !ReadFixed(stream_, cursor_, header_.config.terrainSize)
+            || !ReadFixed(stream_, cursor_, terrainResolution)
+            || !ReadFixed(stream_, cursor_, aiPlaneCount)
+            || !ReadFixed(stream_, cursor_, header_.terrainDemKey)
+            || !ReadFixed(stream_, cursor_, header_.tickCount)
+            || !ReadFixed(stream_, cursor_, header_.finalStateHash))
+        {
+            return false;
+        }
+        header_.config.terrainResolution = terrainResolution;
+        header_.config.aiPlaneCount = static_cast<std::size_t>(aiPlaneCount);
+        if (header_.terrainDemKey != terrainDemKey)
+        {
+            const char* recorded = (header_.terrainDemKey == 0) ? "the generated terrain" : (terrainDemKey == 0) ? "a DEM" : "a different DEM";
+            std::cout << path << " was recorded over " << recorded << ", not " << (terrainDemKey ? "this DEM" : "the generated terrain") << std::endl;
+            return false;
+        }
+
+        ticksRead_ = 0;
+        current_ = Simulation::PlayerInputs{};
+        repeatRun_ = 0;
+        runLoaded_ = false;
+        return true;
+    }
+
+    bool InputReplay::Next(Simulation::PlayerInputs& inputs, bool& resetBefore)
+    {
+        if (ticksRead_ >= header_.tickCount)
+        {
+            return false;
+        }
+
+        if (!runLoaded_)
+        {
+            if (!ReadVarint(stream_, cursor_, repeatRun_))
+            {
+                return false;
+            }
+            runLoaded_ = true;
+        }
+
+        resetBefore = false;
+        if (repeatRun_ > 0)
+        {
+            --repeatRun_;
+        }
+        else
+        {
+            if (!ReadChangeTick(resetBefore))
+            {
+                return false;
+            }
+            runLoaded_ = false;
+        }
+
+        inputs = current_;
+        ++ticksRead_;
+        return true;
+    }
+
+    bool InputReplay::ReadChangeTick(bool& resetBefore)
+    {
+        if (cursor_ >= stream_.size())
+        {
+            return false;
+        }
+        const std::uint8_t flags = stream_[cursor_++];
+        resetBefore = (flags & kResetFlag) != 0;
+
+        for (std::size_t p = 0; p < Simulation::PlayerCount; ++p)
+        {
+            if ((flags & (1u << p)) == 0)
+            {
+                continue;
+            }
+            if (cursor_ >= stream_.size())
+            {
+                return false;
+            }
+
+            auto& input = current_[p];
+            const std::uint8_t mask = stream_[cursor_++];
+            if (mask & kButtonsChanged)
+            {
+                std::uint64_t toggled = 0;
+                if (!ReadVarint(stream_, cursor_, toggled))
+                {
+                    return false;
+                }
+                input.buttons = static_cast<std::uint16_t>(input.buttons ^ toggled);
+            }
+            if (mask & kControllerToggled)
+            {
+                input.hasController = !input.hasController;
+            }
+
+            std::uint8_t* bytes[] = { &input.analogLeftY, &input.analogRightX, &input.triggerLeft, &input.triggerRight };
+            const std::uint8_t bits[] = { kAnalogLeftYChanged, kAnalogRightXChanged, kTriggerLeftChanged, kTriggerRightChanged };
+            for (std::size_t f = 0; f < 4; ++f)
+            {
+                if ((mask & bits[f]) == 0)
+                {
+                    continue;
+                }
+                if (cursor_ >= stream_.size())
+                {
+                    return false;
+                }
+                *bytes[f] = stream_[cursor_++];
+            }
+        }
+        return true;
+    }
+}
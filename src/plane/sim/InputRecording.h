@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Simulation.h"
+
+namespace plane::sim
+{
+    // Everything besides the inputs that a replay needs to rebuild the same match.
+    struct RecordingHeader
+    {
+        SimulationConfig config;      // worldSeed is always the resolved, non-zero seed.
+        // HeightField::GetDemKey of the recorded match. The DEM path is not part of config;
+        // this tells a replay whether it stands on the same terrain.
+        std::uint64_t terrainDemKey { 0 };
+        float simulationHz { 0.0f };
+        std::uint64_t tickCount { 0 };
+        // Simulation::ComputeStateHash after the last recorded tick; 0 if unknown.
+        std::uint64_t finalStateHash { 0 };
+    };
+
+    // Captures every tick's PlayerInputs as a compact byte stream. Runs of ticks
+    // whose inputs match the previous tick cost one varint in total; a tick that
+    // differs stores only the players and fields that changed (buttons as a
+    // varint XOR, stick and trigger bytes raw).
+    class InputRecorder
+    {
+    public:
+        // Drops anything recorded so far. Call after Simulation::Initialize.
+        void Begin(const Simulation& simulation, float simulationHz);
+
+        // The next recorded tick follows a Simulation::Reset (new round).
+        void MarkReset();
+        void Record(const Simulation::PlayerInputs& inputs);
+
+        std::uint64_t GetTickCount() const { return header_.tickCount; }
+        std::size_t GetStreamSize() const { return stream_.size(); }
+
+        bool Save(const std::string& path, std::uint64_t finalStateHash) const;
+
+    private:
+        RecordingHeader header_;
+        std::vector<std::uint8_t> stream_;
+        Simulation::PlayerInputs previous_ {};
+        std::uint64_t repeatRun_ { 0 };
+        bool resetPending_ { false };
+    };
+
+    // Plays a file written by InputRecorder back one tick at a time.
+    class InputReplay
+    {
+    public:
+        // False if the file is missing, truncated or from another format version, or if it
+        // was recorded over other terrain than terrainDemKey (HeightField::GetDemKey) names.
+        bool Load(const std::string& path, std::uint64_t terrainDemKey);
+
+        const RecordingHeader& GetHeader() const { return header_; }
+
+        // Decodes the next tick. resetBefore is set when the recorded match called
+        // Simulation::Reset right before it. Returns false once every tick is consumed.
+        bool Next(Simulation::PlayerInputs& inputs, bool& resetBefore);
+
+    private:
+        bool ReadChangeTick(bool& resetBefore);
+
+        RecordingHeader header_;
+        std::vector<std::uint8_t> stream_;
+        std::size_t cursor_ { 0 };
+        std::uint64_t ticksRead_ { 0 };
+
+        Simulation::PlayerInputs current_ {};
+        // Identical ticks still owed before the next change tick is decoded.
+        std::uint64_t repeatRun_ { 0 };
+        bool runLoaded_ { false };
+    };
+}
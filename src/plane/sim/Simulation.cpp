@@ -0,0 +1,274 @@
+#include "Simulation.h"
+#include "core/Profiler.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace plane::sim
+{
+    namespace
+    {
+        const glm::vec3 kSpawnPositions[Simulation::PlayerCount] = {
+            glm::vec3(100.0f, 26.0f, 0.0f),
+            glm::vec3(-100.0f, 96.0f, 0.0f)
+        };
+
+        // Planes per bulk job (booster, flight, collision). Big enough that a job
+        // outweighs its scheduling cost, small enough to spread hundreds of planes.
+        constexpr std::size_t kPlanesPerJob = 64;
+
+        // AI planes circle in a ring above the terrain's highest peaks.
+        constexpr float kAiRingRadius = 600.0f;
+        constexpr float kAiAltitude = 220.0f;
+        constexpr float kAiBankDegrees = 20.0f;
+
+        // Craters left in the terrain: a small pock per bullet, a deep bowl per crash.
+        constexpr float kBulletCraterRadius = 4.0f;
+        constexpr float kBulletCraterDepth = 0.5f;
+        constexpr float kCrashCraterRadius = 20.0f;
+        constexpr float kCrashCraterDepth = 6.0f;
+    }
+
+    void Simulation::Initialize(const SimulationConfig& config, core::JobSystem* jobSystem)
+    {
+        config_ = config;
+        if (config_.worldSeed == 0)
+        {
+            std::random_device rd;
+            config_.worldSeed = (static_cast<std::uint64_t>(rd()) << 32) | rd() | 1u;
+            // A one-off world would only leave a cache entry nothing ever reads again.
+            config_.terrainCacheDirectory.clear();
+        }
+        jobSystem_ = jobSystem;
+        heightField_.UseDem(config_.terrainDemPath);
+        heightField_.GenerateCached(config_.terrainCacheDirectory, config_.terrainSize, config_.terrainResolution,
+            config_.worldSeed, jobSystem_);
+        islandManager_.GenerateIslands(config_.worldSeed);
+
+        shootingSystem_.Initialize();
+        shootingSystem_.SetHeightField(&heightField_);
+        skeletalAnimationSystem_.Initialize();
+        movementSystem_.Initialize();
+        multiplayerManager_.Initialize();
+        collisionSystem_.Initialize(islandManager_, &heightField_);
+
+        Reset();
+    }
+
+    void Simulation::Reset()
+    {
+        PLANE_PROFILE_SCOPE("Simulation::Reset");
+        registry_.Clear();
+        registry_.Reserve(PlayerCount + config_.aiPlaneCount);
+
+        for (std::size_t i = 0; i < playerHandles_.size(); ++i)
+        {
+            core::PlaneState spawn;
+            spawn.position = kSpawnPositions[i];
+            playerHandles_[i] = registry_.Create(spawn);
+        }
+
+        for (std::size_t i = 0; i < config_.aiPlaneCount; ++i)
+        {
+            // Spread evenly around the ring, heading along it, staggered in height.
+            const float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(config_.aiPlaneCount);
+            core::PlaneState spawn;
+            spawn.position = glm::vec3(
+                kAiRingRadius * std::sin(angle),
+                kAiAltitude + 10.0f * static_cast<float>(i % 8),
+                kAiRingRadius * std::cos(angle));
+            spawn.yaw = std::fmod(glm::degrees(angle) + 90.0f, 360.0f);
+            spawn.roll = kAiBankDegrees;
+            registry_.Create(spawn);
+        }
+
+        // Clear bullets from the previous round.
+        shootingSystem_.Initialize();
+        tickCount_ = 0;
+    }
+
+    core::EntityHandle Simulation::SpawnPlane(const core::PlaneState& initial)
+    {
+        return registry_.Create(initial);
+    }
+
+    void Simulation::DespawnPlane(core::EntityHandle handle)
+    {
+        registry_.Destroy(handle);
+    }
+
+    core::PlaneState Simulation::GetPlayerState(std::size_t playerIndex) const
+    {
+        return registry_.Gather(registry_.IndexOf(playerHandles_[playerIndex]));
+    }
+
+    std::size_t Simulation::ChunkBegin(std::size_t chunk) const
+    {
+        return (std::min)(chunk * kPlanesPerJob, registry_.Size());
+    }
+
+    std::size_t Simulation::ChunkEnd(std::size_t chunk) const
+    {
+        return (std::min)((chunk + 1) * kPlanesPerJob, registry_.Size());
+    }
+
+    void Simulation::BuildStepGraph(std::size_t chunkCount)
+    {
+        // Piloted planes apply their controls first, one job each, touching only their
+        // own registry row. Then every plane runs booster -> flight -> collision in
+        // chunks of kPlanesPerJob; chunks cover disjoint rows, so they run side by
+        // side. Shooting moves bullets and damages any plane, so it waits for every
+        // chunk. Craters from crashes and bullet strikes go in last, on their own, since
+        // collision and bullets read the terrain. The placeholder systems share nothing
+        // with the planes and start immediately.
+        stepGraph_.Clear();
+        stepGraphChunks_ = chunkCount;
+        crashSites_.resize(chunkCount);
+
+        const auto shooting = stepGraph_.Add("ShootingSystem", [this]
+        {
+            for (std::size_t i = 0; i < pendingShots_.size(); ++i)
+            {
+                for (const auto& bullet : pendingShots_[i])
+                {
+                    shootingSystem_.AddBullet(bullet);
+                }
+                pendingShots_[i].clear();
+            }
+            shootingSystem_.Update(stepDeltaTime_, registry_);
+        });
+
+        // Chunk order, then bullet order, so every run digs the same craters.
+        const auto deformation = stepGraph_.Add("Terrain Deformation", [this]
+        {
+            for (auto& sites : crashSites_)
+            {
+                for (const auto& site : sites)
+                {
+                    heightField_.Deform(site.x, site.z, kCrashCraterRadius, kCrashCraterDepth);
+                }
+                sites.clear();
+            }
+            for (const auto& hit : shootingSystem_.GetGroundHits())
+            {
+                heightField_.Deform(hit.x, hit.z, kBulletCraterRadius, kBulletCraterDepth);
+            }
+        });
+        stepGraph_.Precede(shooting, deformation);
+
+        std::array<core::JobGraph::JobId, PlayerCount> controls;
+        for (std::size_t i = 0; i < PlayerCount; ++i)
+        {
+            controls[i] = stepGraph_.Add("Player Controls", [this, i]
+            {
+                const std::size_t index = registry_.IndexOf(playerHandles_[i]);
+                core::PlaneState player = registry_.Gather(index);
+                const auto& input = stepInputs_[i];
+
+                flightControls_.Apply(input, player, stepDeltaTime_);
+
+                // Fire bullets at a rate-limited cadence while the fire key is held.
+                player.fireCooldown = (std::max)(0.0f, player.fireCooldown - stepDeltaTime_);
+                if (flightControls_.IsFirePressed(input) && player.fireCooldown <= 0.0f)
+                {
+                    pendingShots_[i].push_back(shootingSystem_.CreateBullet(player));
+                    player.fireCooldown = (player.fireRatePerSec > 0.0f) ? (1.0f / player.fireRatePerSec) : 0.0f;
+                }
+
+                registry_.Scatter(index, player);
+            });
+        }
+
+        for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+        {
+            const auto booster = stepGraph_.Add("Plane Booster", [this, chunk]
+            {
+                boosterSystem_.Update(registry_, ChunkBegin(chunk), ChunkEnd(chunk), stepDeltaTime_);
+            });
+            const auto flight = stepGraph_.Add("Plane Flight", [this, chunk]
+            {
+                planeController_.UpdateFlightDynamics(registry_, ChunkBegin(chunk), ChunkEnd(chunk), stepDeltaTime_);
+            });
+            const auto collision = stepGraph_.Add("Plane Collision", [this, chunk]
+            {
+                collisionSystem_.CheckAndResolveCollisions(registry_, ChunkBegin(chunk), ChunkEnd(chunk), stepDeltaTime_,
+                    &crashSites_[chunk]);
+            });
+
+            for (const auto control : controls)
+            {
+                stepGraph_.Precede(control, booster);
+            }
+            stepGraph_.Precede(booster, flight);
+            stepGraph_.Precede(flight, collision);
+            stepGraph_.Precede(collision, shooting);
+        }
+
+        stepGraph_.Add("SkeletalAnimationSystem", [this] { skeletalAnimationSystem_.Update(stepDeltaTime_); });
+        stepGraph_.Add("AdvancedMovementSystem", [this] { movementSystem_.Update(stepDeltaTime_); });
+        stepGraph_.Add("MultiplayerManager", [this] { multiplayerManager_.Update(stepDeltaTime_); });
+    }
+
+    void Simulation::Step(const PlayerInputs& inputs, float deltaTime)
+    {
+        PLANE_PROFILE_SCOPE("Simulation::Step");
+        const std::size_t chunkCount = (registry_.Size() + kPlanesPerJob - 1) / kPlanesPerJob;
+        if (chunkCount != stepGraphChunks_ || stepGraph_.Size() == 0)
+        {
+            BuildStepGraph(chunkCount);
+        }
+
+        stepInputs_ = inputs;
+        stepDeltaTime_ = deltaTime;
+
+        if (jobSystem_)
+            jobSystem_->Run(stepGraph_);
+        else
+            stepGraph_.RunInline();
+
+        ++tickCount_;
+    }
+
+    std::uint64_t Simulation::ComputeStateHash() const
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        auto mix = [&hash](const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+        };
+        // Hash fields one by one; padding bytes inside the structs are indeterminate.
+        for (std::size_t i = 0; i < registry_.Size(); ++i)
+        {
+            const core::PlaneState state = registry_.Gather(i);
+            mix(&state.position, sizeof(state.position));
+            mix(&state.pitch, sizeof(state.pitch));
+            mix(&state.yaw, sizeof(state.yaw));
+            mix(&state.roll, sizeof(state.roll));
+            mix(&state.baseSpeed, sizeof(state.baseSpeed));
+            mix(&state.speed, sizeof(state.speed));
+            mix(&state.health, sizeof(state.health));
+            mix(&state.boosterFuelSeconds, sizeof(state.boosterFuelSeconds));
+            mix(&state.fireCooldown, sizeof(state.fireCooldown));
+        }
+        for (const auto& bullet : shootingSystem_.GetBullets())
+        {
+            mix(&bullet.position, sizeof(bullet.position));
+            mix(&bullet.lifetime, sizeof(bullet.lifetime));
+        }
+        return hash;
+    }
+
+    bool Simulation::IsAnyPlayerDown() const
+    {
+        const auto& healths = registry_.Healths();
+        return std::any_of(playerHandles_.begin(), playerHandles_.end(),
+            [&](core::EntityHandle handle) { return !healths[registry_.IndexOf(handle)].alive; });
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "core/EntityRegistry.h"
+#include "core/JobSystem.h"
+#include "core/PlaneState.h"
+#include "entities/PlaneController.h"
+#include "features/animation/SkeletalAnimationSystem.h"
+#include "features/movement/AdvancedMovementSystem.h"
+#include "features/movement/BoosterSystem.h"
+#include "features/multiplayer/MultiplayerManager.h"
+#include "features/shooting/ShootingSystem.h"
+#include "input/FlightControls.h"
+#include "input/PlayerInput.h"
+#include "physics/CollisionSystem.h"
+#include "world/HeightField.h"
+#include "world/IslandManager.h"
+
+namespace plane::sim
+{
+    struct SimulationConfig
+    {
+        float terrainSize { 3000.0f };    // 5x size
+        int terrainResolution { 250 };    // 2.5x grid resolution
+        // Unpiloted planes spawned in a ring each round. They hold a constant bank
+        // and circle, but take part in boosting, collision and bullet hits.
+        std::size_t aiPlaneCount { 0 };
+        // Drives all procedural world content. 0 picks a fresh seed on Initialize;
+        // GetWorldSeed reports the one actually used.
+        std::uint64_t worldSeed { 0 };
+        // Generated height fields are kept here and mapped back in when the seed, size
+        // and resolution repeat. Empty disables the cache, as does a worldSeed of 0; it
+        // is not part of replays.
+        std::string terrainCacheDirectory;
+        // A .pdem to sample heights from instead of the noise generator. Empty, or a file
+        // that cannot be used, keeps the generator. Paths differ between machines, so
+        // recordings store the DEM's content key instead (RecordingHeader::terrainDemKey).
+        std::string terrainDemPath;
+    };
+
+    // Everything that advances the match: planes, bullets, boosters, collision and the
+    // height field they fly over. Owns no window or GL state, so the same code runs
+    // inside PlaneApplication and the plane_headless benchmark.
+    class Simulation
+    {
+    public:
+        static constexpr std::size_t PlayerCount = 2;
+        using PlayerInputs = std::array<input::PlayerInput, PlayerCount>;
+
+        Simulation() = default;
+        // The step graph captures 'this'.
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+
+        // With a job system the per-player pipelines and independent systems run in
+        // parallel; without one the same graph runs serially on the calling thread.
+        void Initialize(const SimulationConfig& config = {}, core::JobSystem* jobSystem = nullptr);
+
+        // Respawn every plane and clear bullets for a new round. Player and AI handles
+        // from the previous round go stale. Craters stay; the terrain is not regenerated.
+        void Reset();
+
+        // Advance one fixed tick.
+        void Step(const PlayerInputs& inputs, float deltaTime);
+
+        // Add or remove planes between ticks. Player planes must not be despawned.
+        core::EntityHandle SpawnPlane(const core::PlaneState& initial);
+        void DespawnPlane(core::EntityHandle handle);
+
+        // Gathered copy of one plane; prefer GetRegistry's columns when visiting many.
+        core::PlaneState GetPlayerState(std::size_t playerIndex) const;
+        core::EntityHandle GetPlayerHandle(std::size_t playerIndex) const { return playerHandles_[playerIndex]; }
+        bool IsAnyPlayerDown() const;
+
+        // Players and AI planes alike, in dense order.
+        const core::EntityRegistry& GetRegistry() const { return registry_; }
+
+        const features::shooting::ShootingSystem& GetShootingSystem() const { return shootingSystem_; }
+        const world::HeightField& GetHeightField() const { return heightField_; }
+        // Grid blocks cratered since the last call; see HeightField::TakeDirtyRects.
+        void TakeTerrainEdits(std::vector<world::HeightField::GridRect>& rects) { heightField_.TakeDirtyRects(rects); }
+        const SimulationConfig& GetConfig() const { return config_; }
+        std::uint64_t GetWorldSeed() const { return config_.worldSeed; }
+        std::uint64_t GetTickCount() const { return tickCount_; }
+
+        // FNV-1a over every plane column and bullet. Equal hashes after the same
+        // inputs mean the runs stayed in lockstep; used to spot replay desyncs.
+        std::uint64_t ComputeStateHash() const;
+
+    private:
+        void BuildStepGraph(std::size_t chunkCount);
+        // Dense index range covered by one chunk of the bulk per-plane jobs.
+        std::size_t ChunkBegin(std::size_t chunk) const;
+        std::size_t ChunkEnd(std::size_t chunk) const;
+
+        SimulationConfig config_;
+        core::EntityRegistry registry_;
+        std::array<core::EntityHandle, PlayerCount> playerHandles_;
+
+        world::HeightField heightField_;
+        world::IslandManager islandManager_;
+
+        input::FlightControls flightControls_;
+        entities::PlaneController planeController_;
+        physics::CollisionSystem collisionSystem_;
+
+        features::shooting::ShootingSystem shootingSystem_;
+        features::animation::SkeletalAnimationSystem skeletalAnimationSystem_;
+        features::movement::AdvancedMovementSystem movementSystem_;
+        features::movement::BoosterSystem boosterSystem_;
+        features::multiplayer::MultiplayerManager multiplayerManager_;
+
+        core::JobSystem* jobSystem_ { nullptr };
+        core::JobGraph stepGraph_;
+        // Bulk jobs each cover a fixed number of planes; the graph is rebuilt when
+        // spawning or despawning changes how many chunks that takes.
+        std::size_t stepGraphChunks_ { 0 };
+        // Inputs of the tick in flight, read by the step graph's jobs.
+        PlayerInputs stepInputs_ {};
+        float stepDeltaTime_ { 0.0f };
+        // Bullets fired this tick, handed to the shooting system in player order.
+        std::array<std::vector<features::shooting::Bullet>, PlayerCount> pendingShots_;
+        // Where the ground brought planes down this tick, one list per collision chunk.
+        std::vector<std::vector<glm::vec3>> crashSites_;
+
+        std::uint64_t tickCount_ { 0 };
+    };
+}
@@ -0,0 +1,77 @@
+#version 330 core
+// Terrain patch vertex: grid offset inside the chunk plus a skirt flag. Position, normal
+// and UV are rebuilt from the height and normal texel under the vertex. Each texture
+// layer holds one square tile of the lattice; the chunk's tile is the one holding its
+// corner, and its layer rides in the model's Y translation (the patch itself is flat).
+layout (location = 0) in vec3 aPatch;
+
+out VS_OUT
+{
+    vec3 FragPos;
+    vec3 Normal;
+    vec2 TexCoords;
+    vec4 FragPosLightSpace;
+} vs_out;
+
+uniform mat4 model;                     // Chunk corner, one unit per grid cell; Y is the layer.
+uniform sampler2DArray terrainHeights;  // R16 unorm over terrainHeightRange.
+uniform sampler2DArray terrainNormals;  // Octahedral RG8 snorm.
+uniform vec2 terrainOrigin;             // World XZ of lattice vertex (0, 0).
+uniform float terrainCellSize;
+uniform int terrainResolution;          // Cells per layer side.
+uniform int terrainTileCells;           // Lattice cells between tile origins.
+uniform int terrainTextureCells;        // Cells one repeat of the colour texture spans.
+uniform vec2 terrainHeightRange;    // Minimum, extent.
+uniform float terrainSkirtDepth;
+uniform bool shadowPass;
+
+layout (std140) uniform FrameBlock
+{
+    mat4 lightSpaceMatrix;
+    vec4 lightDir;
+};
+
+layout (std140) uniform ViewBlock
+{
+    mat4 projection;
+    mat4 view;
+    vec4 viewPos;
+};
+
+vec3 DecodeNormal(vec2 e)
+{
+    vec3 n = vec3(e, 1.0 - abs(e.x) - abs(e.y));
+    if (n.z < 0.0)
+    {
+        n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+    }
+    // Encoded with Y up folded onto the third axis.
+    return normalize(n.xzy);
+}
+
+void main()
+{
+    vec2 chunkCell = round((model[3].xz - terrainOrigin) / terrainCellSize);
+    ivec2 tileFirst = ivec2(floor(chunkCell / float(terrainTileCells))) * terrainTileCells;
+    vec2 patchXZ = (model * vec4(aPatch.x, 0.0, aPatch.y, 1.0)).xz;
+    ivec2 texel = clamp(ivec2(round((patchXZ - terrainOrigin) / terrainCellSize)) - tileFirst, ivec2(0), ivec2(terrainResolution));
+    ivec3 texelLayer = ivec3(texel, int(model[3].y));
+    ivec2 cell = tileFirst + texel;
+
+    float height = terrainHeightRange.x + texelFetch(terrainHeights, texelLayer, 0).r * terrainHeightRange.y;
+    height -= aPatch.z * terrainSkirtDepth;
+    vec2 xz = terrainOrigin + vec2(cell) * terrainCellSize;
+    vec4 worldPos = vec4(xz.x, height, xz.y, 1.0);
+
+    if (shadowPass)
+    {
+        gl_Position = lightSpaceMatrix * worldPos;
+        return;
+    }
+
+    vs_out.FragPos = worldPos.xyz;
+    vs_out.Normal = DecodeNormal(texelFetch(terrainNormals, texelLayer, 0).rg);
+    vs_out.TexCoords = vec2(cell) / float(terrainTextureCells);
+    vs_out.FragPosLightSpace = lightSpaceMatrix * worldPos;
+    gl_Position = projection * view * worldPos;
+}
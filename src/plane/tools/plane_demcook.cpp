@@ -0,0 +1,161 @@
+#include "core/MappedFile.h"
+#include "world/TiledHeightmap.h"
+
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Offline cook step: converts a 16-bit elevation model into the tiled .pdem the game
+// maps (see world::TiledHeightmap and AppConfig::TerrainDemPath).
+// Usage: plane_demcook source output.pdem [--size WxH] [--spacing M] [--scale M]
+//                      [--offset M] [--swap-bytes]
+// .png sources are decoded at 16 bits per sample (grey, or the first channel).
+// Anything else is read as headerless little-endian 16-bit RAW, row by row; give its
+// --size unless it is square. --swap-bytes reads big-endian RAW instead. --spacing is
+// the metres between samples (default 30), and heights come out as offset + sample *
+// scale metres (default 0 + sample * 1). RAW sources are mapped and converted a row of
+// tiles at a time, so even very large ones cook in little memory.
+namespace
+{
+    bool HasPngExtension(const std::string& path)
+    {
+        std::string extension = std::filesystem::path(path).extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png";
+    }
+
+    bool ParseSize(const char* text, int& width, int& depth)
+    {
+        char* end = nullptr;
+        width = static_cast<int>(std::strtol(text, &end, 10));
+        if (end == text || (*end != 'x' && *end != 'X'))
+            return false;
+        depth = static_cast<int>(std::strtol(end + 1, nullptr, 10));
+        return width > 0 && depth > 0;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3)
+    {
+        std::cout << "Usage: plane_demcook source output.pdem [--size WxH] [--spacing M] [--scale M] [--offset M] [--swap-bytes]" << std::endl;
+        return 1;
+    }
+
+    const std::string sourcePath = argv[1];
+    const std::string outputPath = argv[2];
+    plane::world::DemSettings settings;
+    int width = 0;
+    int depth = 0;
+    bool swapBytes = false;
+    for (int i = 3; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--swap-bytes") == 0)
+        {
+            swapBytes = true;
+            continue;
+        }
+        if (i + 1 >= argc)
+            break;
+        if (std::strcmp(argv[i], "--size") == 0)
+        {
+            if (!ParseSize(argv[i + 1], width, depth))
+            {
+                std::cout << "Bad --size " << argv[i + 1] << ", expected WxH" << std::endl;
+                return 1;
+            }
+        }
+        else if (std::strcmp(argv[i], "--spacing") == 0)
+            settings.sampleSpacing = std::strtof(argv[i + 1], nullptr);
+        else if (std::strcmp(argv[i], "--scale") == 0)
+            settings.heightScale = std::strtof(argv[i + 1], nullptr);
+        else if (std::strcmp(argv[i], "--offset") == 0)
+            settings.heightOffset = std::strtof(argv[i + 1], nullptr);
+        ++i;
+    }
+    if (!(settings.sampleSpacing > 0.0f))
+    {
+        std::cout << "--spacing must be positive" << std::endl;
+        return 1;
+    }
+
+    plane::core::FileStamp stamp;
+    plane::core::GetFileStamp(sourcePath, stamp);
+
+    // Either points into the mapped RAW file or at decoded/swapped samples below.
+    const std::uint16_t* samples = nullptr;
+    plane::core::MappedFile raw;
+    std::vector<std::uint16_t> converted;
+    if (HasPngExtension(sourcePath))
+    {
+        int components = 0;
+        stbi_us* pixels = stbi_load_16(sourcePath.c_str(), &width, &depth, &components, 0);
+        if (!pixels)
+        {
+            std::cout << "Cannot decode " << sourcePath << ": " << stbi_failure_reason() << std::endl;
+            return 1;
+        }
+        converted.resize(static_cast<std::size_t>(width) * depth);
+        for (std::size_t i = 0; i < converted.size(); ++i)
+        {
+            converted[i] = pixels[i * components];
+        }
+        stbi_image_free(pixels);
+        samples = converted.data();
+    }
+    else
+    {
+        if (!raw.Open(sourcePath))
+        {
+            std::cout << "Cannot map " << sourcePath << std::endl;
+            return 1;
+        }
+        const std::size_t sampleCount = raw.Size() / sizeof(std::uint16_t);
+        if (width == 0)
+        {
+            width = depth = static_cast<int>(std::lround(std::sqrt(static_cast<double>(sampleCount))));
+        }
+        if (static_cast<std::size_t>(width) * depth != sampleCount || raw.Size() % sizeof(std::uint16_t) != 0)
+        {
+            std::cout << sourcePath << " holds " << raw.Size() << " bytes, not " << width << "x" << depth
+                      << " 16-bit samples; pass --size WxH" << std::endl;
+            return 1;
+        }
+        samples = reinterpret_cast<const std::uint16_t*>(raw.Data());
+        if (swapBytes)
+        {
+            converted.assign(samples, samples + sampleCount);
+            for (std::uint16_t& sample : converted)
+            {
+                sample = static_cast<std::uint16_t>((sample << 8) | (sample >> 8));
+            }
+            samples = converted.data();
+        }
+    }
+
+    if (!plane::world::TiledHeightmap::Write(outputPath, samples, width, depth, settings, stamp))
+    {
+        std::cout << "Failed to write " << outputPath << std::endl;
+        return 1;
+    }
+
+    plane::world::TiledHeightmap dem;
+    if (!dem.Open(outputPath))
+    {
+        return 1;
+    }
+    std::cout << "Cooked " << sourcePath << " (" << width << "x" << depth << " samples, "
+              << width * settings.sampleSpacing / 1000.0f << "x" << depth * settings.sampleSpacing / 1000.0f << " km, "
+              << dem.GetMinHeight() << " to " << dem.GetMaxHeight() << " m) into " << outputPath << std::endl;
+    return 0;
+}
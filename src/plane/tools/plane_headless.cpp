@@ -0,0 +1,191 @@
+#include "core/AppConfig.h"
+#include "core/JobSystem.h"
+#include "core/Profiler.h"
+#include "sim/InputRecording.h"
+#include "sim/Simulation.h"
+#include "world/TiledHeightmap.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+// Runs the simulation without a window or GL context, as fast as the CPU allows.
+// Usage: plane_headless [--ticks N] [--workers N] [--planes N] [--seed N] [--terrain-cache DIR]
+//                       [--dem terrain.pdem] [--trace trace.json] [--record run.rec | --replay run.rec]
+// --workers 0 runs the step graph inline on the main thread.
+// --planes adds N circling AI planes alongside the two scripted players.
+// --terrain-cache reuses generated height fields from DIR (the game uses terrain_cache).
+// --dem flies over a cooked elevation model. Recordings remember which one, so pass the
+// same --dem again when replaying one made over a DEM.
+// --record saves the scripted inputs; --replay re-simulates a recording (from here or
+// from the game's plane_replay.rec) instead and checks its final state hash.
+namespace
+{
+    // Deterministic stand-in for two players: both throttle up and fire, with a slow
+    // alternating pitch/roll pattern so collision and bullet paths get exercised.
+    plane::sim::Simulation::PlayerInputs ScriptedInputs(std::uint64_t tick)
+    {
+        using plane::input::PlayerInput;
+
+        plane::sim::Simulation::PlayerInputs inputs {};
+        const std::uint64_t phase = (tick / 240) % 4;
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            auto& input = inputs[i];
+            input.buttons = PlayerInput::ThrottleUp | PlayerInput::Fire;
+            if (phase == 1)
+                input.buttons |= (i == 0) ? PlayerInput::PitchUp : PlayerInput::RollLeft;
+            else if (phase == 3)
+                input.buttons |= (i == 0) ? PlayerInput::RollRight : PlayerInput::PitchDown;
+        }
+        return inputs;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::uint64_t tickCount = 120000;
+    unsigned workerCount = plane::core::JobSystem::DefaultWorkerCount();
+    plane::sim::SimulationConfig config;
+    std::string tracePath;
+    std::string recordPath;
+    std::string replayPath;
+    for (int i = 1; i + 1 < argc; i += 2)
+    {
+        if (std::strcmp(argv[i], "--ticks") == 0)
+            tickCount = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--workers") == 0)
+            workerCount = static_cast<unsigned>(std::strtoul(argv[i + 1], nullptr, 10));
+        else if (std::strcmp(argv[i], "--planes") == 0)
+            config.aiPlaneCount = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--seed") == 0)
+            config.worldSeed = std::strtoull(argv[i + 1], nullptr, 10);
+        else if (std::strcmp(argv[i], "--terrain-cache") == 0)
+            config.terrainCacheDirectory = argv[i + 1];
+        else if (std::strcmp(argv[i], "--dem") == 0)
+            config.terrainDemPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--trace") == 0)
+            tracePath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--record") == 0)
+            recordPath = argv[i + 1];
+        else if (std::strcmp(argv[i], "--replay") == 0)
+            replayPath = argv[i + 1];
+        else
+            std::cout << "Ignoring unknown option " << argv[i] << std::endl;
+    }
+
+    // A replay brings its own world, tick rate and length.
+    plane::sim::InputReplay replay;
+    float simulationHz = plane::core::AppConfig::SimulationHz;
+    if (!replayPath.empty())
+    {
+        // Opened here only for its key; the simulation maps it again on Initialize.
+        plane::world::TiledHeightmap dem;
+        const bool demOpen = !config.terrainDemPath.empty() && dem.Open(config.terrainDemPath);
+        if (!replay.Load(replayPath, demOpen ? dem.GetContentKey() : 0))
+        {
+            std::cout << "Failed to load input recording " << replayPath << std::endl;
+            return 1;
+        }
+        const std::string terrainCacheDirectory = config.terrainCacheDirectory;
+        const std::string terrainDemPath = config.terrainDemPath;
+        config = replay.GetHeader().config;
+        config.terrainCacheDirectory = terrainCacheDirectory;
+        config.terrainDemPath = terrainDemPath;
+        simulationHz = replay.GetHeader().simulationHz;
+        tickCount = replay.GetHeader().tickCount;
+    }
+
+    plane::core::Profiler::SetEnabled(!tracePath.empty());
+    plane::core::Profiler::SetThreadName("Simulation");
+
+    std::unique_ptr<plane::core::JobSystem> jobSystem;
+    if (workerCount > 0)
+        jobSystem = std::make_unique<plane::core::JobSystem>(workerCount);
+
+    const float deltaTime = 1.0f / simulationHz;
+
+    plane::sim::Simulation simulation;
+    simulation.Initialize(config, jobSystem.get());
+
+    plane::sim::InputRecorder recorder;
+    recorder.Begin(simulation, simulationHz);
+
+    std::uint64_t rounds = 1;
+    const auto start = std::chrono::steady_clock::now();
+    if (!replayPath.empty())
+    {
+        plane::sim::Simulation::PlayerInputs inputs;
+        bool resetBefore = false;
+        std::uint64_t replayed = 0;
+        while (replay.Next(inputs, resetBefore))
+        {
+            if (resetBefore)
+            {
+                simulation.Reset();
+                ++rounds;
+            }
+            simulation.Step(inputs, deltaTime);
+            ++replayed;
+        }
+        tickCount = replayed;
+    }
+    else
+    {
+        for (std::uint64_t tick = 0; tick < tickCount; ++tick)
+        {
+            const auto inputs = ScriptedInputs(tick);
+            recorder.Record(inputs);
+            simulation.Step(inputs, deltaTime);
+            if (simulation.IsAnyPlayerDown())
+            {
+                simulation.Reset();
+                recorder.MarkReset();
+                ++rounds;
+            }
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    const double seconds = std::chrono::duration<double>(end - start).count();
+    const double ticksPerSecond = (seconds > 0.0) ? (tickCount / seconds) : 0.0;
+    std::cout << "Simulated " << tickCount << " ticks (" << (tickCount * deltaTime) << " s game time, "
+              << rounds << " rounds, " << simulation.GetRegistry().Size() << " planes) on " << (workerCount + 1) << " thread(s) in " << seconds << " s" << std::endl;
+    std::cout << ticksPerSecond << " ticks/s, " << (ticksPerSecond / simulationHz)
+              << "x real time" << std::endl;
+
+    const std::uint64_t stateHash = simulation.ComputeStateHash();
+    std::cout << "World seed " << simulation.GetWorldSeed() << ", final state hash 0x" << std::hex << stateHash << std::dec << std::endl;
+
+    int exitCode = 0;
+    if (!replayPath.empty() && replay.GetHeader().finalStateHash != 0)
+    {
+        if (stateHash == replay.GetHeader().finalStateHash)
+        {
+            std::cout << "Replay matches the recorded final state" << std::endl;
+        }
+        else
+        {
+            std::cout << "DESYNC: recording ended at state hash 0x" << std::hex << replay.GetHeader().finalStateHash << std::dec << std::endl;
+            exitCode = 2;
+        }
+    }
+
+    if (!recordPath.empty())
+    {
+        if (recorder.Save(recordPath, stateHash))
+            std::cout << "Wrote " << recorder.GetTickCount() << " ticks of input (" << recorder.GetStreamSize() << " bytes) to " << recordPath << std::endl;
+        else
+            std::cout << "Failed to write input recording to " << recordPath << std::endl;
+    }
+
+    if (!tracePath.empty() && !plane::core::Profiler::WriteChromeTrace(tracePath))
+    {
+        std::cout << "Failed to write profile trace to " << tracePath << std::endl;
+        return 1;
+    }
+    return exitCode;
+}
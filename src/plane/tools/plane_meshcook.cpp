@@ -0,0 +1,77 @@
+#include "render/BakedModel.h"
+
+#include <learnopengl/filesystem.h>
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Offline cook step: parses model files with Assimp once and writes the baked
+// "<model>.pmesh" next to each, which the game loads instead of the source.
+// Usage: plane_meshcook [file-or-directory ...]
+// Directories are searched recursively for .dae, .obj, .fbx and .gltf files.
+// With no arguments it cooks everything under resources/objects.
+// Needs no window or GL context; models are parsed without uploading.
+namespace
+{
+    bool IsModelFile(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".dae" || extension == ".obj" || extension == ".fbx" || extension == ".gltf";
+    }
+
+    void CollectModels(const std::filesystem::path& root, std::vector<std::string>& out)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(root, error))
+        {
+            out.push_back(root.generic_string());
+            return;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+        {
+            if (entry.is_regular_file() && IsModelFile(entry.path()))
+                out.push_back(entry.path().generic_string());
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i)
+        CollectModels(argv[i], sources);
+    if (argc == 1)
+        CollectModels(FileSystem::getPath("resources/objects"), sources);
+
+    std::size_t cooked = 0;
+    for (const auto& source : sources)
+    {
+        Model model(source, false, nullptr, false);
+        if (model.meshes.empty())
+        {
+            std::cout << "Skipping " << source << ": no meshes" << std::endl;
+            continue;
+        }
+        if (!plane::render::BakeModel(model, source))
+        {
+            std::cout << "Failed to write " << plane::render::BakedModelPath(source) << std::endl;
+            continue;
+        }
+
+        std::size_t vertexCount = 0;
+        for (const auto& mesh : model.meshes)
+            vertexCount += mesh.vertices.size();
+        std::cout << "Cooked " << source << " (" << model.meshes.size() << " meshes, " << vertexCount << " vertices)" << std::endl;
+        ++cooked;
+    }
+
+    std::cout << "Cooked " << cooked << " of " << sources.size() << " model(s)" << std::endl;
+    return (cooked == sources.size()) ? 0 : 1;
+}
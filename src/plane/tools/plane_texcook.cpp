@@ -0,0 +1,90 @@
+#include "render/BakedTexture.h"
+
+#include <learnopengl/filesystem.h>
+#include <stb_image.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <system_error>
+#include <vector>
+
+// Offline cook step: decodes images once, builds their full mip chain and writes the
+// baked "<image>.ptex" next to each, which the game maps instead of decoding.
+// Usage: plane_texcook [--uncompressed] [file-or-directory ...]
+// By default RGB images are stored as BC1 and RGBA images as BC3; --uncompressed
+// keeps the source channels. Directories are searched recursively for .jpg, .jpeg,
+// .png, .tga and .bmp files. With no paths it cooks everything under resources.
+// The game only uses compressed bakes when the driver exposes S3TC.
+namespace
+{
+    bool IsImageFile(const std::filesystem::path& path)
+    {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".tga" || extension == ".bmp";
+    }
+
+    void CollectImages(const std::filesystem::path& root, std::vector<std::string>& out)
+    {
+        std::error_code error;
+        if (!std::filesystem::is_directory(root, error))
+        {
+            out.push_back(root.generic_string());
+            return;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator(root, error))
+        {
+            if (entry.is_regular_file() && IsImageFile(entry.path()))
+                out.push_back(entry.path().generic_string());
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    bool compress = true;
+    std::vector<std::string> sources;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--uncompressed") == 0)
+            compress = false;
+        else
+            CollectImages(argv[i], sources);
+    }
+    if (sources.empty())
+        CollectImages(FileSystem::getPath("resources"), sources);
+
+    std::size_t cooked = 0;
+    for (const auto& source : sources)
+    {
+        int width = 0;
+        int height = 0;
+        int components = 0;
+        if (!stbi_info(source.c_str(), &width, &height, &components))
+        {
+            std::cout << "Skipping " << source << ": not a readable image" << std::endl;
+            continue;
+        }
+
+        using plane::render::BakedTextureFormat;
+        BakedTextureFormat format = BakedTextureFormat::Uncompressed;
+        if (compress)
+            format = (components == 4) ? BakedTextureFormat::BC3 : BakedTextureFormat::BC1;
+
+        if (!plane::render::BakeTexture(source, format))
+        {
+            std::cout << "Failed to write " << plane::render::BakedTexturePath(source) << std::endl;
+            continue;
+        }
+        std::cout << "Cooked " << source << " (" << width << "x" << height << ", " << components << " channel(s))" << std::endl;
+        ++cooked;
+    }
+
+    std::cout << "Cooked " << cooked << " of " << sources.size() << " image(s)" << std::endl;
+    return (cooked == sources.size()) ? 0 : 1;
+}
@@ -0,0 +1,724 @@
+#include "HeightField.h"
+#include "core/JobSystem.h"
+#include "core/MappedFile.h"
+#include "core/Profiler.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PLANE_HEIGHTFIELD_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace plane::world
+{
+    namespace
+    {
+        // Multi-octave value noise for natural terrain: amplitude halves and frequency
+        // doubles per octave.
+        constexpr int kOctaves = 5;
+        constexpr float kBaseAmplitude = 150.0f;
+        constexpr float kBaseFrequency = 2.5f;
+        // Lifts the terrain so some areas sit above water (0.0) and some below.
+        constexpr float kBaseHeight = 10.0f;
+
+        // Sum of every octave's amplitude; noise stays within [-1, 1] per octave.
+        constexpr float TotalAmplitude()
+        {
+            float total = 0.0f;
+            float amplitude = kBaseAmplitude;
+            for (int octave = 0; octave < kOctaves; ++octave)
+            {
+                total += amplitude;
+                amplitude *= 0.5f;
+            }
+            return total;
+        }
+
+        // Rows per generation job; a band's normals wait for its neighbours' heights.
+        constexpr int kRowsPerBand = 64;
+
+        // Queued dirty blocks before they collapse into one.
+        constexpr std::size_t kMaxDirtyRects = 64;
+
+        // Bands cover whole rows of grid tiles, so no two jobs write the same tile.
+        static_assert(kRowsPerBand % MortonHeightGrid::TileSide == 0, "bands must not share grid tiles");
+
+        // How far below the source's lowest point craters can dig before the quantized
+        // grid clamps them.
+        constexpr float kCraterHeadroom = 64.0f;
+
+        constexpr char kCacheMagic[4] = { 'P', 'H', 'F', 'C' };
+        // 2: heights are the quantized Morton tiles of MortonHeightGrid.
+        constexpr std::uint32_t kCacheFormatVersion = 2;
+
+        // Followed by the height grid's tiles and the packed normals.
+        struct CacheHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::uint64_t key;
+            std::uint64_t seed;
+            float size;
+            std::int32_t gridResolution;
+        };
+
+        std::uint64_t Fnv1a(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        // Integer lattice hash: multiplies, xors and shifts only, so the SSE2 lanes
+        // produce the scalar result bit for bit.
+        std::uint32_t HashBits(std::uint32_t x, std::uint32_t z, std::uint32_t key)
+        {
+            std::uint32_t h = (x * 0x8da6b343u) ^ (z * 0xd8163841u) ^ key;
+            h ^= h >> 15;
+            h *= 0x2c1b3c6du;
+            h ^= h >> 12;
+            h *= 0x297a2d39u;
+            h ^= h >> 15;
+            return h;
+        }
+
+        // Top 24 bits of the hash as a float in [0, 1).
+        constexpr float kHashScale = 1.0f / 16777216.0f;
+
+        float Hash(int x, int z, std::uint32_t key)
+        {
+            return static_cast<float>(HashBits(static_cast<std::uint32_t>(x), static_cast<std::uint32_t>(z), key) >> 8) * kHashScale;
+        }
+
+        // Smooth interpolation
+        float Lerp(float a, float b, float t)
+        {
+            return a + t * (b - a);
+        }
+
+        float SmoothStep(float t)
+        {
+            return t * t * (3.0f - 2.0f * t);
+        }
+
+        // Value noise in [-1, 1].
+        float ValueNoise(float x, float z, std::uint32_t key)
+        {
+            int xi = static_cast<int>(std::floor(x));
+            int zi = static_cast<int>(std::floor(z));
+
+            float xf = x - static_cast<float>(xi);
+            float zf = z - static_cast<float>(zi);
+
+            // Get corner values using hash
+            float n00 = Hash(xi, zi, key);
+            float n10 = Hash(xi + 1, zi, key);
+            float n01 = Hash(xi, zi + 1, key);
+            float n11 = Hash(xi + 1, zi + 1, key);
+
+            float sx = SmoothStep(xf);
+            float sz = SmoothStep(zf);
+
+            float nx0 = Lerp(n00, n10, sx);
+            float nx1 = Lerp(n01, n11, sx);
+
+            return Lerp(nx0, nx1, sz) * 2.0f - 1.0f;
+        }
+
+        float LayeredHeight(int x, float worldZ, int gridResolution, std::uint32_t key)
+        {
+            float worldX = static_cast<float>(x) / static_cast<float>(gridResolution);
+            float height = 0.0f;
+            float amplitude = kBaseAmplitude;
+            float frequency = kBaseFrequency;
+            for (int octave = 0; octave < kOctaves; ++octave)
+            {
+                height += ValueNoise(worldX * frequency, worldZ * frequency, key) * amplitude;
+                amplitude *= 0.5f;
+                frequency *= 2.0f;
+            }
+            return height + kBaseHeight;
+        }
+
+#ifdef PLANE_HEIGHTFIELD_SSE
+        // Low 32 bits of a lane-wise 32-bit multiply; SSE2 only has the even-lane 64-bit form.
+        __m128i MulLo32(__m128i a, __m128i b)
+        {
+            const __m128i even = _mm_mul_epu32(a, b);
+            const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+            return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)), _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+        }
+
+        __m128 Hash4(__m128i x, __m128i z, __m128i key)
+        {
+            __m128i h = _mm_xor_si128(MulLo32(x, _mm_set1_epi32(static_cast<int>(0x8da6b343u))),
+                                      MulLo32(z, _mm_set1_epi32(static_cast<int>(0xd8163841u))));
+            h = _mm_xor_si128(h, key);
+            h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+            h = MulLo32(h, _mm_set1_epi32(0x2c1b3c6d));
+            h = _mm_xor_si128(h, _mm_srli_epi32(h, 12));
+            h = MulLo32(h, _mm_set1_epi32(0x297a2d39));
+            h = _mm_xor_si128(h, _mm_srli_epi32(h, 15));
+            return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(h, 8)), _mm_set1_ps(kHashScale));
+        }
+
+        __m128 Lerp4(__m128 a, __m128 b, __m128 t)
+        {
+            return _mm_add_ps(a, _mm_mul_ps(t, _mm_sub_ps(b, a)));
+        }
+
+        __m128 SmoothStep4(__m128 t)
+        {
+            return _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(_mm_set1_ps(3.0f), _mm_mul_ps(_mm_set1_ps(2.0f), t)));
+        }
+
+        // ValueNoise for four x coordinates on one z.
+        __m128 ValueNoise4(__m128 x, float z, __m128i key)
+        {
+            // Floor from truncation: lanes that rounded up (negative x) step down by one.
+            __m128i xi = _mm_cvttps_epi32(x);
+            xi = _mm_add_epi32(xi, _mm_castps_si128(_mm_cmpgt_ps(_mm_cvtepi32_ps(xi), x)));
+            const int zi = static_cast<int>(std::floor(z));
+            const __m128 xf = _mm_sub_ps(x, _mm_cvtepi32_ps(xi));
+            const float zf = z - static_cast<float>(zi);
+
+            const __m128i one = _mm_set1_epi32(1);
+            const __m128i xi1 = _mm_add_epi32(xi, one);
+            const __m128i z0 = _mm_set1_epi32(zi);
+            const __m128i z1 = _mm_set1_epi32(zi + 1);
+
+            const __m128 sx = SmoothStep4(xf);
+            const __m128 sz = _mm_set1_ps(SmoothStep(zf));
+
+            const __m128 nx0 = Lerp4(Hash4(xi, z0, key), Hash4(xi1, z0, key), sx);
+            const __m128 nx1 = Lerp4(Hash4(xi, z1, key), Hash4(xi1, z1, key), sx);
+            return _mm_sub_ps(_mm_mul_ps(Lerp4(nx0, nx1, sz), _mm_set1_ps(2.0f)), _mm_set1_ps(1.0f));
+        }
+#endif
+
+        // Heights of count lattice vertices from (firstX, z) along one row.
+        void GenerateRow(int firstX, int count, int z, int gridResolution, std::uint32_t hashKey, float* out)
+        {
+            const float worldZ = static_cast<float>(z) / static_cast<float>(gridResolution);
+            int i = 0;
+#ifdef PLANE_HEIGHTFIELD_SSE
+            const __m128 resolution = _mm_set1_ps(static_cast<float>(gridResolution));
+            const __m128i key = _mm_set1_epi32(static_cast<int>(hashKey));
+            for (; i + 4 <= count; i += 4)
+            {
+                const int x = firstX + i;
+                const __m128 worldX = _mm_div_ps(_mm_cvtepi32_ps(_mm_setr_epi32(x, x + 1, x + 2, x + 3)), resolution);
+                __m128 height = _mm_setzero_ps();
+                float amplitude = kBaseAmplitude;
+                float frequency = kBaseFrequency;
+                for (int octave = 0; octave < kOctaves; ++octave)
+                {
+                    const __m128 noise = ValueNoise4(_mm_mul_ps(worldX, _mm_set1_ps(frequency)), worldZ * frequency, key);
+                    height = _mm_add_ps(height, _mm_mul_ps(noise, _mm_set1_ps(amplitude)));
+                    amplitude *= 0.5f;
+                    frequency *= 2.0f;
+                }
+                _mm_storeu_ps(out + i, _mm_add_ps(height, _mm_set1_ps(kBaseHeight)));
+            }
+#endif
+            for (; i < count; ++i)
+            {
+                out[i] = LayeredHeight(firstX + i, worldZ, gridResolution, hashKey);
+            }
+        }
+
+        // Central differences over the four lattice neighbours.
+        glm::vec3 NormalFromNeighbours(float heightL, float heightR, float heightD, float heightU, float cellSize)
+        {
+            return glm::normalize(glm::vec3(heightL - heightR, 2.0f * cellSize, heightD - heightU));
+        }
+
+        // Octahedral encoding of a unit normal into two snorm bytes.
+        void EncodeNormal(const glm::vec3& normal, std::int8_t* out)
+        {
+            // Y is up, so the terrain's hemisphere folds around +Y.
+            glm::vec3 n(normal.x, normal.z, normal.y);
+            n /= std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+            glm::vec2 e(n.x, n.y);
+            if (n.z < 0.0f)
+            {
+                e = glm::vec2((1.0f - std::abs(n.y)) * (n.x >= 0.0f ? 1.0f : -1.0f),
+                              (1.0f - std::abs(n.x)) * (n.y >= 0.0f ? 1.0f : -1.0f));
+            }
+            out[0] = static_cast<std::int8_t>(std::lround(glm::clamp(e.x, -1.0f, 1.0f) * 127.0f));
+            out[1] = static_cast<std::int8_t>(std::lround(glm::clamp(e.y, -1.0f, 1.0f) * 127.0f));
+        }
+    }
+
+    void HeightField::Generate(float size, int gridResolution, std::uint64_t seed, core::JobSystem* jobSystem)
+    {
+        PLANE_PROFILE_SCOPE("HeightField::Generate");
+        size_ = size;
+        gridResolution_ = gridResolution;
+        seed_ = seed;
+        // Fold all 64 seed bits into the hash, then mix so nearby seeds look unrelated.
+        hashKey_ = HashBits(static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32), 0);
+
+        const int rows = gridResolution_ + 1;
+        const std::size_t vertexCount = static_cast<std::size_t>(rows) * rows;
+        heights_.Resize(rows, GetMinHeight() - kCraterHeadroom, GetMaxHeight());
+        normals_.resize(vertexCount * 2);
+        dirtyRects_.clear();
+
+        // Heights first, band by band; a band's normals read one row past each edge,
+        // so they wait for the neighbouring bands too.
+        core::JobGraph graph;
+        const int bandCount = (rows + kRowsPerBand - 1) / kRowsPerBand;
+        std::vector<core::JobGraph::JobId> heightJobs(bandCount);
+        for (int band = 0; band < bandCount; ++band)
+        {
+            const int firstRow = band * kRowsPerBand;
+            const int endRow = (std::min)(firstRow + kRowsPerBand, rows);
+            heightJobs[band] = graph.Add("HeightField Heights", [this, firstRow, endRow] { GenerateRows(firstRow, endRow); });
+        }
+        for (int band = 0; band < bandCount; ++band)
+        {
+            const int firstRow = band * kRowsPerBand;
+            const int endRow = (std::min)(firstRow + kRowsPerBand, rows);
+            const auto normals = graph.Add("HeightField Normals", [this, firstRow, endRow, rows]
+            {
+                GenerateNormals(GridRect { 0, firstRow, rows, endRow });
+            });
+            for (int neighbour = (std::max)(band - 1, 0); neighbour <= (std::min)(band + 1, bandCount - 1); ++neighbour)
+            {
+                graph.Precede(heightJobs[neighbour], normals);
+            }
+        }
+
+        if (jobSystem)
+            jobSystem->Run(graph);
+        else
+            graph.RunInline();
+    }
+
+    void HeightField::GenerateRows(int firstRow, int endRow)
+    {
+        const int rows = gridResolution_ + 1;
+        std::vector<float> row(rows);
+        for (int z = firstRow; z < endRow; ++z)
+        {
+            SourceRow(0, rows, z, row.data());
+            heights_.SetRow(0, rows, z, row.data());
+        }
+    }
+
+    void HeightField::GenerateNormals(const GridRect& rect)
+    {
+        const int rows = gridResolution_ + 1;
+        const float cellSize = GetCellSize();
+        for (int z = rect.firstZ; z < rect.endZ; ++z)
+        {
+            std::int8_t* out = normals_.data() + static_cast<std::size_t>(z) * rows * 2;
+            for (int x = rect.firstX; x < rect.endX; ++x)
+            {
+                // Neighbours past the edge are generated, so edge normals match the terrain beyond.
+                const float heightL = (x > 0) ? heights_.Get(x - 1, z) : GeneratedHeight(x - 1, z);
+                const float heightR = (x < gridResolution_) ? heights_.Get(x + 1, z) : GeneratedHeight(x + 1, z);
+                const float heightD = (z > 0) ? heights_.Get(x, z - 1) : GeneratedHeight(x, z - 1);
+                const float heightU = (z < gridResolution_) ? heights_.Get(x, z + 1) : GeneratedHeight(x, z + 1);
+                EncodeNormal(NormalFromNeighbours(heightL, heightR, heightD, heightU, cellSize), out + x * 2);
+            }
+        }
+    }
+
+    HeightField::GridRect HeightField::Deform(float x, float z, float radius, float depth)
+    {
+        PLANE_PROFILE_SCOPE("HeightField::Deform");
+        if (heights_.GetSide() == 0 || radius <= 0.0f || depth <= 0.0f)
+            return {};
+
+        const float cellSize = GetCellSize();
+        const float halfSize = size_ * 0.5f;
+        const float centreX = (x + halfSize) / cellSize;
+        const float centreZ = (z + halfSize) / cellSize;
+        const float cellRadius = radius / cellSize;
+
+        // Vertices 0 and editableCells are shared with the streamed tiles, and so is the
+        // normal of each, so their neighbours keep their heights too.
+        const int editableCells = (gridResolution_ / DeformBlockCells) * DeformBlockCells;
+        GridRect heights;
+        heights.firstX = (std::max)(static_cast<int>(std::ceil(centreX - cellRadius)), 2);
+        heights.firstZ = (std::max)(static_cast<int>(std::ceil(centreZ - cellRadius)), 2);
+        heights.endX = (std::min)(static_cast<int>(std::floor(centreX + cellRadius)) + 1, editableCells - 1);
+        heights.endZ = (std::min)(static_cast<int>(std::floor(centreZ + cellRadius)) + 1, editableCells - 1);
+        if (heights.IsEmpty())
+            return {};
+
+        for (int gz = heights.firstZ; gz < heights.endZ; ++gz)
+        {
+            for (int gx = heights.firstX; gx < heights.endX; ++gx)
+            {
+                const float dx = (static_cast<float>(gx) - centreX) / cellRadius;
+                const float dz = (static_cast<float>(gz) - centreZ) / cellRadius;
+                const float t = (std::min)(dx * dx + dz * dz, 1.0f);
+                // (1 - t)^2 of the squared distance: full depth at the centre, flat at the rim.
+                heights_.Set(gx, gz, heights_.Get(gx, gz) - depth * (1.0f - t) * (1.0f - t));
+            }
+        }
+
+        // A changed height tilts the normals of its four neighbours as well.
+        GridRect dirty;
+        dirty.firstX = heights.firstX - 1;
+        dirty.firstZ = heights.firstZ - 1;
+        dirty.endX = heights.endX + 1;
+        dirty.endZ = heights.endZ + 1;
+        GenerateNormals(dirty);
+        AddDirtyRect(dirty);
+        return dirty;
+    }
+
+    void HeightField::AddDirtyRect(const GridRect& rect)
+    {
+        // Grow the new block by every queued one it overlaps until none is left to absorb.
+        GridRect merged = rect;
+        bool grew = true;
+        while (grew)
+        {
+            grew = false;
+            for (std::size_t i = 0; i < dirtyRects_.size(); ++i)
+            {
+                const GridRect& other = dirtyRects_[i];
+                if (other.firstX >= merged.endX || merged.firstX >= other.endX ||
+                    other.firstZ >= merged.endZ || merged.firstZ >= other.endZ)
+                {
+                    continue;
+                }
+                merged.firstX = (std::min)(merged.firstX, other.firstX);
+                merged.firstZ = (std::min)(merged.firstZ, other.firstZ);
+                merged.endX = (std::max)(merged.endX, other.endX);
+                merged.endZ = (std::max)(merged.endZ, other.endZ);
+                dirtyRects_[i] = dirtyRects_.back();
+                dirtyRects_.pop_back();
+                grew = true;
+                break;
+            }
+        }
+
+        // Nobody may be taking them (headless runs); past the cap, one bounding block is
+        // cheaper to carry than an ever-growing list.
+        if (dirtyRects_.size() >= kMaxDirtyRects)
+        {
+            for (const GridRect& other : dirtyRects_)
+            {
+                merged.firstX = (std::min)(merged.firstX, other.firstX);
+                merged.firstZ = (std::min)(merged.firstZ, other.firstZ);
+                merged.endX = (std::max)(merged.endX, other.endX);
+                merged.endZ = (std::max)(merged.endZ, other.endZ);
+            }
+            dirtyRects_.clear();
+        }
+        dirtyRects_.push_back(merged);
+    }
+
+    void HeightField::TakeDirtyRects(std::vector<GridRect>& rects)
+    {
+        rects.clear();
+        std::swap(rects, dirtyRects_);
+    }
+
+    HeightField::Patch HeightField::ReadPatch(const GridRect& rect) const
+    {
+        Patch patch;
+        patch.rect = rect;
+        if (rect.IsEmpty())
+            return patch;
+
+        const int rows = gridResolution_ + 1;
+        const int width = rect.endX - rect.firstX;
+        patch.heights.resize(static_cast<std::size_t>(width) * (rect.endZ - rect.firstZ));
+        patch.normals.reserve(patch.heights.size() * 2);
+        for (int z = rect.firstZ; z < rect.endZ; ++z)
+        {
+            heights_.GetRow(rect.firstX, width, z, patch.heights.data() + static_cast<std::size_t>(z - rect.firstZ) * width);
+            const std::size_t first = static_cast<std::size_t>(z) * rows + rect.firstX;
+            patch.normals.insert(patch.normals.end(), normals_.begin() + first * 2, normals_.begin() + (first + width) * 2);
+        }
+        return patch;
+    }
+
+    void HeightField::GenerateCached(const std::string& cacheDirectory, float size, int gridResolution, std::uint64_t seed,
+        core::JobSystem* jobSystem)
+    {
+        if (cacheDirectory.empty())
+        {
+            Generate(size, gridResolution, seed, jobSystem);
+            return;
+        }
+
+        size_ = size;
+        gridResolution_ = gridResolution;
+        seed_ = seed;
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.hf", static_cast<unsigned long long>(GetContentKey()));
+        const std::string path = (std::filesystem::path(cacheDirectory) / name).string();
+        if (LoadCache(path))
+        {
+            return;
+        }
+
+        Generate(size, gridResolution, seed, jobSystem);
+        std::error_code error;
+        std::filesystem::create_directories(cacheDirectory, error);
+        if (error)
+        {
+            std::cout << "Height field not cached, cannot create " << cacheDirectory << ": " << error.message() << std::endl;
+            return;
+        }
+        SaveCache(path);
+    }
+
+    std::uint64_t HeightField::GetContentKey() const
+    {
+        std::uint64_t key = 14695981039346656037ull;
+        key = Fnv1a(key, &GeneratorVersion, sizeof(GeneratorVersion));
+        key = Fnv1a(key, &seed_, sizeof(seed_));
+        key = Fnv1a(key, &size_, sizeof(size_));
+        key = Fnv1a(key, &gridResolution_, sizeof(gridResolution_));
+        if (dem_.IsOpen())
+        {
+            const std::uint64_t demKey = dem_.GetContentKey();
+            key = Fnv1a(key, &demKey, sizeof(demKey));
+        }
+        return key;
+    }
+
+    bool HeightField::LoadCache(const std::string& path)
+    {
+        PLANE_PROFILE_SCOPE("HeightField::LoadCache");
+        core::MappedFile file;
+        if (!file.Open(path) || file.Size() < sizeof(CacheHeader))
+        {
+            return false;
+        }
+
+        CacheHeader header {};
+        std::memcpy(&header, file.Data(), sizeof(header));
+        const int rows = gridResolution_ + 1;
+        const std::size_t vertexCount = static_cast<std::size_t>(rows) * rows;
+        heights_.Resize(rows, GetMinHeight() - kCraterHeadroom, GetMaxHeight());
+        const std::size_t heightBytes = heights_.GetByteSize();
+        const std::size_t normalBytes = vertexCount * 2;
+        if (std::memcmp(header.magic, kCacheMagic, sizeof(kCacheMagic)) != 0
+            || header.version != kCacheFormatVersion
+            || header.key != GetContentKey()
+            || header.seed != seed_
+            || header.size != size_
+            || header.gridResolution != gridResolution_
+            || file.Size() != sizeof(header) + heightBytes + normalBytes)
+        {
+            return false;
+        }
+
+        normals_.resize(vertexCount * 2);
+        std::memcpy(heights_.GetTiles(), file.Data() + sizeof(header), heightBytes);
+        std::memcpy(normals_.data(), file.Data() + sizeof(header) + heightBytes, normalBytes);
+        hashKey_ = HashBits(static_cast<std::uint32_t>(seed_), static_cast<std::uint32_t>(seed_ >> 32), 0);
+        dirtyRects_.clear();
+        return true;
+    }
+
+    void HeightField::SaveCache(const std::string& path) const
+    {
+        PLANE_PROFILE_SCOPE("HeightField::SaveCache");
+        CacheHeader header {};
+        std::memcpy(header.magic, kCacheMagic, sizeof(kCacheMagic));
+        header.version = kCacheFormatVersion;
+        header.key = GetContentKey();
+        header.seed = seed_;
+        header.size = size_;
+        header.gridResolution = gridResolution_;
+
+        // Write beside the entry and rename, so a crash mid-write never leaves a torn file.
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            file.write(reinterpret_cast<const char*>(heights_.GetTiles()), static_cast<std::streamsize>(heights_.GetByteSize()));
+            file.write(reinterpret_cast<const char*>(normals_.data()), static_cast<std::streamsize>(normals_.size()));
+            if (!file)
+            {
+                return;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+        }
+    }
+
+    bool HeightField::UseDem(const std::string& path)
+    {
+        if (path.empty())
+        {
+            dem_.Close();
+            return true;
+        }
+        return dem_.Open(path);
+    }
+
+    glm::vec2 HeightField::DemPosition(int gridX, int gridZ) const
+    {
+        // The DEM's centre sits under the world origin, like the stored grid's.
+        const float cellSize = GetCellSize();
+        const float halfSize = size_ * 0.5f;
+        const float spacing = dem_.GetSampleSpacing();
+        return glm::vec2((gridX * cellSize - halfSize) / spacing + (dem_.GetWidth() - 1) * 0.5f,
+                         (gridZ * cellSize - halfSize) / spacing + (dem_.GetDepth() - 1) * 0.5f);
+    }
+
+    void HeightField::SourceRow(int firstX, int count, int z, float* out) const
+    {
+        if (!dem_.IsOpen())
+        {
+            GenerateRow(firstX, count, z, gridResolution_, hashKey_, out);
+            return;
+        }
+        for (int i = 0; i < count; ++i)
+        {
+            const glm::vec2 position = DemPosition(firstX + i, z);
+            out[i] = dem_.SampleAt(position.x, position.y);
+        }
+    }
+
+    float HeightField::GeneratedHeight(int gridX, int gridZ) const
+    {
+        if (dem_.IsOpen())
+        {
+            const glm::vec2 position = DemPosition(gridX, gridZ);
+            return dem_.SampleAt(position.x, position.y);
+        }
+        return LayeredHeight(gridX, static_cast<float>(gridZ) / static_cast<float>(gridResolution_), gridResolution_, hashKey_);
+    }
+
+    float HeightField::SampleHeight(int gridX, int gridZ) const
+    {
+        if (gridX < 0 || gridX > gridResolution_ || gridZ < 0 || gridZ > gridResolution_)
+            return GeneratedHeight(gridX, gridZ);
+
+        return heights_.Get(gridX, gridZ);
+    }
+
+    void HeightField::CopyHeights(std::vector<float>& heights) const
+    {
+        const int rows = gridResolution_ + 1;
+        heights.resize(static_cast<std::size_t>(rows) * rows);
+        for (int z = 0; z < rows; ++z)
+        {
+            heights_.GetRow(0, rows, z, heights.data() + static_cast<std::size_t>(z) * rows);
+        }
+    }
+
+    void HeightField::GenerateTile(int firstX, int firstZ, int cells, std::vector<float>& heights, std::vector<std::int8_t>& normals) const
+    {
+        PLANE_PROFILE_SCOPE("HeightField::GenerateTile");
+        // One ring of extra vertices around the tile feeds the edge normals.
+        const int side = cells + 1;
+        const int border = side + 2;
+        std::vector<float> bordered(static_cast<std::size_t>(border) * border);
+        for (int z = 0; z < border; ++z)
+        {
+            SourceRow(firstX - 1, border, firstZ - 1 + z, bordered.data() + static_cast<std::size_t>(z) * border);
+        }
+
+        const float cellSize = GetCellSize();
+        heights.resize(static_cast<std::size_t>(side) * side);
+        normals.resize(heights.size() * 2);
+        for (int z = 0; z < side; ++z)
+        {
+            const float* row = bordered.data() + static_cast<std::size_t>(z + 1) * border + 1;
+            for (int x = 0; x < side; ++x)
+            {
+                const std::size_t index = static_cast<std::size_t>(z) * side + x;
+                heights[index] = row[x];
+                EncodeNormal(NormalFromNeighbours(row[x - 1], row[x + 1], row[x - border], row[x + border], cellSize), normals.data() + index * 2);
+            }
+        }
+    }
+
+    float HeightField::GetMinHeight() const
+    {
+        return dem_.IsOpen() ? dem_.GetMinHeight() : kBaseHeight - TotalAmplitude();
+    }
+
+    float HeightField::GetMaxHeight() const
+    {
+        return dem_.IsOpen() ? dem_.GetMaxHeight() : kBaseHeight + TotalAmplitude();
+    }
+
+    float HeightField::GetHeightAt(float x, float z) const
+    {
+        // Convert world coordinates to grid coordinates
+        float halfSize = size_ * 0.5f;
+        float cellSize = size_ / gridResolution_;
+
+        float gridX = (x + halfSize) / cellSize;
+        float gridZ = (z + halfSize) / cellSize;
+
+        // Bilinear interpolation
+        int x0 = static_cast<int>(std::floor(gridX));
+        int z0 = static_cast<int>(std::floor(gridZ));
+
+        float fx = gridX - x0;
+        float fz = gridZ - z0;
+
+        // Inside the grid the four corners come from one or two cache lines.
+        float corners[4];
+        if (x0 >= 0 && x0 < gridResolution_ && z0 >= 0 && z0 < gridResolution_)
+        {
+            heights_.GetQuad(x0, z0, corners);
+        }
+        else
+        {
+            corners[0] = SampleHeight(x0, z0);
+            corners[1] = SampleHeight(x0 + 1, z0);
+            corners[2] = SampleHeight(x0, z0 + 1);
+            corners[3] = SampleHeight(x0 + 1, z0 + 1);
+        }
+
+        float h0 = Lerp(corners[0], corners[1], fx);
+        float h1 = Lerp(corners[2], corners[3], fx);
+
+        return Lerp(h0, h1, fz);
+    }
+
+    float HeightField::GetMaxHeightAround(float x, float z, float radius, int sampleCount) const
+    {
+        // The ring spans a cell or two at most, so after the first lookup the rest hit
+        // tiles already in cache. Walk it by rotating one offset instead of calling
+        // cos and sin per sample.
+        float maxHeight = GetHeightAt(x, z);
+        const float step = (3.14159265359f * 2.0f) / sampleCount;
+        const float stepCos = std::cos(step);
+        const float stepSin = std::sin(step);
+        float offsetX = radius;
+        float offsetZ = 0.0f;
+        for (int i = 0; i < sampleCount; ++i)
+        {
+            maxHeight = (std::max)(maxHeight, GetHeightAt(x + offsetX, z + offsetZ));
+            const float rotatedX = offsetX * stepCos - offsetZ * stepSin;
+            offsetZ = offsetX * stepSin + offsetZ * stepCos;
+            offsetX = rotatedX;
+        }
+        return maxHeight;
+    }
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "MortonHeightGrid.h"
+#include "TiledHeightmap.h"
+
+namespace plane::core { class JobSystem; }
+
+namespace plane::world
+{
+    // Heightmap shared by collision and terrain rendering, procedural or from a DEM.
+    // Holds no GL resources so the simulation can run without a context. The stored grid
+    // caches the middle of an endless terrain; past its edges the source is evaluated
+    // on demand, so queries anywhere see the same surface.
+    class HeightField
+    {
+    public:
+        // Half-open block of stored grid vertices, [firstX, endX) x [firstZ, endZ).
+        struct GridRect
+        {
+            int firstX { 0 };
+            int firstZ { 0 };
+            int endX { 0 };
+            int endZ { 0 };
+
+            bool IsEmpty() const { return endX <= firstX || endZ <= firstZ; }
+        };
+
+        // Heights and packed normals of one edited block, row by row, for the renderer.
+        struct Patch
+        {
+            GridRect rect;
+            std::vector<float> heights;
+            std::vector<std::int8_t> normals;
+        };
+
+        // Craters stay within the cells that whole blocks of this many cells cover (the
+        // renderer's chunk size), two vertices in from each edge. The streamed terrain
+        // draws the rest from the source alone, so its heights and normals must not change.
+        static constexpr int DeformBlockCells = 16;
+
+        // Bump whenever Generate would produce different data for the same inputs; it is
+        // part of the content key, so stale cache entries are never read.
+        static constexpr std::uint32_t GeneratorVersion = 4;
+
+        // Samples this .pdem (see TiledHeightmap) instead of the noise generator from
+        // the next Generate on, centred under the world origin; past the DEM's edges its
+        // border samples repeat. Only what is queried gets paged in. An empty path
+        // returns to the generator. False, keeping the generator, if the file is unusable.
+        bool UseDem(const std::string& path);
+
+        // Fills heights and normals in row bands, on the job system when one is given.
+        // Same seed, same terrain. Not reentrant with anything else driving the same
+        // job system.
+        void Generate(float size, int gridResolution, std::uint64_t seed, core::JobSystem* jobSystem = nullptr);
+
+        // Generate, but first maps the entry for these inputs from cacheDirectory and,
+        // on a miss, writes one afterwards. An empty directory skips the cache.
+        void GenerateCached(const std::string& cacheDirectory, float size, int gridResolution, std::uint64_t seed,
+            core::JobSystem* jobSystem = nullptr);
+
+        // TiledHeightmap::GetContentKey of the DEM in use; 0 while on the noise generator.
+        std::uint64_t GetDemKey() const { return dem_.GetContentKey(); }
+
+        // Identifies the generated content: seed, size, resolution, GeneratorVersion and the DEM.
+        // Data derived from the height field can be cached under it.
+        std::uint64_t GetContentKey() const;
+
+        // Query terrain height at any XZ world position using bilinear interpolation.
+        float GetHeightAt(float x, float z) const;
+
+        // Highest of GetHeightAt at (x, z) and at sampleCount points evenly spaced on a
+        // circle of the given radius around it, starting along +X.
+        float GetMaxHeightAround(float x, float z, float radius, int sampleCount) const;
+
+        // Height of any lattice vertex; vertices outside the stored grid are generated.
+        float SampleHeight(int gridX, int gridZ) const;
+
+        // Heights and packed normals of the (cells + 1)^2 lattice vertices starting at
+        // (firstX, firstZ), row by row, in the stored grid's layouts. Reads only the
+        // generator, never the grid Deform edits, so any thread may call it once
+        // Generate has returned.
+        void GenerateTile(int firstX, int firstZ, int cells, std::vector<float>& heights, std::vector<std::int8_t>& normals) const;
+
+        // Lowers a smooth bowl radius wide and up to depth deep into the stored grid around
+        // world (x, z), then refreshes the normals it touched. Queries see the crater at once.
+        // Outside the cells DeformBlockCells allows the terrain stays as it is. Returns the
+        // vertices whose height or normal changed, which are also queued for TakeDirtyRects.
+        GridRect Deform(float x, float z, float radius, float depth);
+
+        // Moves the blocks edited since the last call into rects, overlapping ones merged.
+        void TakeDirtyRects(std::vector<GridRect>& rects);
+
+        // Copies the current heights and normals of rect out of the stored grid.
+        Patch ReadPatch(const GridRect& rect) const;
+
+        // Every height the source can produce lies within these; craters may dig below.
+        float GetMinHeight() const;
+        float GetMaxHeight() const;
+        // Range the stored grid quantizes over: the source's, with room below for craters.
+        float GetGridMinHeight() const { return heights_.GetMinHeight(); }
+        float GetGridMaxHeight() const { return heights_.GetMaxHeight(); }
+
+        float GetSize() const { return size_; }
+        int GetGridResolution() const { return gridResolution_; }
+        float GetCellSize() const { return size_ / gridResolution_; }
+
+        // Stored grid heights decoded into heights, row by row.
+        void CopyHeights(std::vector<float>& heights) const;
+
+        // Surface normal per grid vertex, octahedral-encoded (Y folded up) into two snorm
+        // bytes, row by row; the layout of an RG8 snorm texture.
+        const std::vector<std::int8_t>& GetPackedNormals() const { return normals_; }
+
+    private:
+        bool LoadCache(const std::string& path);
+        void SaveCache(const std::string& path) const;
+        void GenerateRows(int firstRow, int endRow);
+        void GenerateNormals(const GridRect& rect);
+        void AddDirtyRect(const GridRect& rect);
+        // Source heights of count lattice vertices from (firstX, z): the DEM, else the noise.
+        void SourceRow(int firstX, int count, int z, float* out) const;
+        float GeneratedHeight(int gridX, int gridZ) const;
+        // DEM sample coordinates of a lattice vertex.
+        glm::vec2 DemPosition(int gridX, int gridZ) const;
+
+        float size_ { 2000.0f };           // Total world size (e.g., 2000x2000 units to match ground plane)
+        int gridResolution_ { 100 };       // Number of grid cells per side (100x100 = 10000 vertices)
+        std::uint64_t seed_ { 0 };
+        std::uint32_t hashKey_ { 0 };      // Seed folded into the lattice hash.
+        MortonHeightGrid heights_;         // Stored grid, quantized with room below for craters.
+        std::vector<std::int8_t> normals_;
+        std::vector<GridRect> dirtyRects_;
+        TiledHeightmap dem_;
+    };
+}
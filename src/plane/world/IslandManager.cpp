@@ -1,7 +1,5 @@
 #include "IslandManager.h"
 
-#include <glm/gtc/matrix_transform.hpp>
-
 #include <random>
 
 namespace plane::world
@@ -12,17 +10,16 @@ namespace plane::world
         constexpr float kMinHorizontal = -1500.0f;
         constexpr float kMaxHorizontal = 1500.0f;
         constexpr float kIslandHeight = 26.0f;
-        constexpr float kScale = 500.0f;
     }
 
-    void IslandManager::GenerateIslands()
+    void IslandManager::GenerateIslands(std::uint64_t seed)
     {
         // Scatter a handful of islands so the scene never feels empty.
         positions_.clear();
         positions_.push_back(kPrimaryIslandPosition);
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
+        std::seed_seq seq { static_cast<std::uint32_t>(seed), static_cast<std::uint32_t>(seed >> 32) };
+        std::mt19937 gen(seq);
         std::uniform_int_distribution<int> islandCountDist(2, 3);
         std::uniform_real_distribution<float> horizontalDist(kMinHorizontal, kMaxHorizontal);
 
@@ -33,18 +30,5 @@ namespace plane::world
             positions_.emplace_back(horizontalDist(gen), kIslandHeight, horizontalDist(gen));
         }
     }
-
-    void IslandManager::Draw(Model& islandModel, Shader& shader) const
-    {
-        for (const auto& islandPos : positions_)
-        {
-            glm::mat4 islandModelMatrix = glm::mat4(1.0f);
-            islandModelMatrix = glm::translate(islandModelMatrix, islandPos);
-            islandModelMatrix = glm::rotate(islandModelMatrix, glm::radians(90.0f), glm::vec3(-1.0f, 0.0f, 0.0f));
-            islandModelMatrix = glm::scale(islandModelMatrix, glm::vec3(kScale, kScale, kScale));
-            shader.setMat4("model", islandModelMatrix);
-            islandModel.Draw(shader);
-        }
-    }
 }
 
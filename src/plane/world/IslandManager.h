@@ -1,9 +1,8 @@
 #pragma once
 
 #include <glm/glm.hpp>
-#include <learnopengl/model.h>
-#include <learnopengl/shader_m.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace plane::world
@@ -11,8 +10,8 @@ namespace plane::world
     class IslandManager
     {
     public:
-        void GenerateIslands();
-        void Draw(Model& islandModel, Shader& shader) const;
+        // Same seed, same islands.
+        void GenerateIslands(std::uint64_t seed);
         const std::vector<glm::vec3>& GetPositions() const { return positions_; }
 
     private:
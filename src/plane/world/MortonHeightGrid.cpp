@@ -0,0 +1,62 @@
+#include "MortonHeightGrid.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace plane::world
+{
+    void MortonHeightGrid::Resize(int side, float minHeight, float maxHeight)
+    {
+        side_ = side;
+        tilesPerRow_ = (side + TileSide - 1) / TileSide;
+        minHeight_ = minHeight;
+        step_ = (std::max)(maxHeight - minHeight, 1e-3f) / 65535.0f;
+        inverseStep_ = 1.0f / step_;
+        tiles_.assign(static_cast<std::size_t>(tilesPerRow_) * tilesPerRow_, Tile {});
+    }
+
+    void MortonHeightGrid::Set(int x, int z, float height)
+    {
+        const float steps = (std::clamp)((height - minHeight_) * inverseStep_, 0.0f, 65535.0f);
+        tiles_[TileIndex(x, z)].samples[SampleIndex(x, z)] = static_cast<std::uint16_t>(std::lround(steps));
+    }
+
+    void MortonHeightGrid::GetQuad(int x, int z, float out[4]) const
+    {
+        // Unless the block straddles a tile edge all four samples share one tile, and
+        // with even x and z they are even consecutive.
+        const int localX = x & (TileSide - 1);
+        const int localZ = z & (TileSide - 1);
+        if (localX < TileSide - 1 && localZ < TileSide - 1)
+        {
+            const std::uint16_t* samples = tiles_[TileIndex(x, z)].samples;
+            const int row0 = kMorton[localZ] << 1;
+            const int row1 = kMorton[localZ + 1] << 1;
+            out[0] = minHeight_ + samples[kMorton[localX] | row0] * step_;
+            out[1] = minHeight_ + samples[kMorton[localX + 1] | row0] * step_;
+            out[2] = minHeight_ + samples[kMorton[localX] | row1] * step_;
+            out[3] = minHeight_ + samples[kMorton[localX + 1] | row1] * step_;
+            return;
+        }
+        out[0] = Get(x, z);
+        out[1] = Get(x + 1, z);
+        out[2] = Get(x, z + 1);
+        out[3] = Get(x + 1, z + 1);
+    }
+
+    void MortonHeightGrid::GetRow(int firstX, int count, int z, float* out) const
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            out[i] = Get(firstX + i, z);
+        }
+    }
+
+    void MortonHeightGrid::SetRow(int firstX, int count, int z, const float* heights)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            Set(firstX + i, z, heights[i]);
+        }
+    }
+}
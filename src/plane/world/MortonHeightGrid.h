@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace plane::world
+{
+    // Square grid of heights quantized to 16 bits over a fixed range, stored in 8x8
+    // tiles with the samples of each tile in Z (Morton) order. A tile is 128 bytes,
+    // aligned to two cache lines, and any 2x2 block whose corner has even coordinates
+    // is four consecutive samples, so bilinear lookups and small neighbourhoods touch
+    // one or two lines instead of one per row. Half the memory of plain floats.
+    class MortonHeightGrid
+    {
+    public:
+        static constexpr int TileSide = 8;
+
+        struct alignas(64) Tile
+        {
+            std::uint16_t samples[TileSide * TileSide];
+        };
+
+        // side x side samples, all at minHeight. Heights set later clamp into
+        // [minHeight, maxHeight]; the step is (maxHeight - minHeight) / 65535.
+        void Resize(int side, float minHeight, float maxHeight);
+
+        int GetSide() const { return side_; }
+        float GetMinHeight() const { return minHeight_; }
+        float GetMaxHeight() const { return minHeight_ + step_ * 65535.0f; }
+
+        // Unchecked; x and z must lie in [0, side).
+        float Get(int x, int z) const { return minHeight_ + tiles_[TileIndex(x, z)].samples[SampleIndex(x, z)] * step_; }
+        void Set(int x, int z, float height);
+
+        // Heights of (x, z), (x + 1, z), (x, z + 1) and (x + 1, z + 1), in that order, as
+        // bilinear interpolation wants them. x + 1 and z + 1 must lie within the grid.
+        void GetQuad(int x, int z, float out[4]) const;
+
+        // count samples of row z from firstX on, out of or into a plain float row.
+        void GetRow(int firstX, int count, int z, float* out) const;
+        void SetRow(int firstX, int count, int z, const float* heights);
+
+        // Raw tiles, row by row, for caching.
+        Tile* GetTiles() { return tiles_.data(); }
+        const Tile* GetTiles() const { return tiles_.data(); }
+        std::size_t GetByteSize() const { return tiles_.size() * sizeof(Tile); }
+
+    private:
+        // Interleaves the low three bits of x and z: x in the even bits, z in the odd.
+        static int SampleIndex(int x, int z)
+        {
+            return kMorton[x & (TileSide - 1)] | (kMorton[z & (TileSide - 1)] << 1);
+        }
+        std::size_t TileIndex(int x, int z) const
+        {
+            // Coordinates are never negative here; unsigned division is a plain shift.
+            return static_cast<std::size_t>(static_cast<unsigned>(z) / TileSide) * tilesPerRow_ + static_cast<unsigned>(x) / TileSide;
+        }
+
+        static constexpr std::uint8_t kMorton[TileSide] = { 0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15 };
+
+        int side_ { 0 };
+        int tilesPerRow_ { 0 };
+        float minHeight_ { 0.0f };
+        float step_ { 1.0f };
+        float inverseStep_ { 1.0f };
+        std::vector<Tile> tiles_;
+    };
+}
@@ -0,0 +1,209 @@
+#include "TiledHeightmap.h"
+#include "core/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace plane::world
+{
+    namespace
+    {
+        constexpr char kMagic[4] = { 'P', 'D', 'E', 'M' };
+        constexpr std::uint32_t kFormatVersion = 1;
+
+        // Tiles start on a page boundary, so each one maps in as whole pages.
+        constexpr std::size_t kTileDataOffset = 4096;
+        constexpr std::size_t kTileSamples = static_cast<std::size_t>(TiledHeightmap::TileSize) * TiledHeightmap::TileSize;
+
+        // Followed by zero padding up to kTileDataOffset, then the tiles row by row,
+        // each TileSize^2 samples row by row. Edge tiles repeat the last row and column.
+        struct FileHeader
+        {
+            char magic[4];
+            std::uint32_t version;
+            std::int32_t width;
+            std::int32_t depth;
+            std::int32_t tileSize;
+            float sampleSpacing;
+            float heightScale;
+            float heightOffset;
+            std::uint16_t minSample;
+            std::uint16_t maxSample;
+            std::uint32_t reserved;
+            core::FileStamp source;
+        };
+        static_assert(sizeof(FileHeader) <= kTileDataOffset, "header must fit before the tiles");
+
+        std::uint64_t Fnv1a(std::uint64_t hash, const void* data, std::size_t size)
+        {
+            const auto* bytes = static_cast<const unsigned char*>(data);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ull;
+            }
+            return hash;
+        }
+
+        int TileCount(int samples)
+        {
+            return (samples + TiledHeightmap::TileSize - 1) / TiledHeightmap::TileSize;
+        }
+    }
+
+    bool TiledHeightmap::Write(const std::string& path, const std::uint16_t* samples, int width, int depth,
+        const DemSettings& settings, const core::FileStamp& source)
+    {
+        PLANE_PROFILE_SCOPE("TiledHeightmap::Write");
+        if (width <= 0 || depth <= 0)
+        {
+            return false;
+        }
+
+        FileHeader header {};
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kFormatVersion;
+        header.width = width;
+        header.depth = depth;
+        header.tileSize = TileSize;
+        header.sampleSpacing = settings.sampleSpacing;
+        header.heightScale = settings.heightScale;
+        header.heightOffset = settings.heightOffset;
+        header.minSample = 0xFFFF;
+        header.maxSample = 0;
+        header.source = source;
+
+        // Write beside the target and rename, so a crash mid-write never leaves a torn file.
+        const std::string tempPath = path + ".tmp";
+        {
+            std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+            const std::vector<char> padding(kTileDataOffset, 0);
+            file.write(padding.data(), static_cast<std::streamsize>(padding.size()));
+
+            // One row of tiles at a time keeps memory flat however large the source.
+            const int tilesPerRow = TileCount(width);
+            std::vector<std::uint16_t> tileRow(tilesPerRow * kTileSamples);
+            for (int tileZ = 0; tileZ < TileCount(depth); ++tileZ)
+            {
+                for (int tileX = 0; tileX < tilesPerRow; ++tileX)
+                {
+                    std::uint16_t* tile = tileRow.data() + tileX * kTileSamples;
+                    for (int z = 0; z < TileSize; ++z)
+                    {
+                        const int sourceZ = (std::min)(tileZ * TileSize + z, depth - 1);
+                        const std::uint16_t* row = samples + static_cast<std::size_t>(sourceZ) * width;
+                        for (int x = 0; x < TileSize; ++x)
+                        {
+                            const std::uint16_t sample = row[(std::min)(tileX * TileSize + x, width - 1)];
+                            header.minSample = (std::min)(header.minSample, sample);
+                            header.maxSample = (std::max)(header.maxSample, sample);
+                            tile[z * TileSize + x] = sample;
+                        }
+                    }
+                }
+                file.write(reinterpret_cast<const char*>(tileRow.data()), static_cast<std::streamsize>(tileRow.size() * sizeof(std::uint16_t)));
+            }
+
+            // The range is only known now; the header goes in last.
+            file.seekp(0);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            if (!file)
+            {
+                return false;
+            }
+        }
+        std::error_code error;
+        std::filesystem::rename(tempPath, path, error);
+        if (error)
+        {
+            std::filesystem::remove(tempPath, error);
+            return false;
+        }
+        return true;
+    }
+
+    bool TiledHeightmap::Open(const std::string& path)
+    {
+        PLANE_PROFILE_SCOPE("TiledHeightmap::Open");
+        Close();
+        core::MappedFile file;
+        if (!file.Open(path) || file.Size() < kTileDataOffset)
+        {
+            std::cout << "Cannot map DEM " << path << std::endl;
+            return false;
+        }
+
+        FileHeader header {};
+        std::memcpy(&header, file.Data(), sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kFormatVersion
+            || header.tileSize != TileSize || header.width <= 0 || header.depth <= 0 || !(header.sampleSpacing > 0.0f))
+        {
+            std::cout << "DEM " << path << " is not a version " << kFormatVersion << " .pdem; cook it again with plane_demcook" << std::endl;
+            return false;
+        }
+        const std::size_t tileCount = static_cast<std::size_t>(TileCount(header.width)) * TileCount(header.depth);
+        if (file.Size() != kTileDataOffset + tileCount * kTileSamples * sizeof(std::uint16_t))
+        {
+            std::cout << "DEM " << path << " is truncated" << std::endl;
+            return false;
+        }
+
+        file_ = std::move(file);
+        tiles_ = reinterpret_cast<const std::uint16_t*>(file_.Data() + kTileDataOffset);
+        width_ = header.width;
+        depth_ = header.depth;
+        tilesPerRow_ = TileCount(header.width);
+        settings_ = DemSettings { header.sampleSpacing, header.heightScale, header.heightOffset };
+        minHeight_ = header.heightOffset + header.minSample * header.heightScale;
+        maxHeight_ = header.heightOffset + header.maxSample * header.heightScale;
+        if (minHeight_ > maxHeight_)
+        {
+            std::swap(minHeight_, maxHeight_);
+        }
+        contentKey_ = Fnv1a(14695981039346656037ull, &header, sizeof(header));
+        return true;
+    }
+
+    void TiledHeightmap::Close()
+    {
+        file_.Close();
+        tiles_ = nullptr;
+        width_ = 0;
+        depth_ = 0;
+        tilesPerRow_ = 0;
+        contentKey_ = 0;
+    }
+
+    float TiledHeightmap::Sample(int x, int z) const
+    {
+        x = (std::clamp)(x, 0, width_ - 1);
+        z = (std::clamp)(z, 0, depth_ - 1);
+        const std::size_t tile = static_cast<std::size_t>(z / TileSize) * tilesPerRow_ + x / TileSize;
+        const std::uint16_t sample = tiles_[tile * kTileSamples + (z % TileSize) * TileSize + x % TileSize];
+        return settings_.heightOffset + sample * settings_.heightScale;
+    }
+
+    float TiledHeightmap::SampleAt(float x, float z) const
+    {
+        const float floorX = std::floor(x);
+        const float floorZ = std::floor(z);
+        const int x0 = static_cast<int>(floorX);
+        const int z0 = static_cast<int>(floorZ);
+        const float fx = x - floorX;
+        const float fz = z - floorZ;
+
+        const float h00 = Sample(x0, z0);
+        const float h10 = Sample(x0 + 1, z0);
+        const float h01 = Sample(x0, z0 + 1);
+        const float h11 = Sample(x0 + 1, z0 + 1);
+        const float h0 = h00 + fx * (h10 - h00);
+        const float h1 = h01 + fx * (h11 - h01);
+        return h0 + fz * (h1 - h0);
+    }
+}
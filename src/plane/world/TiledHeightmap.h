@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+#include "core/MappedFile.h"
+
+namespace plane::world
+{
+    // How plane_demcook turns raw 16-bit samples into metres and spaces them out.
+    struct DemSettings
+    {
+        float sampleSpacing { 30.0f };  // Metres between neighbouring samples.
+        float heightScale { 1.0f };     // Metres per sample unit.
+        float heightOffset { 0.0f };    // Metres at sample 0; negative sinks the map toward the water.
+    };
+
+    // Read-only elevation model in a ".pdem" file: unsigned 16-bit samples in square
+    // tiles, each tile contiguous and page aligned. The file is memory mapped, so only
+    // the tiles something reads are ever paged in; a multi-gigabyte DEM costs its
+    // working set, not its size. Cooked from RAW or PNG sources by plane_demcook.
+    class TiledHeightmap
+    {
+    public:
+        // Samples per tile side; one tile is two 4 KiB pages.
+        static constexpr int TileSize = 64;
+
+        // Writes width x depth row-major samples as a .pdem. Works one row of tiles at
+        // a time, so samples may point into a mapped source file. source is stored for
+        // callers that want to tell a stale cook apart; it may be left zero.
+        static bool Write(const std::string& path, const std::uint16_t* samples, int width, int depth,
+            const DemSettings& settings, const core::FileStamp& source = {});
+
+        // False, with the reason on stdout, if the file is missing or not a valid .pdem.
+        bool Open(const std::string& path);
+        void Close();
+        bool IsOpen() const { return tiles_ != nullptr; }
+
+        int GetWidth() const { return width_; }
+        int GetDepth() const { return depth_; }
+        float GetSampleSpacing() const { return settings_.sampleSpacing; }
+        // Lowest and highest height in the file, in metres.
+        float GetMinHeight() const { return minHeight_; }
+        float GetMaxHeight() const { return maxHeight_; }
+        // Hash of the header; changes whenever the file is cooked from other data.
+        std::uint64_t GetContentKey() const { return contentKey_; }
+
+        // Height in metres of sample (x, z), clamped to the edges.
+        float Sample(int x, int z) const;
+        // Bilinear height in metres at a fractional sample position, clamped to the edges.
+        float SampleAt(float x, float z) const;
+
+    private:
+        core::MappedFile file_;
+        const std::uint16_t* tiles_ { nullptr };
+        int width_ { 0 };
+        int depth_ { 0 };
+        int tilesPerRow_ { 0 };
+        DemSettings settings_;
+        float minHeight_ { 0.0f };
+        float maxHeight_ { 0.0f };
+        std::uint64_t contentKey_ { 0 };
+    };
+}